@@ -0,0 +1,212 @@
+#include "async_writer.h"
+
+#include <stdarg.h>
+#include <algorithm>
+#include <chrono>
+
+#include <log4cxx/logger.h>
+
+static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("ESS");
+
+namespace ess
+{
+
+const size_t async_file::chunk_size;
+const size_t async_writer::max_pending_bytes;
+
+async_file::async_file()
+	: _fp(NULL)
+	, _writer(async_writer::instance())
+{}
+
+async_file::~async_file()
+{
+	this->close();
+}
+
+bool async_file::open(std::string const& fn, const char* access)
+{
+	this->close();
+	_fp = fopen(fn.c_str(), access);
+	if (_fp)
+		_buffer.reserve(chunk_size);
+	return _fp;
+}
+
+void async_file::reserve(size_t n)
+{
+	if (_buffer.size() + n > _buffer.capacity())
+		_buffer.reserve(std::max(_buffer.size() + n, chunk_size));
+}
+
+void async_file::write(const void* data, size_t n)
+{
+	if (!_fp)
+		return;
+	reserve(n);
+	const char* p = static_cast<const char*>(data);
+	_buffer.insert(_buffer.end(), p, p + n);
+	if (_buffer.size() >= chunk_size)
+		flush();
+}
+
+void async_file::printf(const char* format, ...)
+{
+	if (!_fp)
+		return;
+	// format directly into the buffer, retry once if the line is longer than expected
+	const size_t old_size = _buffer.size();
+	size_t n = 256;
+	for (size_t attempt = 0; attempt < 2; ++attempt) {
+		reserve(n);
+		_buffer.resize(old_size + n);
+		va_list args;
+		va_start(args, format);
+		const int written = vsnprintf(&_buffer[old_size], n, format, args);
+		va_end(args);
+		if (written < 0) {
+			_buffer.resize(old_size);
+			return;
+		}
+		if (size_t(written) < n) {
+			_buffer.resize(old_size + written);
+			break;
+		}
+		n = written + 1;
+	}
+	if (_buffer.size() >= chunk_size)
+		flush();
+}
+
+void async_file::flush()
+{
+	if (_fp && !_buffer.empty())
+		_writer.submit(_fp, _buffer, false);
+}
+
+void async_file::close()
+{
+	if (!_fp)
+		return;
+	_writer.wait_for(_writer.submit(_fp, _buffer, true));
+	_fp = NULL;
+}
+
+bool async_file::is_open() const
+{
+	return _fp != NULL;
+}
+
+
+async_writer& async_writer::instance()
+{
+	static async_writer writer;
+	return writer;
+}
+
+async_writer::async_writer()
+	: _pending_bytes(0)
+	, _submitted(0)
+	, _completed(0)
+	, _stop(false)
+	, _seconds_blocked(0.)
+	, _bytes_written(0)
+	, _files_closed(0)
+	, _thread(&async_writer::run, this)
+{}
+
+async_writer::~async_writer()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_work.notify_one();
+	_thread.join();
+}
+
+uint64_t async_writer::submit(FILE* fp, std::vector<char>& data, bool close)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	if (_pending_bytes > max_pending_bytes) {
+		auto const start = std::chrono::steady_clock::now();
+		_done.wait(lock, [this]{ return _pending_bytes <= max_pending_bytes; });
+		_seconds_blocked += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+	_pending_bytes += data.size();
+	job j = { fp, std::vector<char>(), close };
+	j.data.swap(data);
+	_jobs.push_back(std::move(j));
+	const uint64_t ticket = ++_submitted;
+	lock.unlock();
+	_work.notify_one();
+	if (!close)
+		data.reserve(async_file::chunk_size);
+	return ticket;
+}
+
+void async_writer::wait_for(uint64_t ticket)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	if (_completed < ticket) {
+		auto const start = std::chrono::steady_clock::now();
+		_done.wait(lock, [this, ticket]{ return _completed >= ticket; });
+		_seconds_blocked += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+void async_writer::flush()
+{
+	uint64_t ticket;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		ticket = _submitted;
+	}
+	wait_for(ticket);
+}
+
+void async_writer::run()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (true) {
+		_work.wait(lock, [this]{ return _stop || !_jobs.empty(); });
+		if (_jobs.empty())
+			break; // stopped and all jobs done
+		job j = std::move(_jobs.front());
+		_jobs.pop_front();
+		lock.unlock();
+
+		if (!j.data.empty())
+			fwrite(&j.data[0], 1, j.data.size(), j.fp);
+		if (j.close) {
+			fclose(j.fp);
+			++_files_closed;
+		}
+		_bytes_written += j.data.size();
+
+		lock.lock();
+		_pending_bytes -= j.data.size();
+		++_completed;
+		_done.notify_all();
+	}
+}
+
+async_writer::statistics async_writer::get_statistics() const
+{
+	statistics s;
+	s.bytes_written = _bytes_written;
+	s.files_closed = _files_closed;
+	std::lock_guard<std::mutex> lock(_mutex);
+	s.seconds_blocked = _seconds_blocked;
+	return s;
+}
+
+void async_writer::report() const
+{
+	statistics const s = get_statistics();
+	LOG4CXX_INFO(logger, "async_writer: " << s.bytes_written << " bytes written, "
+			<< s.files_closed << " files closed, producers blocked for "
+			<< s.seconds_blocked << " s" );
+}
+
+} // namespace ess
@@ -0,0 +1,134 @@
+#ifndef __ASYNC_WRITER_H__
+#define __ASYNC_WRITER_H__
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ess
+{
+
+class async_writer;
+
+/// Output file whose data is written to disk by the background thread of the async_writer.
+/// Data is collected in a private buffer of the producer, which is handed over
+/// to the writer thread when it is full, on flush() and on close().
+/// Hence, writing does not need any locking and never waits for the disk.
+/// An async_file must only be written from one thread at a time,
+/// which is the case for all SystemC processes.
+class async_file
+{
+public:
+	/// size of the producer buffer, after which the data is handed over
+	static const size_t chunk_size = 1 << 16;
+
+	async_file();
+	~async_file();
+
+	/// opens the file, returns false if it could not be opened
+	bool open(
+			std::string const& fn,  //!< filename
+			const char* access      //!< access mode as for fopen, e.g. "w" or "wb"
+			);
+
+	/// appends n bytes
+	void write(const void* data, size_t n);
+
+	/// appends formatted output, same format as for fprintf
+	void printf(const char* format, ...) __attribute__ ((format (printf, 2, 3)));
+
+	/// hands the buffered data over to the writer thread, does not wait.
+	void flush();
+
+	/// hands the buffered data over and waits until it is on disk and the file is closed.
+	void close();
+
+	bool is_open() const;
+
+private:
+	void reserve(size_t n);
+
+	FILE* _fp;                 ///< owned by the writer thread after open
+	std::vector<char> _buffer; ///< data not yet handed over
+	async_writer& _writer;
+
+	async_file(const async_file&);
+	const async_file& operator=(const async_file&);
+};
+
+/// Background thread writing the data of all async_files.
+/// Producers hand over full buffers, the writer thread writes them in order.
+/// If more than max_pending_bytes are waiting to be written, producers are blocked
+/// until the writer has caught up. The time spent blocked is reported by statistics().
+class async_writer
+{
+public:
+	/// maximum number of bytes handed over but not yet written
+	static const size_t max_pending_bytes = 64 << 20;
+
+	struct statistics
+	{
+		uint64_t bytes_written;   //!< bytes written to disk
+		uint64_t files_closed;    //!< number of closed files
+		double   seconds_blocked; //!< time producers waited for the writer thread
+	};
+
+	/// the single writer instance, started on first use
+	static async_writer& instance();
+
+	/// waits until all data handed over so far is written
+	void flush();
+
+	statistics get_statistics() const;
+
+	/// logs the statistics with level INFO
+	void report() const;
+
+private:
+	friend class async_file;
+
+	async_writer();
+	~async_writer();
+
+	struct job
+	{
+		FILE* fp;
+		std::vector<char> data;
+		bool close;
+	};
+
+	/// hands over data (and closes fp, if close is true), returns the ticket of the job.
+	uint64_t submit(FILE* fp, std::vector<char>& data, bool close);
+
+	/// waits until the job with ticket has been processed.
+	void wait_for(uint64_t ticket);
+
+	void run();
+
+	mutable std::mutex _mutex;
+	std::condition_variable _work; ///< signaled when a job is submitted
+	std::condition_variable _done; ///< signaled when a job is written
+	std::deque<job> _jobs;
+	size_t _pending_bytes;
+	uint64_t _submitted;           ///< number of submitted jobs
+	uint64_t _completed;           ///< number of written jobs
+	bool _stop;
+	double _seconds_blocked;
+	std::atomic<uint64_t> _bytes_written;
+	std::atomic<uint64_t> _files_closed;
+	std::thread _thread;
+
+	async_writer(const async_writer&);
+	const async_writer& operator=(const async_writer&);
+};
+
+} // namespace ess
+
+#endif // __ASYNC_WRITER_H__
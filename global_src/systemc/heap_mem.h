@@ -15,40 +15,39 @@
 #ifndef __HEAP_MEM_H__
 #define __HEAP_MEM_H__
 
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <vector>
+
 #include "sim_def.h"
+#include "state_archive.h"
 
 namespace ess
 {
 
 /// This class providew a sorted memory with heap algorithmus.
+/// Elements are ordered by their lower 20 bit (the time stamp of a pulse), which may wrap around:
+/// a is before b, if b - a is less than 2^19 modulo 2^20.
+///
+/// The heap is 4-ary and stored in place in a fixed array, insert and get work iteratively.
+/// Compared to a binary heap, it has half the depth and the children of a node
+/// share a cache line.
 template<class T> class heap_mem
 {
 public:
-	// instantiations
-	T *memory;					///<pointer to variable type
-	//data
-	unsigned int start_pointer; ///<lowest array element
-	unsigned int end_pointer;	///<current last array element
-	unsigned int max;			///<highest memory place
-
 	/// standard constructor with standard depth from sim_def.h element DELAY_MEM_DEPTH
 	heap_mem ()
-	{
-        start_pointer = 1;
-		end_pointer = 1;
-		max=DELAY_MEM_DEPTH;
-		memory = new T[DELAY_MEM_DEPTH+1];
-	}
+		: _size(0)
+		, _memory(DELAY_MEM_DEPTH)
+	{}
 
 	/// constructor with parameter for memory depth
 	///\param m: integer with memory depth
-	heap_mem (unsigned int m)
-	{
-        start_pointer = 1;
-		end_pointer = 1;
-		max=m;
-		memory = new T[m+1];
-	}
+	explicit heap_mem (unsigned int m)
+		: _size(0)
+		, _memory(m)
+	{}
 
 	// function declarations
 	bool insert(const T&);
@@ -56,6 +55,31 @@ public:
 	void view_next(T&);
 	unsigned int num_available();
 	bool empty();
+
+	/// replaces the contents by the elements of [first, last) in O(n).
+	///\return false, if they exceed the memory depth, the memory is empty then
+	template<class It>
+	bool assign(It first, It last);
+
+	/// stores or restores the contents.
+	void checkpoint(state_archive& ar);
+
+	/// true, if a is released before b
+	static bool before(const T& a, const T& b)
+	{
+		return (((a & 0xfffff) - (b & 0xfffff)) >> 19) & 0x1;
+	}
+
+private:
+	static const size_t arity = 4;
+
+	/// moves the element at pos towards the root, until its parent is before it
+	void sift_up(size_t pos);
+	/// moves the element at pos towards the leaves, until it is before its children
+	void sift_down(size_t pos);
+
+	size_t _size;
+	std::vector<T> _memory; ///< heap with root at 0, the children of i are at arity*i + 1 ... arity*i + arity
 };
 
 /// Function to insert data in heap at correct position.
@@ -64,28 +88,10 @@ public:
 template <class T>
 bool heap_mem<T>::insert(const T& value)
 {
-//	printf("Start insert: %i, %i\n",end_pointer,max);
-	unsigned int end_safe;
-
-	if(start_pointer == end_pointer)
-	{
-    	memory[end_pointer] = value;
-		++end_pointer;
-	} else if(end_pointer>max)
-	{
+	if (_size == _memory.size())
 		return false;
-	} else if((((memory[end_pointer>>1] & 0xfffff)-(value& 0xfffff))>>19) & 0x1)
-	{
-     	memory[end_pointer] = value;
-		++end_pointer;
-	} else
-	{
-        memory[end_pointer] = memory[end_pointer>>1];
-		end_safe = end_pointer;
-		end_pointer = end_pointer>>1;
-        insert(value);
-        end_pointer = end_safe + 1;
-	}
+	_memory[_size] = value;
+	sift_up(_size++);
 	return true;
 }
 
@@ -95,39 +101,10 @@ bool heap_mem<T>::insert(const T& value)
 template <class T>
 void heap_mem<T>::get(T& value)
 {
-//	printf("Start get: %i, %i\n",end_pointer,max);
-	unsigned int i=1;
-	T temp;
-
-    value = memory[start_pointer];
-    --end_pointer;
-    memory[start_pointer] = memory[end_pointer];
-	if(start_pointer != end_pointer)
-	{
-		while (i<=((end_pointer-1)>>1))
-		{
-			if (((((memory[i<<1] & 0xfffff)-(memory[(i<<1)+1] & 0xfffff))>>19) & 0x1) || (end_pointer-1 == (i<<1)))
-			{
-				if ((((memory[i<<1] & 0xfffff)-(memory[i] & 0xfffff))>>19) & 0x1)
-                {
-					temp = memory[i];
-//					printf("get1: mem[%i]=%.8X > mem[%i]=%.8X (endp = %i) (temp= %.8x)\n",i,memory[i],i<<1,memory[i<<1],end_pointer,temp);
-					memory[i] = memory[i<<1];
-					memory[i<<1] = temp;
-				}
-			} else
-			{
-				if ((((memory[(i<<1)+1] & 0xfffff)-(memory[i] & 0xfffff))>>19) & 0x1)
-				{
-                	temp = memory[i];
-//					printf("get2: mem[%i]=%.8X > mem[%i]=%.8X (endp = %i) (temp= %.8x)\n",i,memory[i],(i<<1)+1,memory[(i<<1)+1],end_pointer,temp);
-					memory[i] = memory[(i<<1)+1];
-					memory[(i<<1)+1] = temp;
-				}
-			}
-			++i;
-		}
-	}
+	assert(_size > 0);
+	value = _memory[0];
+	_memory[0] = _memory[--_size];
+	sift_down(0);
 }
 
 /// Function to view heap root data.
@@ -136,14 +113,14 @@ void heap_mem<T>::get(T& value)
 template <class T>
 void heap_mem<T>::view_next(T& value)
 {
-	value = memory[start_pointer];
+	value = _memory[0];
 }
 
 /// Zero while heap memory contains data.
 template <class T>
 bool heap_mem<T>::empty()
 {
-	return (start_pointer == end_pointer);
+	return _size == 0;
 }
 
 
@@ -151,7 +128,71 @@ bool heap_mem<T>::empty()
 template <class T>
 unsigned int heap_mem<T>::num_available()
 {
-	return (end_pointer-1);
+	return _size;
+}
+
+template <class T>
+template <class It>
+bool heap_mem<T>::assign(It first, It last)
+{
+	_size = 0;
+	for (; first != last; ++first) {
+		if (_size == _memory.size()) {
+			_size = 0;
+			return false;
+		}
+		_memory[_size++] = *first;
+	}
+	// bottom-up construction, starting at the last node with children
+	for (size_t pos = _size/arity + 1; pos-- > 0; )
+		sift_down(pos);
+	return true;
+}
+
+template <class T>
+void heap_mem<T>::checkpoint(state_archive& ar)
+{
+	std::vector<T> contents(_memory.begin(), _memory.begin() + _size);
+	ar.sequence(contents);
+	if (ar.loading() && !assign(contents.begin(), contents.end()))
+		throw std::runtime_error("heap_mem: checkpoint exceeds the memory depth");
+}
+
+template <class T>
+void heap_mem<T>::sift_up(size_t pos)
+{
+	const T value = _memory[pos];
+	while (pos > 0) {
+		const size_t parent = (pos - 1)/arity;
+		if (!before(value, _memory[parent]))
+			break;
+		_memory[pos] = _memory[parent];
+		pos = parent;
+	}
+	_memory[pos] = value;
+}
+
+template <class T>
+void heap_mem<T>::sift_down(size_t pos)
+{
+	if (pos >= _size)
+		return;
+	const T value = _memory[pos];
+	for (;;) {
+		const size_t first_child = arity*pos + 1;
+		if (first_child >= _size)
+			break;
+		const size_t last_child = std::min(first_child + arity, _size);
+		size_t next = first_child;
+		for (size_t c = first_child + 1; c < last_child; ++c)
+			if (before(_memory[c], _memory[next]))
+				next = c;
+		if (!before(_memory[next], value))
+			break;
+		_memory[pos] = _memory[next];
+		pos = next;
+	}
+	_memory[pos] = value;
 }
 
 } // end namespace ess
@@ -0,0 +1,55 @@
+#ifndef __L2_EVENT_H__
+#define __L2_EVENT_H__
+
+#include <stdint.h>
+#include <ostream>
+#include <type_traits>
+
+#include "sim_def.h"
+
+namespace ess
+{
+
+/// Pulse event of the Layer 2 network, as transferred between FPGA, DNC and dnc_if.
+/// The bit layout is the one of the hardware packets:
+///   MSB | <5 bit unused> | <3 bit HICANN channel> | <3 bit L1 bus> | <6 bit L1 address> | <15 bit time stamp> | LSB
+/// The HICANN channel is only used between FPGA and DNC, the label is formed by the 12 bit above the time stamp.
+/// The event is a plain 32 bit word, all fields are extracted by shifts and masks.
+struct l2_event
+{
+	static const unsigned address_width = L1_ADDR_WIDTH + 3; ///< L1 bus and L1 address
+
+	uint32_t value;
+
+	static constexpr l2_event from(uint32_t value) { return l2_event{value}; }
+
+	static constexpr l2_event make(uint32_t label, uint32_t time)
+	{
+		return l2_event{((label & ((1u << L2_LABEL_WIDTH) - 1)) << TIMESTAMP_WIDTH) | (time & ((1u << TIMESTAMP_WIDTH) - 1))};
+	}
+
+	constexpr uint32_t time() const { return value & ((1u << TIMESTAMP_WIDTH) - 1); }
+	constexpr uint32_t neuron() const { return (value >> TIMESTAMP_WIDTH) & ((1u << L1_ADDR_WIDTH) - 1); }
+	constexpr uint32_t l1bus() const { return (value >> (TIMESTAMP_WIDTH + L1_ADDR_WIDTH)) & 0x7; }
+	/// address on the HICANN channel, i.e. L1 bus and L1 address
+	constexpr uint32_t address() const { return (value >> TIMESTAMP_WIDTH) & ((1u << address_width) - 1); }
+	constexpr uint32_t channel() const { return (value >> (TIMESTAMP_WIDTH + address_width)) & 0x7; }
+	constexpr uint32_t label() const { return (value >> TIMESTAMP_WIDTH) & ((1u << L2_LABEL_WIDTH) - 1); }
+
+	/// event without the HICANN channel, as sent between DNC and dnc_if
+	constexpr l2_event without_channel() const { return l2_event{value & ((1u << (TIMESTAMP_WIDTH + address_width)) - 1)}; }
+
+	constexpr bool operator==(l2_event const& other) const { return value == other.value; }
+	constexpr bool operator!=(l2_event const& other) const { return value != other.value; }
+};
+
+static_assert(std::is_pod<l2_event>::value && sizeof(l2_event) == sizeof(uint32_t), "l2_event has to be a plain 32 bit word");
+
+inline std::ostream& operator<<(std::ostream& os, l2_event const& e)
+{
+	return os << e.value;
+}
+
+} // end namespace ess
+
+#endif // __L2_EVENT_H__
@@ -16,11 +16,20 @@
 #ifndef __L2L1BUFF_H__
 #define __L2L1BUFF_H__
 
+#include "l2_event.h"
+
 namespace ess{
 /// This struct provides a Layer2 to Layer1 buffer element.
 struct l2tol1_buffer_element{
-		bool valid;
-		sc_uint <TIMESTAMP_WIDTH+L1_ADDR_WIDTH> value;
+		sc_time release; ///< time of the clock cycle, in which the event is released
+		uint64_t order; ///< arrival number, releases events of the same cycle in arrival order
+		l2_event event;
+
+		/// heap ordering, the element released first is on top of the heap
+		static bool released_after(l2tol1_buffer_element const& a, l2tol1_buffer_element const& b)
+		{
+			return a.release > b.release || (a.release == b.release && a.order > b.order);
+		}
 		};
 }
 
@@ -0,0 +1,50 @@
+#ifndef __MAPPED_FILE_H__
+#define __MAPPED_FILE_H__
+
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ess
+{
+
+/// read-only memory mapping of a whole file.
+/// data is NULL if the file could not be mapped or is empty.
+struct mapped_file
+{
+	const unsigned char* data;
+	size_t size;
+
+	explicit mapped_file(std::string const& fn) : data(NULL), size(0)
+	{
+		int fd = ::open(fn.c_str(), O_RDONLY);
+		if (fd < 0)
+			return;
+		struct stat st;
+		if (fstat(fd, &st) == 0 && st.st_size > 0) {
+			void* p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (p != MAP_FAILED) {
+				data = static_cast<const unsigned char*>(p);
+				size = st.st_size;
+			}
+		}
+		::close(fd);
+	}
+
+	~mapped_file()
+	{
+		if (data)
+			munmap(const_cast<unsigned char*>(data), size);
+	}
+
+private:
+	mapped_file(const mapped_file&);
+	const mapped_file& operator=(const mapped_file&);
+};
+
+} // namespace ess
+
+#endif // __MAPPED_FILE_H__
@@ -0,0 +1,87 @@
+#include "pulse_pool.h"
+
+#include <log4cxx/logger.h>
+
+static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("ESS");
+
+namespace ess
+{
+
+const size_t pulse_pool::granularity;
+const size_t pulse_pool::max_block;
+const size_t pulse_pool::slab_size;
+
+pulse_pool::statistics& pulse_pool::statistics::operator+=(statistics const& s)
+{
+	allocations += s.allocations;
+	deallocations += s.deallocations;
+	slabs += s.slabs;
+	heap_allocations += s.heap_allocations;
+	bytes_in_use += s.bytes_in_use;
+	peak_bytes += s.peak_bytes;
+	return *this;
+}
+
+pulse_pool::pulse_pool()
+	: _cursor(nullptr)
+	, _end(nullptr)
+	, _stats()
+{
+	_free.fill(nullptr);
+}
+
+void* pulse_pool::allocate(size_t n)
+{
+	++_stats.allocations;
+	if (n > max_block) {
+		++_stats.heap_allocations;
+		return ::operator new(n);
+	}
+	const size_t c = size_class(n);
+	_stats.bytes_in_use += (c + 1)*granularity;
+	if (_stats.bytes_in_use > _stats.peak_bytes)
+		_stats.peak_bytes = _stats.bytes_in_use;
+	if (free_block* b = _free[c]) {
+		_free[c] = b->next;
+		return b;
+	}
+	return carve((c + 1)*granularity);
+}
+
+void pulse_pool::deallocate(void* p, size_t n)
+{
+	++_stats.deallocations;
+	if (n > max_block) {
+		::operator delete(p);
+		return;
+	}
+	const size_t c = size_class(n);
+	_stats.bytes_in_use -= (c + 1)*granularity;
+	free_block* b = static_cast<free_block*>(p);
+	b->next = _free[c];
+	_free[c] = b;
+}
+
+/// takes n bytes from the newest slab, the rest of a too small slab is dropped
+char* pulse_pool::carve(size_t n)
+{
+	if (size_t(_end - _cursor) < n) {
+		_slabs.emplace_back(new char[slab_size]);
+		++_stats.slabs;
+		_cursor = _slabs.back().get();
+		_end = _cursor + slab_size;
+	}
+	char* p = _cursor;
+	_cursor += n;
+	return p;
+}
+
+void pulse_pool::report(statistics const& s)
+{
+	LOG4CXX_INFO(logger, "pulse_pool: " << s.allocations << " allocations, "
+			<< s.deallocations << " deallocations, " << s.slabs << " slabs of "
+			<< slab_size << " bytes, " << s.heap_allocations
+			<< " allocations from the global heap, peak " << s.peak_bytes << " bytes in use" );
+}
+
+} // namespace ess
@@ -0,0 +1,122 @@
+#ifndef __PULSE_POOL_H__
+#define __PULSE_POOL_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace ess
+{
+
+/// Arena for the storage of the containers which hold pulses in flight
+/// (queue chunks, tree nodes). Memory is taken from the global heap in slabs
+/// and recycled in free lists per size class, so once a container has reached
+/// its working size, pushing and popping pulses does not touch the global heap.
+/// Slabs are only returned with the pool.
+/// Requests larger than max_block are passed to the global heap and counted.
+/// A pool is owned by a HICANN or DNC and must only be used from one thread,
+/// which is the case for all SystemC processes.
+class pulse_pool
+{
+public:
+	static const size_t granularity = 16;      ///< block sizes are multiples of this
+	static const size_t max_block = 1024;      ///< largest block served from the slabs
+	static const size_t slab_size = 1 << 16;   ///< bytes taken from the global heap at once
+
+	struct statistics
+	{
+		uint64_t allocations;      //!< blocks handed out
+		uint64_t deallocations;    //!< blocks given back
+		uint64_t slabs;            //!< slabs taken from the global heap
+		uint64_t heap_allocations; //!< large requests passed to the global heap
+		uint64_t bytes_in_use;     //!< bytes currently handed out
+		uint64_t peak_bytes;       //!< maximum of bytes_in_use
+
+		statistics& operator+=(statistics const& s);
+	};
+
+	pulse_pool();
+
+	void* allocate(size_t n);
+	void deallocate(void* p, size_t n);
+
+	statistics const& get_statistics() const { return _stats; }
+
+	/// logs the statistics of one or more pools (summed with +=)
+	static void report(statistics const& s);
+
+private:
+	pulse_pool(pulse_pool const&);
+	pulse_pool& operator=(pulse_pool const&);
+
+	struct free_block { free_block* next; };
+
+	static size_t size_class(size_t n) { return n == 0 ? 0 : (n - 1)/granularity; }
+
+	char* carve(size_t n);
+
+	std::array<free_block*, max_block/granularity> _free; ///< free lists per size class
+	std::vector< std::unique_ptr<char[]> > _slabs;
+	char* _cursor; ///< unused part of the newest slab
+	char* _end;
+	statistics _stats;
+};
+
+/// std allocator drawing from a pulse_pool.
+/// A default constructed allocator uses the global heap,
+/// so that containers can be assigned a pool after construction (see sized_queue::set_pool()).
+template<class T> class pool_allocator
+{
+public:
+	typedef T value_type;
+	typedef std::true_type propagate_on_container_copy_assignment;
+	typedef std::true_type propagate_on_container_move_assignment;
+	typedef std::true_type propagate_on_container_swap;
+
+	template<class U> struct rebind { typedef pool_allocator<U> other; };
+
+	pool_allocator() : _pool(nullptr) {}
+	explicit pool_allocator(pulse_pool* pool) : _pool(pool) {}
+	template<class U> pool_allocator(pool_allocator<U> const& a) : _pool(a.pool()) {}
+
+	T* allocate(size_t n)
+	{
+		if (_pool)
+			return static_cast<T*>(_pool->allocate(n*sizeof(T)));
+		return static_cast<T*>(::operator new(n*sizeof(T)));
+	}
+
+	void deallocate(T* p, size_t n)
+	{
+		if (_pool)
+			_pool->deallocate(p, n*sizeof(T));
+		else
+			::operator delete(p);
+	}
+
+	pulse_pool* pool() const { return _pool; }
+
+private:
+	pulse_pool* _pool;
+};
+
+template<class T, class U>
+bool operator==(pool_allocator<T> const& a, pool_allocator<U> const& b)
+{
+	return a.pool() == b.pool();
+}
+
+template<class T, class U>
+bool operator!=(pool_allocator<T> const& a, pool_allocator<U> const& b)
+{
+	return a.pool() != b.pool();
+}
+
+} // namespace ess
+
+#endif // __PULSE_POOL_H__
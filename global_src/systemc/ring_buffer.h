@@ -0,0 +1,132 @@
+#ifndef __RING_BUFFER_H__
+#define __RING_BUFFER_H__
+
+#include <vector>
+#include "sim_def.h"
+
+namespace ess
+{
+
+/// This class provides a FIFO with fixed capacity on preallocated storage.
+/// No memory is allocated after construction or resize(), so it can be used
+/// in the hot path of the simulation.
+/// This class has the same interface as class sized_queue.
+template<class T> class ring_buffer
+{
+private:
+	std::vector<T> _memory;
+	size_t _head;  ///< position of the oldest element
+	size_t _count; ///< number of stored elements
+public:
+	/// constructor with parameter for memory depth
+	///\param m: integer with memory depth
+	explicit ring_buffer (size_t m = DELAY_MEM_DEPTH)
+		: _memory(m), _head(0), _count(0)
+	{}
+
+	// function declarations
+	bool insert(const T&);
+	void get(T&);
+	void view_next(T&);
+	const T& front() const;
+	const T& operator[](size_t i) const;
+	void pop();
+	unsigned int num_available() const;
+	bool empty() const;
+	size_t capacity() const;
+	void resize(size_t m);
+};
+
+/// Function to append data at the end of the buffer.
+///\param value: gets element to insert
+///\return true, if insertion was succesful false otherwise (buffer full)
+template <class T>
+bool ring_buffer<T>::insert(const T& value)
+{
+	if (_count == _memory.size())
+		return false;
+	size_t pos = _head + _count;
+	if (pos >= _memory.size())
+		pos -= _memory.size();
+	_memory[pos] = value;
+	++_count;
+	return true;
+}
+
+/// Function to get and remove the oldest element.
+///\param value: returns first element
+template <class T>
+void ring_buffer<T>::get(T& value)
+{
+	value = front();
+	pop();
+}
+
+/// Function to view the oldest element without removing it.
+///\param value: shows first memory element
+template <class T>
+void ring_buffer<T>::view_next(T& value)
+{
+	value = front();
+}
+
+/// Reference to the oldest element, buffer must not be empty.
+template <class T>
+const T& ring_buffer<T>::front() const
+{
+	return _memory[_head];
+}
+
+/// Reference to the i-th oldest element, i must be smaller than num_available().
+template <class T>
+const T& ring_buffer<T>::operator[](size_t i) const
+{
+	size_t pos = _head + i;
+	if (pos >= _memory.size())
+		pos -= _memory.size();
+	return _memory[pos];
+}
+
+/// Removes the oldest element, buffer must not be empty.
+template <class T>
+void ring_buffer<T>::pop()
+{
+	if (++_head == _memory.size())
+		_head = 0;
+	--_count;
+}
+
+/// Returns number of containing elements.
+template <class T>
+unsigned int ring_buffer<T>::num_available() const
+{
+	return _count;
+}
+
+/// True if buffer contains no data.
+template <class T>
+bool ring_buffer<T>::empty() const
+{
+	return ( _count == 0 );
+}
+
+/// Returns the maximum number of elements.
+template <class T>
+size_t ring_buffer<T>::capacity() const
+{
+	return _memory.size();
+}
+
+/// Changes the capacity. All stored elements are discarded.
+///\param m: integer with new memory depth
+template <class T>
+void ring_buffer<T>::resize(size_t m)
+{
+	_memory.assign(m, T());
+	_head = 0;
+	_count = 0;
+}
+
+} // end namespace ess
+
+#endif // __RING_BUFFER_H__
@@ -1,23 +1,30 @@
 #ifndef __SIZED_QUEUE_H__
 #define __SIZED_QUEUE_H__
 
-#include <queue>
+#include <assert.h>
+#include <deque>
 #include "sim_def.h"
+#include "pulse_pool.h"
+#include "state_archive.h"
 
 namespace ess
 {
 
 /// This class providew a queue with limited size (i.e. a FIFO with limited size)
 /// This class has the same interface as class heap_mem.
+/// The elements are stored in a pulse_pool, if one is given, otherwise on the global heap.
 template<class T> class sized_queue
 {
 private:
-	std::queue<T> _queue;
+	typedef std::deque< T, pool_allocator<T> > queue_type;
+	queue_type _queue;
 	size_t _max_size;
 public:
 	/// constructor with parameter for memory depth
 	///\param m: integer with memory depth
-	explicit sized_queue (size_t m = DELAY_MEM_DEPTH)
+	///\param pool: storage of the elements, nullptr for the global heap
+	explicit sized_queue (size_t m = DELAY_MEM_DEPTH, pulse_pool* pool = nullptr)
+		: _queue(pool_allocator<T>(pool))
 	{
 		_max_size=m;
 	}
@@ -28,6 +35,8 @@ public:
 	void view_next(T&);
 	unsigned int num_available();
 	bool empty();
+	void checkpoint(state_archive& ar);
+	void set_pool(pulse_pool* pool);
 };
 
 /// Function to insert data in heap at correct position.
@@ -37,7 +46,7 @@ template <class T>
 bool sized_queue<T>::insert(const T& value)
 {
 	if (_queue.size() < _max_size) {
-		_queue.push(value);
+		_queue.push_back(value);
 		return true;
 	}
 	else {
@@ -52,7 +61,7 @@ template <class T>
 void sized_queue<T>::get(T& value)
 {
 	value = _queue.front();
-	_queue.pop();
+	_queue.pop_front();
 }
 
 /// Function to view heap root data.
@@ -79,6 +88,22 @@ unsigned int sized_queue<T>::num_available()
 	return _queue.size();
 }
 
+/// Stores or restores the contents.
+template <class T>
+void sized_queue<T>::checkpoint(state_archive& ar)
+{
+	ar.sequence(_queue);
+}
+
+/// Moves the storage to the given pool, the queue has to be empty.
+/// Used for queues in arrays, which can only be default constructed.
+template <class T>
+void sized_queue<T>::set_pool(pulse_pool* pool)
+{
+	assert(_queue.empty());
+	_queue = queue_type(pool_allocator<T>(pool));
+}
+
 } // end namespace ess
 
 #endif // __SIZED_QUEUE_H__
@@ -0,0 +1,172 @@
+#include "state_archive.h"
+
+#include <cstdio>
+
+#include <log4cxx/logger.h>
+
+#include "mapped_file.h"
+
+static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("ESS.Checkpoint");
+
+namespace ess
+{
+
+namespace {
+/// model time offset in time resolution units
+sc_dt::uint64 model_offset = 0;
+} // anonymous namespace
+
+double model_seconds(sc_time const& t)
+{
+	return sc_time::from_value(t.value() + model_offset).to_seconds();
+}
+
+sc_time model_time_offset()
+{
+	return sc_time::from_value(model_offset);
+}
+
+void set_model_time_offset(sc_time const& offset)
+{
+	model_offset = offset.value();
+}
+
+const char state_archive::magic[4] = {'E', 'S', 'S', 'K'};
+const uint32_t state_archive::version;
+
+state_archive::state_archive()
+	: _loading(false)
+	, _pos(0)
+	, _shift(SC_ZERO_TIME)
+{
+	_buffer.reserve(1 << 16);
+	for (char c : magic)
+		_buffer.push_back(c);
+	uint64_t v = version;
+	raw(v, sizeof(uint32_t));
+}
+
+state_archive::state_archive(std::string const& fn)
+	: _loading(true)
+	, _pos(0)
+	, _shift(SC_ZERO_TIME)
+{
+	{
+		mapped_file file(fn);
+		if (!file.data || file.size < 8 || std::memcmp(file.data, magic, 4) != 0) {
+			LOG4CXX_ERROR(logger, "state_archive: no checkpoint: " << fn );
+			throw std::runtime_error("state_archive: no checkpoint " + fn);
+		}
+		_buffer.assign(file.data, file.data + file.size);
+	}
+	_pos = 4;
+	uint64_t v = 0;
+	raw(v, sizeof(uint32_t));
+	if (v != version) {
+		LOG4CXX_ERROR(logger, "state_archive: unsupported version " << v << " of checkpoint " << fn );
+		throw std::runtime_error("state_archive: unsupported checkpoint version");
+	}
+}
+
+void state_archive::save(std::string const& fn) const
+{
+	FILE* f = fopen(fn.c_str(), "wb");
+	if (!f || fwrite(&_buffer[0], 1, _buffer.size(), f) != _buffer.size()) {
+		if (f)
+			fclose(f);
+		LOG4CXX_ERROR(logger, "state_archive::save(): could not write file: " << fn );
+		throw std::runtime_error("state_archive::save(): could not write file " + fn);
+	}
+	fclose(f);
+}
+
+void state_archive::raw(uint64_t& u, size_t n)
+{
+	if (!_loading) {
+		for (size_t i = 0; i < n; ++i)
+			_buffer.push_back((u >> (8*i)) & 0xff);
+		return;
+	}
+	if (_buffer.size() - _pos < n)
+		throw std::runtime_error("state_archive: unexpected end of checkpoint in " + _section);
+	u = 0;
+	for (size_t i = 0; i < n; ++i)
+		u |= uint64_t(_buffer[_pos + i]) << (8*i);
+	_pos += n;
+}
+
+void state_archive::section(std::string const& name)
+{
+	uint64_t n = name.size();
+	raw(n, sizeof(n));
+	std::string stored(name);
+	if (_loading) {
+		if (_buffer.size() - _pos < n)
+			throw std::runtime_error("state_archive: unexpected end of checkpoint after " + _section);
+		stored.assign(_buffer.begin() + _pos, _buffer.begin() + _pos + n);
+		_pos += n;
+	} else {
+		_buffer.insert(_buffer.end(), name.begin(), name.end());
+	}
+	if (stored != name) {
+		LOG4CXX_ERROR(logger, "state_archive: expected state of " << name << ", found " << stored );
+		throw std::runtime_error("state_archive: checkpoint of a different system, found " + stored);
+	}
+	_section = name;
+}
+
+void state_archive::check_size(size_t n)
+{
+	uint64_t stored = n;
+	raw(stored, sizeof(stored));
+	if (stored != n) {
+		LOG4CXX_ERROR(logger, "state_archive: size " << stored << " in " << _section << " does not match " << n );
+		throw std::runtime_error("state_archive: checkpoint of a different configuration in " + _section);
+	}
+}
+
+void state_archive::finish() const
+{
+	if (_loading && _pos != _buffer.size())
+		throw std::runtime_error("state_archive: checkpoint contains more data than restored");
+}
+
+void state_archive::time(sc_time& t)
+{
+	uint64_t v = t.value();
+	raw(v, sizeof(v));
+	if (_loading) {
+		t = sc_time::from_value(v);
+		if (t < _shift)
+			throw std::runtime_error("state_archive: time before the restore point in " + _section);
+		t -= _shift;
+	}
+}
+
+void state_archive::seconds(double& t)
+{
+	value(t);
+}
+
+void state_archive::simulation_time(double& t)
+{
+	value(t);
+	if (_loading)
+		t -= _shift.to_default_time_units();
+}
+
+void state_archive::event(timed_event& e)
+{
+	bool pending = e.pending();
+	sc_time t = pending ? e.pending_time() : SC_ZERO_TIME;
+	value(pending);
+	if (pending)
+		time(t);
+	if (_loading) {
+		e.cancel();
+		if (pending)
+			e.notify(t - sc_time_stamp());
+	}
+}
+
+} // namespace ess
@@ -0,0 +1,204 @@
+#ifndef __STATE_ARCHIVE_H__
+#define __STATE_ARCHIVE_H__
+
+#include "systemc.h"
+
+#include <stdint.h>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "timed_event.h"
+
+namespace ess
+{
+
+/** Binary archive for checkpoints of the dynamic simulation state (values little-endian).
+ *
+ *  Every module implements one function checkpoint(state_archive&), which is used for
+ *  saving and for restoring its state: when saving, the accessors below read the
+ *  referenced variables, when loading they overwrite them. Hence, both directions
+ *  can not diverge.
+ *
+ *  Absolute simulation times are stored as they are. When loading, they are moved
+ *  back by the shift, so that a checkpoint taken at time T can be restored at T - shift.
+ *  The neuron and STP models compute with model times instead (see model_seconds()),
+ *  which are not moved, so that a restored run computes the same values.
+ *
+ *  file layout:
+ *    char[4]  magic "ESSK"
+ *    uint32   version
+ *    the values in the order of the checkpoint() calls
+ */
+class state_archive
+{
+public:
+	static const char     magic[4];
+	static const uint32_t version = 2;
+
+	/// empty archive for saving
+	state_archive();
+
+	/// archive with the data written by save(),
+	/// throws std::runtime_error if fn is no checkpoint of this version.
+	explicit state_archive(std::string const& fn);
+
+	bool loading() const { return _loading; }
+
+	/// sets the shift applied to absolute times when loading
+	void set_shift(sc_time const& shift) { _shift = shift; }
+
+	/// writes the archive to fn, throws std::runtime_error on failure
+	void save(std::string const& fn) const;
+
+	/// marks the begin of the state of a module.
+	/// When loading, throws std::runtime_error if the stored name differs,
+	/// i.e. if the checkpoint is restored into a differently built system.
+	void section(std::string const& name);
+
+	/// stores n, when loading throws std::runtime_error if the stored value differs.
+	/// Used for sizes fixed by the configuration.
+	void check_size(size_t n);
+
+	/// throws std::runtime_error if not all data has been loaded
+	void finish() const;
+
+	/// arithmetic types and enums
+	template<class T>
+	void value(T& v);
+
+	template<int W>
+	void value(sc_dt::sc_uint<W>& v);
+
+	template<class T, size_t N>
+	void value(T (&a)[N]);
+
+	/// containers with size(), resize() and iterators, e.g. std::vector and std::deque.
+	/// Each element is passed to f.
+	template<class C, class F>
+	void sequence(C& c, F f);
+
+	/// containers of values
+	template<class C>
+	void sequence(C& c);
+
+	/// absolute simulation time, has to be after the checkpoint time minus the shift
+	void time(sc_time& t);
+
+	/// model time in seconds (see model_seconds()), stored as is
+	void seconds(double& t);
+
+	/// absolute simulation time in default time units, as returned by sc_simulation_time().
+	/// Unlike sc_time, the restored value may be negative.
+	void simulation_time(double& t);
+
+	/// pending notification of e. When loading, the notification is restored
+	/// if it was pending, otherwise e is cancelled.
+	void event(timed_event& e);
+
+	/// contents of a sc_fifo. When loading, the fifo has to be empty.
+	template<class T>
+	void fifo(sc_fifo<T>& f);
+
+private:
+	void raw(uint64_t& u, size_t n);
+
+	/// read access to the buffer of a sc_fifo, which has no interface to peek at its contents
+	template<class T>
+	struct fifo_access : sc_fifo<T>
+	{
+		static void contents(sc_fifo<T> const& f, std::vector<T>& data)
+		{
+			T* const sc_fifo<T>::* buf = &fifo_access::m_buf;
+			int const sc_fifo<T>::* ri = &fifo_access::m_ri;
+			int const sc_fifo<T>::* size = &fifo_access::m_size;
+			data.clear();
+			for (int i = 0, pos = f.*ri; i < f.num_available(); ++i, pos = (pos + 1) % f.*size)
+				data.push_back((f.*buf)[pos]);
+		}
+	};
+
+	bool _loading;
+	std::vector<unsigned char> _buffer;
+	size_t _pos;
+	sc_time _shift;
+	std::string _section; ///< current section, for error messages
+};
+
+/// time in seconds of the neuron and STP models at simulation time t.
+/// A system restored from a checkpoint runs behind the simulation time of the checkpoint
+/// by the shift of the state_archive. The model time stays that of the uninterrupted
+/// simulation, i.e. the simulation time plus the model time offset, so the models compute
+/// with the same values. The offset is added to the integer time, hence it is exact.
+double model_seconds(sc_time const& t);
+
+/// model time in seconds of the current simulation time
+inline double model_seconds() { return model_seconds(sc_time_stamp()); }
+
+/// difference of the model time to the simulation time, zero unless restored from a checkpoint
+sc_time model_time_offset();
+void set_model_time_offset(sc_time const& offset);
+
+template<class T>
+void state_archive::value(T& v)
+{
+	static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "no value type");
+	static_assert(sizeof(T) <= sizeof(uint64_t), "value type too large");
+	uint64_t u = 0;
+	std::memcpy(&u, &v, sizeof(T));
+	raw(u, sizeof(T));
+	std::memcpy(&v, &u, sizeof(T));
+}
+
+template<int W>
+void state_archive::value(sc_dt::sc_uint<W>& v)
+{
+	uint64_t u = v.to_uint64();
+	raw(u, sizeof(u));
+	v = u;
+}
+
+template<class T, size_t N>
+void state_archive::value(T (&a)[N])
+{
+	for (auto& e : a)
+		value(e);
+}
+
+template<class C, class F>
+void state_archive::sequence(C& c, F f)
+{
+	uint64_t n = c.size();
+	raw(n, sizeof(n));
+	if (_loading)
+		c.resize(n);
+	for (auto& e : c)
+		f(e);
+}
+
+template<class C>
+void state_archive::sequence(C& c)
+{
+	sequence(c, [this](typename C::value_type& e){ value(e); });
+}
+
+template<class T>
+void state_archive::fifo(sc_fifo<T>& f)
+{
+	std::vector<T> data;
+	if (!_loading)
+		fifo_access<T>::contents(f, data);
+	else if (f.num_available() != 0)
+		throw std::runtime_error("state_archive: restoring into a non-empty fifo in " + _section);
+	sequence(data);
+	if (_loading)
+		for (auto const& e : data)
+			if (!f.nb_write(e))
+				throw std::runtime_error("state_archive: fifo too small in " + _section);
+}
+
+} // namespace ess
+
+#endif // __STATE_ARCHIVE_H__
@@ -0,0 +1,73 @@
+#ifndef __TIMED_EVENT_H__
+#define __TIMED_EVENT_H__
+
+#include "systemc.h"
+
+namespace ess
+{
+
+/// sc_event which remembers the time of its pending timed notification,
+/// so that the notification can be stored in a checkpoint and restored later (see state_archive).
+/// notify() and cancel() of sc_event are hidden, hence all notifications
+/// have to be made through this class.
+class timed_event : public sc_event
+{
+public:
+	timed_event() : _time(SC_ZERO_TIME) {}
+
+	/// immediate notification, cancels a pending notification
+	void notify()
+	{
+		_time = SC_ZERO_TIME;
+		sc_event::notify();
+	}
+
+	/// timed notification, as for sc_event an earlier pending notification is kept
+	void notify(const sc_time& delay)
+	{
+		const sc_time t = sc_time_stamp() + delay;
+		if (!pending() || t < _time)
+			_time = t;
+		sc_event::notify(delay);
+	}
+
+	void notify(double delay, sc_time_unit unit)
+	{
+		notify(sc_time(delay, unit));
+	}
+
+	/// timed notification at the next rising edge of a clock with the given period,
+	/// which starts at time 0 (as sc_clock). At an edge, the notification is for the next delta cycle.
+	void notify_next_edge(const sc_time& period)
+	{
+		const sc_time::value_type now = sc_time_stamp().value();
+		const sc_time::value_type p = period.value();
+		notify(sc_time::from_value((now + p - 1)/p*p - now));
+	}
+
+	void cancel()
+	{
+		_time = SC_ZERO_TIME;
+		sc_event::cancel();
+	}
+
+	/// true if a timed notification is pending.
+	/// Notifications at the current time have already been triggered.
+	bool pending() const
+	{
+		return _time > sc_time_stamp();
+	}
+
+	/// absolute time of the pending notification, only valid if pending()
+	const sc_time& pending_time() const
+	{
+		return _time;
+	}
+
+private:
+	sc_time _time; ///< absolute time of the last timed notification
+};
+
+} // namespace ess
+
+#endif // __TIMED_EVENT_H__
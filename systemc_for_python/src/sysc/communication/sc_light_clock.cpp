@@ -0,0 +1,145 @@
+/*****************************************************************************
+
+  sc_light_clock.cpp -- Clock which only notifies its edge events.
+
+ *****************************************************************************/
+
+#include "sysc/communication/sc_light_clock.h"
+#include "sysc/communication/sc_communication_ids.h"
+#include "sysc/kernel/sc_simcontext.h"
+#include "sysc/kernel/sc_process.h"
+#include "sysc/kernel/sc_spawn.h"
+
+#include <sstream>
+
+namespace sc_core {
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_light_clock
+//
+//  Periodic edge events with the timing of sc_clock.
+// ----------------------------------------------------------------------------
+
+// constructors
+
+sc_light_clock::sc_light_clock( const char* name_,
+				const sc_time& period_,
+				double         duty_cycle_,
+				const sc_time& start_time_,
+				bool           posedge_first_ ) :
+    sc_prim_channel( name_ ),
+    m_period(), m_duty_cycle(), m_start_time(), m_posedge_first(),
+    m_posedge_time(), m_negedge_time(), m_next_posedge(),
+    m_next_edge_event( sc_event::kernel_event, "next_edge_event" ),
+    m_posedge_event( sc_event::kernel_event, "posedge_event" ),
+    m_negedge_event( sc_event::kernel_event, "negedge_event" ),
+    m_edge_event( sc_event::kernel_event, "value_changed_event" ),
+    m_posedge_used( false ), m_negedge_used( false ), m_edge_used( false )
+{
+    init( period_,
+	  duty_cycle_,
+	  start_time_,
+	  posedge_first_ );
+}
+
+sc_light_clock::sc_light_clock( const char* name_,
+				double         period_v_,
+				sc_time_unit   period_tu_,
+				double         duty_cycle_ ) :
+    sc_prim_channel( name_ ),
+    m_period(), m_duty_cycle(), m_start_time(), m_posedge_first(),
+    m_posedge_time(), m_negedge_time(), m_next_posedge(),
+    m_next_edge_event( sc_event::kernel_event, "next_edge_event" ),
+    m_posedge_event( sc_event::kernel_event, "posedge_event" ),
+    m_negedge_event( sc_event::kernel_event, "negedge_event" ),
+    m_edge_event( sc_event::kernel_event, "value_changed_event" ),
+    m_posedge_used( false ), m_negedge_used( false ), m_edge_used( false )
+{
+    init( sc_time( period_v_, period_tu_, simcontext() ),
+	  duty_cycle_,
+	  SC_ZERO_TIME,
+	  true );
+}
+
+
+//------------------------------------------------------------------------------
+//"sc_light_clock::before_end_of_elaboration"
+//
+// Spawns the edge process, as sc_clock does, so that it is registered with
+// the global simcontext rather than the scope of the clock's parent.
+//------------------------------------------------------------------------------
+
+void sc_light_clock::before_end_of_elaboration()
+{
+    std::string gen_base;
+    sc_spawn_options edge_options;	// Options for the edge process.
+
+    edge_options.spawn_method();
+    edge_options.dont_initialize();
+    edge_options.set_sensitivity(&m_next_edge_event);
+    gen_base = basename();
+    gen_base += "_edge_action";
+    sc_spawn(sc_light_clock_edge_callback(this),
+	sc_gen_unique_name( gen_base.c_str() ), &edge_options);
+}
+
+// destructor (does nothing)
+
+sc_light_clock::~sc_light_clock()
+{}
+
+
+// error reporting
+
+void
+sc_light_clock::report_error( const char* id, const char* add_msg ) const
+{
+    std::stringstream msg;
+    if( add_msg != 0 )
+      msg << add_msg << ": ";
+    msg << "clock '" << name() << "'";
+    SC_REPORT_ERROR( id, msg.str().c_str() );
+}
+
+
+void
+sc_light_clock::init( const sc_time& period_,
+		      double         duty_cycle_,
+		      const sc_time& start_time_,
+		      bool           posedge_first_ )
+{
+    if( period_ == SC_ZERO_TIME ) {
+        report_error( SC_ID_CLOCK_PERIOD_ZERO_, "increase the period" );
+        // may continue, if suppressed
+    }
+    m_period = period_;
+    m_posedge_first = posedge_first_;
+
+    if( duty_cycle_ <= 0.0 || duty_cycle_ >= 1.0 ) {
+	m_duty_cycle = 0.5;
+    } else {
+	m_duty_cycle = duty_cycle_;
+    }
+
+    m_negedge_time = m_period * m_duty_cycle;
+    m_posedge_time = m_period - m_negedge_time;
+
+    if( m_negedge_time == SC_ZERO_TIME ) {
+        report_error( SC_ID_CLOCK_HIGH_TIME_ZERO_,
+                      "increase the period or increase the duty cycle" );
+        // may continue, if suppressed
+    }
+    if( m_posedge_time == SC_ZERO_TIME ) {
+        report_error( SC_ID_CLOCK_LOW_TIME_ZERO_,
+                      "increase the period or decrease the duty cycle" );
+        // may continue, if suppressed
+    }
+
+    m_start_time = start_time_;
+    m_next_posedge = posedge_first_;
+    m_next_edge_event.notify_internal( m_start_time );
+}
+
+} // namespace sc_core
+
+// Taf!
@@ -0,0 +1,180 @@
+/*****************************************************************************
+
+  sc_light_clock.h -- Clock which only notifies its edge events.
+
+  Unlike sc_clock, this clock is no signal: an edge does not write a value,
+  requests no update and notifies no value-changed event. A single kernel
+  process per clock notifies the edge events. Negative edges are only
+  generated if negedge_event() or default_event() has been requested.
+
+ *****************************************************************************/
+
+#ifndef SC_LIGHT_CLOCK_H
+#define SC_LIGHT_CLOCK_H
+
+
+#include "sysc/communication/sc_interface.h"
+#include "sysc/communication/sc_prim_channel.h"
+#include "sysc/kernel/sc_event.h"
+#include "sysc/kernel/sc_time.h"
+
+namespace sc_core {
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_light_clock
+//
+//  Periodic edge events with the timing of sc_clock: the events are notified
+//  for the delta cycle after the edge, which is when processes sensitive to
+//  the edges of a sc_clock run. Hence, a sc_clock which is only used as
+//  sensitivity of processes can be replaced by this class.
+// ----------------------------------------------------------------------------
+
+class SC_API sc_light_clock
+  : public sc_interface, public sc_prim_channel
+{
+public:
+
+    friend class sc_light_clock_edge_callback;
+
+    // constructors
+
+    sc_light_clock( const char* name_,
+		    const sc_time& period_,
+		    double         duty_cycle_ = 0.5,
+		    const sc_time& start_time_ = SC_ZERO_TIME,
+		    bool           posedge_first_ = true );
+
+    sc_light_clock( const char* name_,
+		    double         period_v_,
+		    sc_time_unit   period_tu_,
+		    double         duty_cycle_ = 0.5 );
+
+    virtual ~sc_light_clock();
+
+
+    // edge events
+
+    const sc_event& posedge_event() const
+	{ m_posedge_used = true; return m_posedge_event; }
+
+    const sc_event& negedge_event() const
+	{ m_negedge_used = true; return m_negedge_event; }
+
+    // both edges, as the value-changed event of sc_clock (sensitive << clock)
+    virtual const sc_event& default_event() const
+	{ m_edge_used = true; return m_edge_event; }
+
+    const sc_event& value_changed_event() const
+	{ return default_event(); }
+
+
+    // get the period
+    const sc_time& period() const
+	{ return m_period; }
+
+    // get the duty cycle
+    double duty_cycle() const
+	{ return m_duty_cycle; }
+
+    bool posedge_first() const
+        { return m_posedge_first; }
+
+    sc_time start_time() const
+        { return m_start_time; }
+
+    virtual const char* kind() const
+        { return "sc_light_clock"; }
+
+protected:
+
+    void before_end_of_elaboration();
+
+    // process
+    void edge_action();
+
+
+    // error reporting
+    void report_error( const char* id, const char* add_msg = 0 ) const;
+
+
+    void init( const sc_time&, double, const sc_time&, bool );
+
+protected:
+
+    sc_time  m_period;		// the period of this clock
+    double   m_duty_cycle;	// the duty cycle (fraction of period)
+    sc_time  m_start_time;	// the start time of the first edge
+    bool     m_posedge_first;   // true if first edge is positive
+    sc_time  m_posedge_time;	// time from a negative to a positive edge
+    sc_time  m_negedge_time;	// time from a positive to a negative edge
+    bool     m_next_posedge;	// m_next_edge_event is a positive edge
+
+    sc_event m_next_edge_event;
+    sc_event m_posedge_event;
+    sc_event m_negedge_event;
+    sc_event m_edge_event;
+
+    // events requested, only these are notified
+    mutable bool m_posedge_used;
+    mutable bool m_negedge_used;
+    mutable bool m_edge_used;
+
+private:
+
+    // disabled
+    sc_light_clock( const sc_light_clock& );
+    sc_light_clock& operator = ( const sc_light_clock& );
+};
+
+
+// IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
+
+// process
+
+inline
+void
+sc_light_clock::edge_action()
+{
+    if( m_next_posedge ) {
+	if( m_posedge_used ) {
+	    m_posedge_event.notify_next_delta();
+	}
+	if( m_edge_used ) {
+	    m_edge_event.notify_next_delta();
+	}
+	if( m_negedge_used || m_edge_used ) {
+	    m_next_posedge = false;
+	    m_next_edge_event.notify_internal( m_negedge_time );
+	} else {
+	    // nobody waits for the negative edge
+	    m_next_edge_event.notify_internal( m_period );
+	}
+    } else {
+	if( m_negedge_used ) {
+	    m_negedge_event.notify_next_delta();
+	}
+	if( m_edge_used ) {
+	    m_edge_event.notify_next_delta();
+	}
+	m_next_posedge = true;
+	m_next_edge_event.notify_internal( m_posedge_time );
+    }
+}
+
+
+// ----------------------------------------------------------------------------
+
+class SC_API sc_light_clock_edge_callback {
+public:
+    sc_light_clock_edge_callback(sc_light_clock* target_p) : m_target_p(target_p) {}
+    inline void operator () () { m_target_p->edge_action(); }
+  protected:
+    sc_light_clock* m_target_p;
+};
+
+
+} // namespace sc_core
+
+#endif
+
+// Taf!
@@ -183,10 +183,10 @@ public:
     // assignment operators
 
     sc_int<W>& operator = ( int_type v )
-	{ sc_int_base::operator = ( v ); return *this; }
+	{ m_val = v; extend_sign(); return *this; }
 
     sc_int<W>& operator = ( const sc_int_base& a )
-	{ sc_int_base::operator = ( a ); return *this; }
+	{ m_val = a.m_val; extend_sign(); return *this; }
 
     sc_int<W>& operator = ( const sc_int_subref_r& a )
 	{ sc_int_base::operator = ( a ); return *this; }
@@ -230,19 +230,19 @@ public:
 	{ sc_int_base::operator = ( a ); return *this; }
 
     sc_int<W>& operator = ( unsigned long a )
-	{ sc_int_base::operator = ( a ); return *this; }
+	{ m_val = a; extend_sign(); return *this; }
 
     sc_int<W>& operator = ( long a )
-	{ sc_int_base::operator = ( a ); return *this; }
+	{ m_val = a; extend_sign(); return *this; }
 
     sc_int<W>& operator = ( unsigned int a )
-	{ sc_int_base::operator = ( a ); return *this; }
+	{ m_val = a; extend_sign(); return *this; }
 
     sc_int<W>& operator = ( int a )
-	{ sc_int_base::operator = ( a ); return *this; }
+	{ m_val = a; extend_sign(); return *this; }
 
     sc_int<W>& operator = ( uint64 a )
-	{ sc_int_base::operator = ( a ); return *this; }
+	{ m_val = a; extend_sign(); return *this; }
 
     sc_int<W>& operator = ( double a )
 	{ sc_int_base::operator = ( a ); return *this; }
@@ -251,35 +251,35 @@ public:
     // arithmetic assignment operators
 
     sc_int<W>& operator += ( int_type v )
-	{ sc_int_base::operator += ( v ); return *this; }
+	{ m_val += v; extend_sign(); return *this; }
 
     sc_int<W>& operator -= ( int_type v )
-	{ sc_int_base::operator -= ( v ); return *this; }
+	{ m_val -= v; extend_sign(); return *this; }
 
     sc_int<W>& operator *= ( int_type v )
-	{ sc_int_base::operator *= ( v ); return *this; }
+	{ m_val *= v; extend_sign(); return *this; }
 
     sc_int<W>& operator /= ( int_type v )
-	{ sc_int_base::operator /= ( v ); return *this; }
+	{ m_val /= v; extend_sign(); return *this; }
 
     sc_int<W>& operator %= ( int_type v )
-	{ sc_int_base::operator %= ( v ); return *this; }
+	{ m_val %= v; extend_sign(); return *this; }
 
 
     // bitwise assignment operators
 
     sc_int<W>& operator &= ( int_type v )
-	{ sc_int_base::operator &= ( v ); return *this; }
+	{ m_val &= v; extend_sign(); return *this; }
 
     sc_int<W>& operator |= ( int_type v )
-	{ sc_int_base::operator |= ( v ); return *this; }
+	{ m_val |= v; extend_sign(); return *this; }
 
     sc_int<W>& operator ^= ( int_type v )
-	{ sc_int_base::operator ^= ( v ); return *this; }
+	{ m_val ^= v; extend_sign(); return *this; }
 
 
     sc_int<W>& operator <<= ( int_type v )
-	{ sc_int_base::operator <<= ( v ); return *this; }
+	{ m_val <<= v; extend_sign(); return *this; }
 
     sc_int<W>& operator >>= ( int_type v )
 	{ sc_int_base::operator >>= ( v ); return *this; }
@@ -288,16 +288,29 @@ public:
     // prefix and postfix increment and decrement operators
 
     sc_int<W>& operator ++ () // prefix
-	{ sc_int_base::operator ++ (); return *this; }
+	{ ++ m_val; extend_sign(); return *this; }
 
     const sc_int<W> operator ++ ( int ) // postfix
-	{ return sc_int<W>( sc_int_base::operator ++ ( 0 ) ); }
+	{ sc_int<W> tmp( *this ); ++ m_val; extend_sign(); return tmp; }
 
     sc_int<W>& operator -- () // prefix
-	{ sc_int_base::operator -- (); return *this; }
+	{ -- m_val; extend_sign(); return *this; }
 
     const sc_int<W> operator -- ( int ) // postfix
-	{ return sc_int<W>( sc_int_base::operator -- ( 0 ) ); }
+	{ sc_int<W> tmp( *this ); -- m_val; extend_sign(); return tmp; }
+
+private:
+
+    // as sc_int_base::extend_sign(), but with the length known at compile
+    // time, so that it reduces to a constant mask operation
+
+    void extend_sign()
+	{
+#ifdef DEBUG_SYSTEMC
+	    check_value();
+#endif
+	    m_val = ( m_val << ( SC_INTWIDTH - W ) >> ( SC_INTWIDTH - W ) );
+	}
 };
 
 } // namespace sc_dt
@@ -271,18 +271,6 @@ sc_core::sc_vpool<sc_int_subref> sc_int_subref::m_pool(9);
 
 // assignment operators
 
-sc_int_subref&
-sc_int_subref::operator = ( int_type v )
-{
-    int_type val = m_obj_p->m_val;
-    uint_type mask = mask_int[m_left][m_right];
-    val &= mask;
-    val |= (v << m_right) & ~mask;
-    m_obj_p->m_val = val;
-    m_obj_p->extend_sign();
-    return *this;
-}
-
 sc_int_subref&
 sc_int_subref::operator = ( const sc_signed& a )
 {
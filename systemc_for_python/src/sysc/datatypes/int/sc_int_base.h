@@ -547,6 +547,7 @@ class SC_API sc_int_base : public sc_value_base
     friend class sc_int_bitref;
     friend class sc_int_subref_r;
     friend class sc_int_subref;
+    template <int W> friend class sc_int;
 
 
     // support methods
@@ -1195,6 +1196,20 @@ operator << ( ::std::ostream& os, const sc_int_subref_r& a )
 
 // assignment operators
 
+inline
+sc_int_subref&
+sc_int_subref::operator = ( int_type v )
+{
+    uint_type mask = ~( ( ~UINT_ZERO >> ( SC_INTWIDTH - 1 - m_left + m_right ) )
+                        << m_right );
+    int_type val = m_obj_p->m_val;
+    val &= mask;
+    val |= (v << m_right) & ~mask;
+    m_obj_p->m_val = val;
+    m_obj_p->extend_sign();
+    return *this;
+}
+
 inline
 sc_int_subref&
 sc_int_subref::operator = ( const sc_int_base& a )
@@ -184,10 +184,10 @@ public:
     // assignment operators
 
     sc_uint<W>& operator = ( uint_type v )
-	{ sc_uint_base::operator = ( v ); return *this; }
+	{ m_val = v; extend_sign(); return *this; }
 
     sc_uint<W>& operator = ( const sc_uint_base& a )
-	{ sc_uint_base::operator = ( a ); return *this; }
+	{ m_val = a.m_val; extend_sign(); return *this; }
 
     sc_uint<W>& operator = ( const sc_uint_subref_r& a )
 	{ sc_uint_base::operator = ( a ); return *this; }
@@ -231,19 +231,19 @@ public:
 	{ sc_uint_base::operator = ( a ); return *this; }
 
     sc_uint<W>& operator = ( unsigned long a )
-	{ sc_uint_base::operator = ( a ); return *this; }
+	{ m_val = a; extend_sign(); return *this; }
 
     sc_uint<W>& operator = ( long a )
-	{ sc_uint_base::operator = ( a ); return *this; }
+	{ m_val = a; extend_sign(); return *this; }
 
     sc_uint<W>& operator = ( unsigned int a )
-	{ sc_uint_base::operator = ( a ); return *this; }
+	{ m_val = a; extend_sign(); return *this; }
 
     sc_uint<W>& operator = ( int a )
-	{ sc_uint_base::operator = ( a ); return *this; }
+	{ m_val = a; extend_sign(); return *this; }
 
     sc_uint<W>& operator = ( int64 a )
-	{ sc_uint_base::operator = ( a ); return *this; }
+	{ m_val = a; extend_sign(); return *this; }
 
     sc_uint<W>& operator = ( double a )
 	{ sc_uint_base::operator = ( a ); return *this; }
@@ -252,35 +252,35 @@ public:
     // arithmetic assignment operators
 
     sc_uint<W>& operator += ( uint_type v )
-	{ sc_uint_base::operator += ( v ); return *this; }
+	{ m_val += v; extend_sign(); return *this; }
 
     sc_uint<W>& operator -= ( uint_type v )
-	{ sc_uint_base::operator -= ( v ); return *this; }
+	{ m_val -= v; extend_sign(); return *this; }
 
     sc_uint<W>& operator *= ( uint_type v )
-	{ sc_uint_base::operator *= ( v ); return *this; }
+	{ m_val *= v; extend_sign(); return *this; }
 
     sc_uint<W>& operator /= ( uint_type v )
-	{ sc_uint_base::operator /= ( v ); return *this; }
+	{ m_val /= v; extend_sign(); return *this; }
 
     sc_uint<W>& operator %= ( uint_type v )
-	{ sc_uint_base::operator %= ( v ); return *this; }
+	{ m_val %= v; extend_sign(); return *this; }
 
   
     // bitwise assignment operators
 
     sc_uint<W>& operator &= ( uint_type v )
-	{ sc_uint_base::operator &= ( v ); return *this; }
+	{ m_val &= v; extend_sign(); return *this; }
 
     sc_uint<W>& operator |= ( uint_type v )
-	{ sc_uint_base::operator |= ( v ); return *this; }
+	{ m_val |= v; extend_sign(); return *this; }
 
     sc_uint<W>& operator ^= ( uint_type v )
-	{ sc_uint_base::operator ^= ( v ); return *this; }
+	{ m_val ^= v; extend_sign(); return *this; }
 
 
     sc_uint<W>& operator <<= ( uint_type v )
-	{ sc_uint_base::operator <<= ( v ); return *this; }
+	{ m_val <<= v; extend_sign(); return *this; }
 
     sc_uint<W>& operator >>= ( uint_type v )
 	{ sc_uint_base::operator >>= ( v ); return *this; }
@@ -289,16 +289,29 @@ public:
     // prefix and postfix increment and decrement operators
 
     sc_uint<W>& operator ++ () // prefix
-	{ sc_uint_base::operator ++ (); return *this; }
+	{ ++ m_val; extend_sign(); return *this; }
 
     const sc_uint<W> operator ++ ( int ) // postfix
-	{ return sc_uint<W>( sc_uint_base::operator ++ ( 0 ) ); }
+	{ sc_uint<W> tmp( *this ); ++ m_val; extend_sign(); return tmp; }
 
     sc_uint<W>& operator -- () // prefix
-	{ sc_uint_base::operator -- (); return *this; }
+	{ -- m_val; extend_sign(); return *this; }
 
     const sc_uint<W> operator -- ( int ) // postfix
-	{ return sc_uint<W>( sc_uint_base::operator -- ( 0 ) ); }
+	{ sc_uint<W> tmp( *this ); -- m_val; extend_sign(); return tmp; }
+
+private:
+
+    // as sc_uint_base::extend_sign(), but with the length known at compile
+    // time, so that it reduces to a constant mask operation
+
+    void extend_sign()
+	{
+#ifdef DEBUG_SYSTEMC
+	    check_value();
+#endif
+	    m_val &= ( ~UINT_ZERO >> ( SC_INTWIDTH - W ) );
+	}
 };
 
 } // namespace sc_dt
@@ -533,6 +533,7 @@ class SC_API sc_uint_base : public sc_value_base
     friend class sc_uint_bitref;
     friend class sc_uint_subref_r;
     friend class sc_uint_subref;
+    template <int W> friend class sc_uint;
 
 
     // support methods
@@ -1166,6 +1167,20 @@ operator << ( ::std::ostream& os, const sc_uint_subref_r& a )
 
 // assignment operators
 
+inline
+sc_uint_subref&
+sc_uint_subref::operator = ( uint_type v )
+{
+    uint_type mask = ~( ( ~UINT_ZERO >> ( SC_INTWIDTH - 1 - m_left + m_right ) )
+                        << m_right );
+    uint_type val = m_obj_p->m_val;
+    val &= mask;
+    val |= (v << m_right) & ~mask;
+    m_obj_p->m_val = val;
+    m_obj_p->extend_sign();
+    return *this;
+}
+
 inline
 sc_uint_subref&
 sc_uint_subref::operator = ( const sc_uint_base& a )
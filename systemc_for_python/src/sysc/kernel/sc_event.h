@@ -261,6 +261,7 @@ class SC_API sc_event
     friend class sc_thread_process;
     friend void sc_thread_cor_fn( void* arg );
     friend class sc_clock;
+    friend class sc_light_clock;
     friend class sc_event_queue;
     friend class sc_signal_channel;
     template<typename IF> friend class sc_fifo;
@@ -161,8 +161,9 @@ void ADEX::run(double time_to_run, bool is_refractory)
 	// although that both are virtually equal, they are not equal because of machine errors that add up.
 	// Hence we compare for something greate than zero, here 1.e-6*dt.
 	// but still big enough to filter out the machine error
-	if(rec_voltage) //FIXME is this if correct here ???
-    LOG4CXX_TRACE(logger, "ADEX::run called with time_to_run = " << time_to_run << " , t_sim =" << t_sim );
+	if(rec_voltage) { //FIXME is this if correct here ???
+		LOG4CXX_TRACE(logger, "ADEX::run called with time_to_run = " << time_to_run << " , t_sim =" << t_sim );
+	}
 	while( (time_to_run - t_sim) > t_comp_epsilon )
 	{
         //LOG4CXX_TRACE(logger, "ADEX::run looooooooooping: t_sim = " << t_sim << " time_to_run = " << time_to_run );
@@ -1,12 +1,15 @@
 #include "CompoundNeuronModule.h"
+#include "state_archive.h"
+#include <stdexcept>
 #include <log4cxx/logger.h>
 
 static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("ESS.HICANN.Neuron");
 
-CompoundNeuronModule::CompoundNeuronModule(sc_module_name name, size_t N, unsigned int log_neuron, unsigned int wta, sc_port<anncore_pulse_if> *a):
+CompoundNeuronModule::CompoundNeuronModule(sc_module_name name, size_t N, unsigned int log_neuron, unsigned int wta, SpikeReleaseScheduler *s):
 	sc_module(name)
 	,mLastTime(0.)
-	,mClock("mClock", 5,SC_NS)
+	,mTimeOrigin(0.)
+	,mClock("mClock", tick_period_ns, SC_NS)
 	,recording_interval(10.e-9)
 	,mLastRecordTime(-1.) // any values < 0 to allow recording at t=0.
 	,mCompoundNeuron(N)
@@ -14,8 +17,8 @@ CompoundNeuronModule::CompoundNeuronModule(sc_module_name name, size_t N, unsign
 	,addr(0)
 	,wta(wta)
 	,rec_voltage(false)
-	,anc(a)
-	,rel_spike_lock(false)
+	,adc_trace(NULL)
+	,release_scheduler(s)
 {
 	SC_HAS_PROCESS(CompoundNeuronModule);
 
@@ -24,16 +27,14 @@ CompoundNeuronModule::CompoundNeuronModule(sc_module_name name, size_t N, unsign
 	dont_initialize();
 	sensitive << mClock.posedge_event();
 
-	SC_METHOD(release_spike);
-	dont_initialize();
-	sensitive << rel_spike;
-
 	SC_METHOD(record);
 	dont_initialize();
 	sensitive << trigger_record;
 }
 
 CompoundNeuronModule::~CompoundNeuronModule() {
+	// the ADC buffer is owned by HALaccess, which might already be gone
+	adc_trace = NULL;
 	if ( !sc_end_of_simulation_invoked() ) {
 		// If recording, run recording up to the end of simulation
 		if(rec_voltage){
@@ -41,13 +42,13 @@ CompoundNeuronModule::~CompoundNeuronModule() {
 		}
 	}
 	if(rec_voltage){
-		voltage_file.close();
+		voltage_trace.close();
 	}
     LOG4CXX_DEBUG(logger, "CompoundNeuronModule::destructed" );
 }
 
 void CompoundNeuronModule::tick() {
-	double CurrentTime = sc_time_stamp().to_seconds();
+	double CurrentTime = ess::model_seconds();
 	if (CurrentTime > mLastTime) {
 		bool has_fired = mCompoundNeuron.update(mLastTime, CurrentTime);
 		mLastTime=CurrentTime;
@@ -56,70 +57,130 @@ void CompoundNeuronModule::tick() {
 	}
 }
 
-void CompoundNeuronModule::init(unsigned int _addr, bool rec, std::string fn, double dt) {
+void CompoundNeuronModule::init(unsigned int _addr, bool rec, std::string fn, double dt,
+		ESS::voltage_trace_config const& trace_cfg) {
     addr  =_addr;
 	rec_voltage = rec;
+	voltage_trace_file = fn;
+	voltage_trace_cfg = trace_cfg;
 
 	mCompoundNeuron.initialize();
 
+	static const double t_factor = 0.001;
+	recording_interval = dt*t_factor;
+
 	if(rec_voltage)
 	{
-		voltage_file.open(fn);
-		voltage_file.setf(std::ios::scientific,std::ios::floatfield); // scientific values for floating point number, default precision of 6 is ok.
+		voltage_trace.open(fn, recording_interval, trace_cfg);
 		// print values at time 0
-		voltage_file << "#t[Seconds]" << "\t" << "V[Volt]" << "\t" << "w[Ampere]" << "\t" << "g_e[Siemens]" << "\t" << "g_i[Siemens]" << "\n";
 		CompoundNeuronState const & state =  mCompoundNeuron.mState;
-		voltage_file << mLastTime << "\t" << state.V << "\t" << state.denmems[0].w
-			<< "\t" << state.denmems[0].g_syn[0] << "\t" << state.denmems[0].g_syn[1] << "\n";
+		voltage_trace.sample(mLastTime - mTimeOrigin, state.V, state.denmems[0].w,
+				state.denmems[0].g_syn[0], state.denmems[0].g_syn[1]);
 	}
-
-	static const double t_factor = 0.001;
-	recording_interval = dt*t_factor;
+	if(adc_trace)
+		adc_trace->insert(ESS::voltage_to_adc(mCompoundNeuron.mState.V));
 	trigger_record.notify(recording_interval, SC_SEC);
 
     LOG4CXX_DEBUG(logger, "CompoundNeuronModule::init() successfully called!" );
 }
 
+void CompoundNeuronModule::setADCTrace(ess::ring_buffer<uint16_t>* trace) {
+	adc_trace = trace;
+}
+
 void CompoundNeuronModule::setFiringDenmem(size_t id) {
 	mCompoundNeuron.setFiringDenmem(id);
 }
 
-void CompoundNeuronModule::spike_out()
-{
-    LOG4CXX_TRACE(logger, name() << ": spike_out(ADEX): t = " << sc_time_stamp() <<  "\tnext spike : NOW" );
-	if (!rel_spike_lock ) {
-		rel_spike.notify(L1_DELAY_REP_TO_DENMEM, SC_NS);
-		rel_spike_lock = true;
-        LOG4CXX_TRACE(logger, "spike_out(ADEX): rel_spike notify" );
+void CompoundNeuronModule::finish_run() {
+	if(rec_voltage){
+		record();
+		voltage_trace.close();
+	}
+	// the samples of this run are complete, a new buffer is attached for the next run
+	adc_trace = NULL;
+}
+
+void CompoundNeuronModule::reset(sc_time const& origin) {
+	trigger_record.cancel();
+	if(rec_voltage)
+		voltage_trace.close();
+
+	mCompoundNeuron.mState = CompoundNeuronState(mCompoundNeuron.mState.size());
+	mLastTime = ess::model_seconds(origin);
+	mTimeOrigin = mLastTime;
+	mLastRecordTime = -1.;
+	// init() reopens the voltage recording, which overwrites the trace of the last run
+	init(addr, rec_voltage, voltage_trace_file, recording_interval*1000., voltage_trace_cfg);
+}
+
+void CompoundNeuronModule::checkpoint(ess::state_archive& ar) {
+	ar.section(name());
+	CompoundNeuronState& state = mCompoundNeuron.mState;
+	ar.value(state.V);
+	ar.seconds(state.t_end_of_refractory_period);
+	ar.check_size(state.denmems.size());
+	for (auto& denmem : state.denmems) {
+		ar.value(denmem.w);
+		ar.value(denmem.g_syn[0]);
+		ar.value(denmem.g_syn[1]);
+		ar.value(denmem.I_ext);
+	}
+	ar.seconds(mLastTime);
+	ar.seconds(mTimeOrigin);
+	ar.seconds(mLastRecordTime);
+	ar.event(trigger_record);
+
+	bool trace_open = voltage_trace.is_open();
+	ar.value(trace_open);
+	if (ar.loading() && rec_voltage) {
+		voltage_trace.open(voltage_trace_file, recording_interval, voltage_trace_cfg);
+		if (!trace_open)
+			voltage_trace.close();
 	}
-	else {
-        LOG4CXX_TRACE(logger, "spike_out(ADEX): rel_spike lock" );
-		sc_time absolute_rel_time = sc_time_stamp() + sc_time(L1_DELAY_REP_TO_DENMEM, SC_NS);
-		release_spike_buffer.push(absolute_rel_time);
+	voltage_trace.checkpoint(ar);
+
+	bool has_adc = adc_trace;
+	ar.value(has_adc);
+	std::vector<uint16_t> samples;
+	if (adc_trace && !ar.loading())
+		for (size_t i = 0; i < adc_trace->num_available(); ++i)
+			samples.push_back((*adc_trace)[i]);
+	ar.sequence(samples);
+	if (ar.loading()) {
+		if (!has_adc) {
+			// the run of the ADC samples was already finished
+			adc_trace = NULL;
+		} else if (!adc_trace) {
+			LOG4CXX_ERROR(logger, name() << ": checkpoint(): checkpoint contains ADC samples, but no ADC is attached" );
+			throw std::runtime_error("CompoundNeuronModule::checkpoint(): no ADC attached");
+		} else {
+			while (!adc_trace->empty())
+				adc_trace->pop();
+			for (auto sample : samples)
+				adc_trace->insert(sample);
+		}
 	}
 }
 
-void CompoundNeuronModule::release_spike()
+void CompoundNeuronModule::spike_out()
 {
-    LOG4CXX_TRACE(logger, name() << ": release_spike():" << sc_time_stamp() <<"\t Neuron_ID : " << logical_neuron <<  " with addr " << addr );
-	(*anc)->handle_spike(logical_neuron, addr, wta);
-	if ( release_spike_buffer.empty()) {
-		rel_spike_lock = false;
-	} else {
-		sc_time delta_rel_time = release_spike_buffer.front() - sc_time_stamp();
-		release_spike_buffer.pop();
-		rel_spike.notify( delta_rel_time );
-	}
+    LOG4CXX_TRACE(logger, name() << ": spike_out(ADEX): t = " << sc_time_stamp() <<  "\tNeuron_ID : " << logical_neuron <<  " with addr " << addr );
+	release_scheduler->schedule(logical_neuron, addr, wta);
 }
 
 void CompoundNeuronModule::record()
 {
-	const double CurrentTime = sc_time_stamp().to_seconds();
-	if (rec_voltage &&  CurrentTime > mLastRecordTime) {
+	const double CurrentTime = ess::model_seconds();
+	if ((rec_voltage || adc_trace) &&  CurrentTime > mLastRecordTime) {
 		tick();
 		CompoundNeuronState const & state =  mCompoundNeuron.mState;
-		voltage_file << mLastTime << "\t" << state.V << "\t" << state.denmems[0].w
-			<< "\t" << state.denmems[0].g_syn[0] << "\t" << state.denmems[0].g_syn[1] << "\n" << std::flush;
+		if(rec_voltage)
+			voltage_trace.sample(mLastTime - mTimeOrigin, state.V, state.denmems[0].w,
+					state.denmems[0].g_syn[0], state.denmems[0].g_syn[1]);
+		// samples beyond the requested count are dropped
+		if(adc_trace)
+			adc_trace->insert(ESS::voltage_to_adc(state.V));
 		trigger_record.notify(recording_interval, SC_SEC);
 		mLastRecordTime = CurrentTime;
 	}
@@ -128,9 +189,12 @@ void CompoundNeuronModule::record()
 void CompoundNeuronModule::end_of_simulation()
 {
     LOG4CXX_DEBUG(logger, "CompoundNeuronModule::end_of_simulation_called()!" );
-	// If recording, run recording up to the end of simulation
+	// If recording, run recording up to the end of simulation.
+	// The file is closed, so that the last partial chunk is handed over to the
+	// async_writer before Stage2VirtualHardware::run() waits for the output files.
 	if(rec_voltage){
 		record();
+		voltage_trace.close();
 	}
 }
 
@@ -1,19 +1,24 @@
 #pragma once
 
 #include "systemc.h"
-#include "anncore_pulse_if.h"
-#include <queue>
+#include "SpikeReleaseScheduler.h"
 #include "CompoundNeuron.h"
+#include "VoltageTrace.h"
+#include "timed_event.h"
 
 /** module for the simulation of a compound neuron.
  * simulates a compound neuron, takes care about voltage recording and
- * propagates spikes to the attached priority encoder.
- * The neuron dynamics are updated every 1 nano second.
+ * propagates spikes to the release scheduler of the anncore.
+ * The neuron dynamics are updated every `tick_period_ns` nano seconds.
  */
 class CompoundNeuronModule : public sc_module
 {
 public:
-	CompoundNeuronModule(sc_module_name name, size_t N, unsigned int log_neuron, unsigned int wta, sc_port<anncore_pulse_if> *a);
+	/// update period of the neuron dynamics in ns.
+	/// A neuron can fire at most once per period.
+	static const unsigned int tick_period_ns = 5;
+
+	CompoundNeuronModule(sc_module_name name, size_t N, unsigned int log_neuron, unsigned int wta, SpikeReleaseScheduler *s);
 	virtual ~CompoundNeuronModule();
 	void tick();
 
@@ -22,21 +27,45 @@ public:
 	 * @param rec flag whether voltage shall be recorded
 	 * @param fn filename for voltage recording
 	 * @param dt voltage recording sampling interval in ms
+	 * @param trace_cfg format, decimation and tolerance of the voltage recording
+	 * */
+	void init(unsigned int _addr, bool rec, std::string fn, double dt,
+			ESS::voltage_trace_config const& trace_cfg = ESS::voltage_trace_config());
+
+	/** attach the in-memory sample buffer of a virtual ADC.
+	 * The membrane voltage is captured every recording interval until the buffer is full.
+	 * Must be called before init() to capture the sample at time 0.
 	 * */
-	void init(unsigned int _addr, bool rec, std::string fn, double dt);
+	void setADCTrace(ess::ring_buffer<uint16_t>* trace);
 
 	/// set firing denmem.
 	/// Note: this is the id within this compound neuron, not the absolut denmem id
 	void setFiringDenmem(size_t id);
 
+	/** completes the voltage recording of a run, which is not ended by sc_stop().
+	 * The last sample is recorded and the trace file is closed.*/
+	void finish_run();
+
+	/** resets the neuron for a new run starting at `origin`.
+	 * The state variables are initialized as in init(), the voltage recording
+	 * is restarted, with times relative to `origin`. The parameters set via
+	 * the DenmemIFs are kept.*/
+	void reset(sc_time const& origin);
+
+	/** stores or restores the state variables, the recording state and the ADC samples.
+	 * When restoring, the voltage recording file is reopened and contains the samples
+	 * from the checkpoint on.*/
+	void checkpoint(ess::state_archive& ar);
+
 	unsigned int get_wta_id() const;
 	unsigned int get_6_bit_address() const;
 
 private:
-	double mLastTime; ///< time of last update
-	sc_clock mClock; //!< systemc clock
+	double mLastTime; ///< model time of last update (see ess::model_seconds())
+	double mTimeOrigin; ///< model time of the start of the current run, recorded times are relative to this
+	sc_light_clock mClock; //!< systemc clock
 
-	sc_event trigger_record; //!< triggers function `record()`
+	ess::timed_event trigger_record; //!< triggers function `record()`
 	double recording_interval; //!< recording interval in seconds.
 	double mLastRecordTime; ///< time of last voltage recording
 
@@ -48,22 +77,18 @@ private:
 	unsigned int logical_neuron;///< id of the denmem that fires. This is different from the "local" firing denmem set via setFiringDenmem()
 	unsigned int addr;	        ///< 6-bit addr of this nrn: this is forwarded to l1-bus and dnc
 	unsigned int wta;	        ///< ID of Priority Encoder(WTA) this nrn is connected to: 0..7
-	std::ofstream voltage_file; ///< outstream to voltage recording file
+	ESS::VoltageTraceWriter voltage_trace; ///< writer of the voltage recording file
+	std::string voltage_trace_file; ///< filename of the voltage recording
+	ESS::voltage_trace_config voltage_trace_cfg; ///< format of the voltage recording
 	bool rec_voltage;	        ///< Flag for voltage recording: True = record membrane voltage to file
+	ess::ring_buffer<uint16_t>* adc_trace; ///< ADC samples captured in memory, NULL if neuron is not read out by an ADC
 
-	/** this is the target where the anncore delivers its output spikes.*/
-	sc_port<anncore_pulse_if> *anc;
-
-	sc_event rel_spike; ///< triggers release_spike()
-	bool rel_spike_lock;
-	std::queue< sc_time > release_spike_buffer; // buffer to store events that have to be release after L1_DELAY_REP_TO_DENMEMbut there is already another event scheduled before.
+	/** delays output spikes by L1_DELAY_REP_TO_DENMEM and delivers them to the priority encoder.*/
+	SpikeReleaseScheduler *release_scheduler;
 
 	/** this function is called, when neuron spikes, V is reset after outgoing spike. */
 	void spike_out();
 
-	/** this function is called, when  a spike is released */
-	void release_spike();
-
 	/** records voltage, adaptation current and synaptic conductances.
 	 * Is triggered by `trigger_record` every `recording_interval`*/
 	void record();
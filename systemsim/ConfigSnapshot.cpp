@@ -0,0 +1,331 @@
+#include "ConfigSnapshot.h"
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include <log4cxx/logger.h>
+
+#include "mapped_file.h"
+
+static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("ESS.HALAccess");
+
+namespace ESS {
+
+namespace {
+
+/// appends values in little-endian byte order
+struct snapshot_writer
+{
+	static const bool loading = false;
+	std::vector<unsigned char> buffer;
+
+	template<class T>
+	void value(T& v)
+	{
+		uint64_t u = 0;
+		std::memcpy(&u, &v, sizeof(T));
+		for (size_t i = 0; i < sizeof(T); ++i)
+			buffer.push_back((u >> (8*i)) & 0xff);
+	}
+};
+
+/// reads values in little-endian byte order from a memory range
+struct snapshot_reader
+{
+	static const bool loading = true;
+	const unsigned char* pos;
+	const unsigned char* end;
+
+	template<class T>
+	void value(T& v)
+	{
+		if (size_t(end - pos) < sizeof(T))
+			throw std::runtime_error("config_snapshot: unexpected end of file");
+		uint64_t u = 0;
+		for (size_t i = 0; i < sizeof(T); ++i)
+			u |= uint64_t(pos[i]) << (8*i);
+		std::memcpy(&v, &u, sizeof(T));
+		pos += sizeof(T);
+	}
+};
+
+// The same io() functions are used for writing and reading, so that both can not diverge.
+
+template<class Archive, class T>
+typename std::enable_if<std::is_arithmetic<T>::value>::type io(Archive& ar, T& v);
+template<class Archive, class T>
+typename std::enable_if<std::is_enum<T>::value>::type io(Archive& ar, T& v);
+template<class Archive, class T> void io(Archive& ar, std::vector<T>& v);
+template<class Archive> void io(Archive& ar, std::vector<bool>& v);
+template<class Archive, class T, size_t N> void io(Archive& ar, std::array<T,N>& a);
+template<class Archive, class K, class V> void io(Archive& ar, std::map<K,V>& m);
+template<class Archive, size_t N> void io(Archive& ar, std::bitset<N>& b);
+
+template<class Archive> void io(Archive& ar, Synapse_t& s);
+template<class Archive> void io(Archive& ar, syndr_row& r);
+template<class Archive> void io(Archive& ar, syndriver_cfg& c);
+template<class Archive> void io(Archive& ar, SyndriverParameterHW& p);
+template<class Archive> void io(Archive& ar, SyndriverParameterESS& p);
+template<class Archive> void io(Archive& ar, SyndriverBlock& b);
+template<class Archive> void io(Archive& ar, StimulusContainer& s);
+template<class Archive> void io(Archive& ar, nquad_connections& c);
+template<class Archive> void io(Archive& ar, RepeaterBlock& r);
+template<class Archive> void io(Archive& ar, neuron& n);
+template<class Archive> void io(Archive& ar, BioParameter& p);
+template<class Archive> void io(Archive& ar, adc_config& c);
+
+/// calls io() for all arguments in order
+template<class Archive, class... T>
+void fields(Archive& ar, T&... t)
+{
+	int expand[] = {0, (io(ar, t), 0)...};
+	static_cast<void>(expand);
+}
+
+template<class Archive, class T>
+typename std::enable_if<std::is_arithmetic<T>::value>::type io(Archive& ar, T& v)
+{
+	ar.value(v);
+}
+
+template<class Archive, class T>
+typename std::enable_if<std::is_enum<T>::value>::type io(Archive& ar, T& v)
+{
+	uint32_t u = v;
+	ar.value(u);
+	v = static_cast<T>(u);
+}
+
+template<class Archive, class T>
+void io(Archive& ar, std::vector<T>& v)
+{
+	uint64_t n = v.size();
+	ar.value(n);
+	if (Archive::loading)
+		v.resize(n);
+	for (auto& e : v)
+		io(ar, e);
+}
+
+template<class Archive>
+void io(Archive& ar, std::vector<bool>& v)
+{
+	uint64_t n = v.size();
+	ar.value(n);
+	if (Archive::loading)
+		v.resize(n);
+	for (size_t i = 0; i < n; ++i) {
+		bool b = v[i];
+		ar.value(b);
+		v[i] = b;
+	}
+}
+
+template<class Archive, class T, size_t N>
+void io(Archive& ar, std::array<T,N>& a)
+{
+	for (auto& e : a)
+		io(ar, e);
+}
+
+template<class Archive, class K, class V>
+void io(Archive& ar, std::map<K,V>& m)
+{
+	uint64_t n = m.size();
+	ar.value(n);
+	if (Archive::loading) {
+		m.clear();
+		for (uint64_t i = 0; i < n; ++i) {
+			K k;
+			io(ar, k);
+			io(ar, m[k]);
+		}
+	} else {
+		for (auto& kv : m) {
+			K k = kv.first;
+			io(ar, k);
+			io(ar, kv.second);
+		}
+	}
+}
+
+template<class Archive, size_t N>
+void io(Archive& ar, std::bitset<N>& b)
+{
+	static_assert(N <= 64, "bitset too large");
+	uint64_t u = b.to_ullong();
+	ar.value(u);
+	b = std::bitset<N>(u);
+}
+
+template<class Archive>
+void io(Archive& ar, Synapse_t& s)
+{
+	fields(ar, s.address, s.weight);
+}
+
+template<class Archive>
+void io(Archive& ar, syndr_row& r)
+{
+	fields(ar, r.senx, r.seni, r.preout_even, r.preout_odd, r.sel_Vgmax, r.gmax_div_x, r.gmax_div_i);
+}
+
+template<class Archive>
+void io(Archive& ar, syndriver_cfg& c)
+{
+	fields(ar, c.enable, c.mirror, c.locin, c.stp_enable, c.stp_mode, c.stp_cap, c.bottom_row_cfg, c.top_row_cfg);
+}
+
+template<class Archive>
+void io(Archive& ar, SyndriverParameterHW& p)
+{
+	fields(ar, p.V_stdf, p.V_dep, p.V_fac, p.V_dtc);
+}
+
+template<class Archive>
+void io(Archive& ar, SyndriverParameterESS& p)
+{
+	fields(ar, p.g_trafo_up, p.g_trafo_down, p.tau_rec, p.lambda, p.N_dep, p.N_fac);
+}
+
+template<class Archive>
+void io(Archive& ar, SyndriverBlock& b)
+{
+	fields(ar, b.syndriver, b.synapse_params_hw);
+}
+
+template<class Archive>
+void io(Archive& ar, StimulusContainer& s)
+{
+	fields(ar, s.Currents, s.PulseLength, s.Continuous);
+}
+
+template<class Archive>
+void io(Archive& ar, nquad_connections& c)
+{
+	fields(ar, c.hori, c.vert);
+}
+
+template<class Archive>
+void io(Archive& ar, RepeaterBlock& r)
+{
+	fields(ar, r.repeater);
+}
+
+template<class Archive>
+void io(Archive& ar, neuron& n)
+{
+	// neuron_parameters are not stored, their translation is part of translated_hicann
+	fields(ar, n.activate_firing, n.enable_fire_input, n.enable_curr_input, n.enable_output,
+			n.enable_spl1_output, n.l1_address, n.neuron_address, n.is_connected, n.V_reset, n.cap);
+}
+
+template<class Archive>
+void io(Archive& ar, BioParameter& p)
+{
+	fields(ar, p.a, p.b, p.cm, p.delta_T, p.e_rev_E, p.e_rev_I, p.i_offset, p.tau_m, p.tau_refrac,
+			p.tau_syn_E, p.tau_syn_I, p.tau_w, p.v_reset, p.v_rest, p.v_spike, p.v_thresh, p.g_l);
+}
+
+template<class Archive>
+void io(Archive& ar, adc_config& c)
+{
+	fields(ar, c.enable, c.num_samples, c.input);
+}
+
+template<class Archive>
+void io_global(Archive& ar, global_parameter& p)
+{
+	fields(ar, p.speedup, p.timestep, p.enable_weight_distortion, p.weight_distortion,
+			p.enable_timed_merger, p.enable_spike_debugging,
+			p.voltage_trace.binary, p.voltage_trace.decimation, p.voltage_trace.tolerance);
+}
+
+template<class Archive>
+void io_hicann(Archive& ar, hicann& h, translated_hicann& t)
+{
+	fields(ar, h.available, h.mX, h.mY, h.PLL_freq, h.neurons_on_hicann, h.merger_tree_config,
+			h.repeater_config, h.crossbar_config, h.synswitch_config, h.syn_array, h.syndriver_config,
+			h.dnc_link_enable, h.dnc_link_directions, h.stimulus_config, h.connection_config,
+			h.denmem2nrn);
+	fields(ar, t.num_neurons, t.syndriver_params, t.denmem_params);
+}
+
+} // anonymous namespace
+
+const char config_snapshot::magic[4] = {'E', 'S', 'S', 'C'};
+const uint32_t config_snapshot::version;
+
+void config_snapshot::save(
+		std::string const& fn,
+		wafer const& waf,
+		global_parameter const& params,
+		translated_wafer const& translated)
+{
+	snapshot_writer ar;
+	ar.buffer.insert(ar.buffer.end(), magic, magic + 4);
+	uint32_t v = version;
+	uint32_t num_hicanns = translated.size();
+	fields(ar, v, num_hicanns);
+	// the writer only reads from its arguments
+	io_global(ar, const_cast<global_parameter&>(params));
+	io(ar, const_cast<wafer&>(waf).adcs);
+
+	for (auto const& entry : translated) {
+		uint32_t hic_id = entry.first;
+		io(ar, hic_id);
+		io_hicann(ar, const_cast<hicann&>(waf.hicanns.at(hic_id)), const_cast<translated_hicann&>(entry.second));
+	}
+
+	FILE* f = fopen(fn.c_str(), "wb");
+	if (!f || fwrite(&ar.buffer[0], 1, ar.buffer.size(), f) != ar.buffer.size()) {
+		if (f)
+			fclose(f);
+		LOG4CXX_ERROR(logger, "config_snapshot::save(): could not write file: " << fn );
+		throw std::runtime_error("config_snapshot::save(): could not write file " + fn);
+	}
+	fclose(f);
+	LOG4CXX_INFO(logger, "Saved configuration snapshot of " << num_hicanns << " HICANNs to " << fn
+			<< " (" << ar.buffer.size() << " bytes)" );
+}
+
+void config_snapshot::load(
+		std::string const& fn,
+		wafer& waf,
+		global_parameter& params,
+		translated_wafer& translated)
+{
+	ess::mapped_file file(fn);
+	if (!file.data || file.size < 4 || std::memcmp(file.data, magic, 4) != 0) {
+		LOG4CXX_ERROR(logger, "config_snapshot::load(): no configuration snapshot: " << fn );
+		throw std::runtime_error("config_snapshot::load(): no configuration snapshot " + fn);
+	}
+
+	snapshot_reader ar;
+	ar.pos = file.data + 4;
+	ar.end = file.data + file.size;
+	uint32_t v = 0;
+	uint32_t num_hicanns = 0;
+	fields(ar, v, num_hicanns);
+	if (v != version) {
+		LOG4CXX_ERROR(logger, "config_snapshot::load(): unsupported version " << v << " of snapshot " << fn );
+		throw std::runtime_error("config_snapshot::load(): unsupported snapshot version");
+	}
+	io_global(ar, params);
+	io(ar, waf.adcs);
+
+	for (uint32_t i = 0; i < num_hicanns; ++i) {
+		uint32_t hic_id = 0;
+		io(ar, hic_id);
+		if (hic_id >= waf.hicanns.size())
+			throw std::runtime_error("config_snapshot::load(): invalid HICANN id");
+		hicann& h = waf.hicanns[hic_id];
+		h.hicann_id = hic_id;
+		io_hicann(ar, h, translated[hic_id]);
+	}
+	LOG4CXX_INFO(logger, "Loaded configuration snapshot of " << num_hicanns << " HICANNs from " << fn );
+}
+
+} // end namespace ESS
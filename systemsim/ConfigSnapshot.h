@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <map>
+#include <stdint.h>
+#include <string>
+
+#include "HAL2ESSContainer.h"
+
+namespace ESS {
+
+/// configuration of one HICANN after the translation done by HALaccess,
+/// i.e. calibration, parameter transformations and Denmem2Neuron.
+struct translated_hicann
+{
+	/// synapse drivers with parameters: 4 quadrants of 56 drivers
+	static const size_t num_syndrivers = 224;
+
+	/// index into syndriver_params, same arguments as HALaccess::getSyndriverParameters
+	static size_t syndriver_index(HICANNBlock block, HICANNSide side, unsigned int driver_in_quadrant)
+	{
+		return (2*side + block)*(num_syndrivers/4) + driver_in_quadrant;
+	}
+
+	unsigned int num_neurons; //!< number of logical neurons built on this HICANN
+	std::array<SyndriverParameterESS, num_syndrivers> syndriver_params;
+	std::map<unsigned int, BioParameter> denmem_params; //!< parameters of all denmems belonging to a logical neuron
+
+	translated_hicann() : num_neurons(0) {}
+};
+
+typedef std::map<unsigned int, translated_hicann> translated_wafer; //!< key: HICANN id
+
+/** Versioned binary snapshot of the wafer configuration (values little-endian).
+ *
+ *  header:
+ *    char[4]  magic "ESSC"
+ *    uint32   version
+ *    uint32   number of HICANNs
+ *  global parameters and ADC configuration
+ *  per available HICANN:
+ *    uint32   HICANN id
+ *    the HAL2ESS container data read during elaboration
+ *    the translated configuration (translated_hicann)
+ *
+ *  The floating gate values of the denmems are not stored, as their
+ *  translation is part of the snapshot.
+ */
+struct config_snapshot
+{
+	static const char     magic[4];
+	static const uint32_t version = 1;
+
+	/// writes the snapshot, throws std::runtime_error on failure.
+	/// Only HICANNs with a translated configuration are stored.
+	static void save(
+			std::string const& fn,
+			wafer const& waf,
+			global_parameter const& params,
+			translated_wafer const& translated);
+
+	/// reads a snapshot. The stored HICANNs are replaced in waf, other HICANNs are kept.
+	/// throws std::runtime_error if the file can not be read or has a different version.
+	static void load(
+			std::string const& fn,
+			wafer& waf,
+			global_parameter& params,
+			translated_wafer& translated);
+};
+
+} // end namespace ESS
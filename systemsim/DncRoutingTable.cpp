@@ -0,0 +1,39 @@
+#include "DncRoutingTable.h"
+
+#include "state_archive.h"
+
+const unsigned DncRoutingTable::address_width;
+const size_t DncRoutingTable::size;
+
+DncRoutingTable::DncRoutingTable()
+	: _directions(0)
+{
+	for (size_t l = 0; l < size; ++l) {
+		_routes[l].delay = 0;
+		_routes[l].channel = l >> address_width;
+		_routes[l].to_hicann = false;
+	}
+}
+
+void DncRoutingTable::set_delay(unsigned int channel, unsigned int address, uint32_t delay)
+{
+	_routes[label(channel, address)].delay = delay & ((1 << TIMESTAMP_WIDTH) - 1);
+}
+
+void DncRoutingTable::set_directions(uint64_t directions)
+{
+	_directions = directions;
+	// the direction is set per dnc if channel, i.e. for the labels with the same upper 6 bit
+	for (size_t l = 0; l < size; ++l)
+		_routes[l].to_hicann = (directions >> (l >> L1_ADDR_WIDTH)) & 0x1;
+}
+
+void DncRoutingTable::checkpoint(ess::state_archive& ar)
+{
+	for (auto& r : _routes)
+		ar.value(r.delay);
+	uint64_t directions = _directions;
+	ar.value(directions);
+	if (ar.loading())
+		set_directions(directions);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdint.h>
+
+#include "sim_def.h"
+#include "l2_event.h"
+
+namespace ess { class state_archive; }
+
+/** routing memory of a DNC.
+ * Events between the HICANNs and the FPGA are identified by a 12 bit label, consisting of the
+ * HICANN channel (3 bit) and the address on the channel (9 bit). The upper 3 bit of the
+ * address select the dnc if channel (L1 bus) on the HICANN, the lower L1_ADDR_WIDTH bit the neuron.
+ *
+ * For each label, the table holds a record with everything needed to translate its events,
+ * so that the translation is a single lookup with the label of the event as index.
+ */
+class DncRoutingTable
+{
+public:
+	static const unsigned address_width = ess::l2_event::address_width; ///< bits of the address on a HICANN channel
+	static const size_t size = DNC_TO_ANC_COUNT << address_width; ///< number of labels
+
+	struct route
+	{
+		uint16_t delay;    ///< added to the time stamp of events to the FPGA
+		uint8_t channel;   ///< HICANN channel
+		bool to_hicann;    ///< direction of the dnc if channel, false: from the HICANN to the FPGA
+	};
+
+	/// all delays 0, all directions to the FPGA
+	DncRoutingTable();
+
+	static size_t label(unsigned int channel, unsigned int address)
+	{
+		return (channel << address_width) | address;
+	}
+
+	route const& operator[](size_t label) const { return _routes[label]; }
+
+	/// sets the delay of events from the HICANN, only the lower TIMESTAMP_WIDTH bit are used.
+	void set_delay(unsigned int channel, unsigned int address, uint32_t delay);
+
+	/// sets the directions of all dnc if channels: bit 8*channel + L1 bus is 1 for the direction to the HICANN.
+	void set_directions(uint64_t directions);
+	uint64_t directions() const { return _directions; }
+
+	/// translates an event received from a HICANN to an event to the FPGA.
+	/// Returns false, if the dnc if channel of the event is configured to send to the HICANN.
+	bool from_hicann(unsigned int channel, ess::l2_event event, ess::l2_event& fpga_event) const
+	{
+		const size_t l = label(channel, event.address());
+		route const& r = _routes[l];
+		fpga_event = ess::l2_event::make(l, event.time() + r.delay);
+		return !r.to_hicann;
+	}
+
+	/// translates an event received from the FPGA to an event to the HICANN channel.
+	/// Returns false, if the dnc if channel of the event is configured to send to the FPGA.
+	bool from_fpga(ess::l2_event fpga_event, unsigned int& channel, ess::l2_event& event) const
+	{
+		route const& r = _routes[fpga_event.label()];
+		channel = r.channel;
+		event = fpga_event.without_channel();
+		return r.to_hicann;
+	}
+
+	/// stores or restores delays and directions
+	void checkpoint(ess::state_archive& ar);
+
+private:
+	std::array<route, size> _routes;
+	uint64_t _directions;
+};
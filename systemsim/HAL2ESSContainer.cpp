@@ -240,24 +240,6 @@ hicann::hicann(const unsigned int id)
     std::map<size_t,size_t> denmem2nrn; 
 }
 
-hicann& hicann::operator=(hicann const& rhs)
-{
-	this->available = rhs.available;
-	this->hicann_id = rhs.hicann_id;
-	this->neurons_on_hicann = rhs.neurons_on_hicann;
-	this->mX = rhs.mX;
-	this->mY = rhs.mY;
-	this->PLL_freq = rhs.PLL_freq;
-    this->repeater_config = rhs.repeater_config;
-	this->crossbar_config = rhs.crossbar_config;
-	this->syn_array = rhs.syn_array;
-	this->syndriver_config = rhs.syndriver_config;
-	this->dnc_link_enable = rhs.dnc_link_enable;
-	this->dnc_link_directions = rhs.dnc_link_directions;
-    this->stimulus_config = rhs.stimulus_config;
-    return *this;
-}
-
 std::bitset<4> hicann::get_syn_weight(const size_t &row, const size_t &col)
 {
 	std::bitset<4> returnval;
@@ -324,14 +306,9 @@ const unsigned int wafer::num_dncs;     		// number of dncs on wafer == number o
 wafer::wafer()
 {
     //initialize the hicanns
-	hicann hica{1};
-	std::vector<hicann> init(size::hicanns_on_wafer, hica);
+	hicanns.reserve(size::hicanns_on_wafer);
 	for(unsigned int id = 0; id < size::hicanns_on_wafer; id++)
-	{
-		hicann hic{id};
-		init[id] = hic;
-	}
-	this->hicanns = init;
+		hicanns.emplace_back(id);
 }
 
 //functions for global_parameter
@@ -343,7 +320,8 @@ global_parameter::global_parameter() :
     enable_weight_distortion(false),
     weight_distortion(0.),
     enable_timed_merger(true),
-    enable_spike_debugging(false)
+    enable_spike_debugging(false),
+    voltage_trace()
 {}
 
 } //end namespace ESS
@@ -3,8 +3,11 @@
 #include <bitset>
 #include <map>
 #include <array>
+#include <string>
 
 #include "HAL2ESSEnum.h"
+#include "VoltageTrace.h"
+#include "ring_buffer.h"
 #include "hal/FPGAContainer.h"
 
 #include "calibtic/HMF/HWNeuronParameter.h"
@@ -168,12 +171,17 @@ typedef std::vector<std::vector<bool> > crossbar_type;
 
 typedef std::vector<std::vector<bool> > synswitch_type;
 
+/// configuration of one HICANN. It is large (synapse array, denmems), hence it can not be
+/// copied by accident: it is moved, explicit copies are made with clone().
 struct hicann
 {
 //functions
 	hicann(const unsigned int id);
+	hicann(hicann&&) = default;
+	hicann& operator=(hicann&&) = default;
+	hicann& operator=(hicann const&) = delete;
+	hicann clone() const { return hicann(*this); }
 	void reset(); //resets the hicann, not implemented yet
-	hicann& operator=(hicann const& rhs);
 	std::bitset<4> get_syn_weight(const size_t &row, const size_t &col);
 	void set_syn_weight(const std::bitset<4> &weight, const size_t &row, const size_t &col);
 	std::bitset<4> get_syn_address(const size_t &row, const size_t &col);
@@ -196,6 +204,8 @@ struct hicann
 	std::array<StimulusContainer, 4> stimulus_config;
     std::array<nquad_connections, 128> connection_config;
     std::map<size_t,size_t> denmem2nrn; 
+private:
+	hicann(hicann const&) = default;
 };
 
 struct adc_config
@@ -207,10 +217,19 @@ struct adc_config
     {}
 };
 
+/// samples captured in memory by a virtual ADC during simulation.
+/// Capacity is the requested number of samples, later samples are dropped.
+typedef ess::ring_buffer<uint16_t> adc_trace;
+
+/// configuration of the wafer, move-only like hicann
 struct wafer
 {
 //functions
 	wafer();
+	wafer(wafer&&) = default;
+	wafer& operator=(wafer&&) = default;
+	wafer(wafer const&) = delete;
+	wafer& operator=(wafer const&) = delete;
 //data
 	std::vector<hicann> hicanns;			// stores the hicanns
 	//for initalize_pcb, TODO make settable -> mapping ?!
@@ -233,6 +252,7 @@ struct global_parameter
     double  weight_distortion; 
     bool    enable_timed_merger;
     bool    enable_spike_debugging;
+    voltage_trace_config voltage_trace; //format, decimation and tolerance of membrane voltage recordings
 };
 
 /// Data structure for one entry in the FPGA playback memory
@@ -255,7 +275,7 @@ struct playback_entry
 /// Data structure for one entry in the FPGA trace memory
 struct trace_entry
 {
-	typedef uint32_t fpga_time_t; // 32-bit: -> max representable time is (2^32-1)*8e-9 = 34 s, which should be sufficient for ESS sims.
+	typedef uint64_t fpga_time_t; // 64-bit, as 32 bit limit the recorded time to (2^32-1)*8e-9 = 34 s
 	typedef HMF::FPGA::PulseEvent event_t;
 
 	fpga_time_t fpga_time; //!< time when pulse was recorded to trace memory in fpga clk cycles (=8ns).
@@ -274,9 +294,11 @@ typedef std::vector<trace_entry> trace_container_t;
 
 struct fpga_config
 {
-	fpga_config():record(false){}
+	fpga_config():record(false),trace_memory_budget(0){}
 	bool record;
 	playback_container_t playback_pulses;
+	size_t trace_memory_budget; //!< bytes of memory for recorded pulses, 0: unlimited
+	std::string trace_spill_file; //!< file for recorded pulses exceeding the budget, empty: keep them in memory
 };
 
 struct dnc_config
@@ -284,5 +306,14 @@ struct dnc_config
 	std::bitset<64> hicann_directions;
 };
 
+//parts of the configuration, which are applied again when an elaborated system is reconfigured between two runs
+struct config_delta
+{
+	config_delta():synapses(false),neuron_parameters(false),playback(false){}
+	bool synapses;          //weights and addresses of the synapse arrays
+	bool neuron_parameters; //parameters of the denmems building the existing neurons
+	bool playback;          //playback pulses of the FPGAs
+};
+
 
 }//end namespace ess
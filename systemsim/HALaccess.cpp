@@ -2,11 +2,15 @@
 #include <algorithm>
 #include <fstream>
 #include <stdexcept>
+#include <atomic>
+#include <exception>
+#include <thread>
 
 #include <boost/filesystem.hpp>
 #include <boost/pointer_cast.hpp>
 
 #include "HALaccess.h"
+#include "VoltageTrace.h"
 #include "hal/Coordinate/HMFGrid.h"
 #include "hal/Coordinate/HMFGeometry.h"
 #include "hal/Coordinate/iter_all.h"
@@ -56,6 +60,21 @@ bool is_active(ESS::neuron const& denmem)
 	return denmem.activate_firing && denmem.enable_spl1_output;
 }
 
+// returns true if a repeater is not off, the config byte is decoded as by
+// l1_behav_V2::determine_direction() and l1_behav_V2::determine_direction_spl1().
+bool is_repeater_enabled(ESS::RepeaterLocation location, size_t rep_id, unsigned char config)
+{
+	const bool recen = (config >> 7) & 1;
+	const bool dir = (config >> 6) & 1;
+	if (location != ESS::REP_L || rep_id % 4 > 0) // normal repeater
+		return recen;
+	// sending (spl1) repeater, recen and dir without tinen is unspecified and treated as off
+	const bool tinen = (config >> 4) & 1;
+	if (recen)
+		return tinen || !dir;
+	return dir;
+}
+
 } // anonymous namespace
 
 //functions of HALaccess
@@ -93,17 +112,50 @@ uint8_t HALaccess::getPLLFrequency(unsigned int hicann_id) const
     return wafer().hicanns[hicann_id].PLL_freq;
 }
 
+bool HALaccess::isHicannUsed(unsigned int hicann_id) const
+{
+	ESS::hicann const& hicann = wafer().hicanns[hicann_id];
+	for (auto const& denmem : hicann.neurons_on_hicann)
+		if (denmem.activate_firing || denmem.enable_output || denmem.enable_curr_input)
+			return true;
+	for (bool enable : hicann.dnc_link_enable)
+		if (enable)
+			return true;
+	for (size_t location = 0; location < hicann.repeater_config.size(); ++location) {
+		std::vector<unsigned char> const& block = hicann.repeater_config[location].repeater;
+		for (size_t rep_id = 0; rep_id < block.size(); ++rep_id)
+			if (is_repeater_enabled(static_cast<ESS::RepeaterLocation>(location), rep_id, block[rep_id]))
+				return true;
+	}
+	for (auto const& matrix : hicann.crossbar_config)
+		for (auto const& row : matrix)
+			if (std::find(row.begin(), row.end(), true) != row.end())
+				return true;
+	for (auto const& matrix : hicann.synswitch_config)
+		for (auto const& row : matrix)
+			if (std::find(row.begin(), row.end(), true) != row.end())
+				return true;
+	for (auto const& block : hicann.syndriver_config)
+		for (auto const& driver : block.syndriver)
+			if (driver.enable)
+				return true;
+	return false;
+}
+
 //this function returns the number of neurons mapped on this hicann 
 unsigned int HALaccess::getNeuronsOnHicann(unsigned int x_coord, unsigned int y_coord )
 {
 	size_t hic_id = to_id(x_coord, y_coord);
     LOG4CXX_DEBUG(logger, "Getting neurons of hicann " << hic_id);
+    //denmem2neuron configuration is part of the translated configuration
+    if (ESS::translated_hicann const* translated = getTranslated(hic_id))
+        return translated->num_neurons;
     //get denmem2neuron configuration
     Denmem2Neuron(hic_id);
     auto const & den2nrn = wafer().hicanns[hic_id].denmem2nrn;
     std::vector<size_t> nrns_on_hic;
     //find how many different logical neurons were mapped on this hicann
-    for(auto it : den2nrn)
+    for(auto const& it : den2nrn)
 	{
         size_t log_nrn = it.second;
         auto finder = std::find(nrns_on_hic.begin(),nrns_on_hic.end(),log_nrn);
@@ -129,7 +181,7 @@ ESS::global_parameter & HALaccess::getGlobalHWParameters()
 }
 
 //gets the synapse array from specified hicann
-std::vector<std::vector<ESS::Synapse_t> > HALaccess::getSynapses(unsigned int x_coord,unsigned int y_coord) const
+std::vector<std::vector<ESS::Synapse_t> > const& HALaccess::getSynapses(unsigned int x_coord,unsigned int y_coord) const
 {
 	size_t hic_id = to_id(x_coord, y_coord);
 	return wafer().hicanns[hic_id].syn_array;
@@ -137,7 +189,7 @@ std::vector<std::vector<ESS::Synapse_t> > HALaccess::getSynapses(unsigned int x_
 
 
 //returns the syndriver configuration by passing the correspondig data structure of HAL2ESSContainer::hicann
-std::vector<ESS::syndriver_cfg> HALaccess::getSyndriverConfig(
+std::vector<ESS::syndriver_cfg> const& HALaccess::getSyndriverConfig(
 		unsigned int x_coord,
 		unsigned int y_coord,
 		enum ESS::HICANNSide side) const
@@ -155,8 +207,7 @@ std::vector<ESS::syndriver_cfg> HALaccess::getSyndriverConfig(
         addr = 1;
     }
 
-	std::vector<ESS::syndriver_cfg> returnval = wafer().hicanns[hic_id].syndriver_config[addr].syndriver;
-	return returnval;
+	return wafer().hicanns[hic_id].syndriver_config[addr].syndriver;
 }
 
 //returns the global parameters belonging to the Syndriver and Synapses of the Corresponding block
@@ -170,6 +221,9 @@ ESS::SyndriverParameterESS HALaccess::getSyndriverParameters(
 	using namespace HMF;
 
 	size_t hic_id = to_id(x_coord, y_coord);
+	if (ESS::translated_hicann const* translated = getTranslated(hic_id))
+		return translated->syndriver_params.at(
+			ESS::translated_hicann::syndriver_index(block, side, driver_in_quadrant));
 
 	size_t addr;
 	if (side == ESS::HICANNSide::S_LEFT) {
@@ -325,6 +379,11 @@ ESS::BioParameter HALaccess::getNeuronParametersSingleDenmem(
 	using namespace HMF::Coordinate;
 
 	size_t hic_id = to_id(x_coord, y_coord);
+	if (ESS::translated_hicann const* translated = getTranslated(hic_id)) {
+		auto it = translated->denmem_params.find(denmem);
+		if (it != translated->denmem_params.end())
+			return it->second;
+	}
 	const auto &neuron = wafer().hicanns[hic_id].neurons_on_hicann[denmem];
 
 	// reverse trafo:
@@ -425,7 +484,7 @@ bool HALaccess::getCurrentInput(unsigned int x_coord, unsigned int y_coord, unsi
     return wafer().hicanns[hic_id].neurons_on_hicann[denmem].enable_curr_input;
 }
     
-ESS::StimulusContainer HALaccess::getCurrentStimulus(
+ESS::StimulusContainer const& HALaccess::getCurrentStimulus(
             unsigned int x_coord,
             unsigned int y_coord,
             enum ESS::HICANNSide side,
@@ -465,16 +524,15 @@ void HALaccess::getDNCIFConfig(unsigned int x_coord, unsigned int y_coord, std::
 }
 
 //gets the config of the indicated repeaterblock from the corresponding data structure of HAL2ESS::Container
-std::vector<unsigned char> HALaccess::getRepeaterConfig(unsigned int x_coord, unsigned int y_coord, ESS::RepeaterLocation rep_block) const
+std::vector<unsigned char> const& HALaccess::getRepeaterConfig(unsigned int x_coord, unsigned int y_coord, ESS::RepeaterLocation rep_block) const
 {
 	size_t hic_id = to_id(x_coord, y_coord);
 
-	std::vector<unsigned char> returnval = wafer().hicanns[hic_id].repeater_config[rep_block].repeater;
-	return returnval;
+	return wafer().hicanns[hic_id].repeater_config[rep_block].repeater;
 }
 
 //gets the CrossbarSwitch config of the indicated side from the corresponding data structure of HAL2ESS::Container
-std::vector<std::vector<bool> > HALaccess::getCrossbarSwitchConfig(unsigned int x_coord, unsigned int y_coord, enum ESS::HICANNSide side) const
+ESS::crossbar_type const& HALaccess::getCrossbarSwitchConfig(unsigned int x_coord, unsigned int y_coord, enum ESS::HICANNSide side) const
 {
 	size_t hic_id = to_id(x_coord, y_coord);
 
@@ -484,12 +542,11 @@ std::vector<std::vector<bool> > HALaccess::getCrossbarSwitchConfig(unsigned int
 	else
 		s = 1;
 
-	std::vector<std::vector<bool> > returnval = wafer().hicanns[hic_id].crossbar_config[s];
-	return returnval;
+	return wafer().hicanns[hic_id].crossbar_config[s];
 }
 
 //gets the SyndriverSwitchConfig of the indicated location from the corresponding data structure of HAL2ESS::Container
-std::vector<std::vector<bool> > HALaccess::getSyndriverSwitchConfig(
+ESS::synswitch_type const& HALaccess::getSyndriverSwitchConfig(
 		unsigned int x_coord,
 		unsigned int y_coord,
 		enum ESS::HICANNBlock block,
@@ -514,17 +571,15 @@ std::vector<std::vector<bool> > HALaccess::getSyndriverSwitchConfig(
 			synbl = 2;
 	}
 
-	std::vector<std::vector<bool> > returnval = wafer().hicanns[hic_id].synswitch_config[synbl];
-	return returnval;
+	return wafer().hicanns[hic_id].synswitch_config[synbl];
 }
 
 //gets the MergerTreeConfig from the corresponding data-structure of HAL2ESSContainer::hicann
-std::vector<std::vector<bool> > HALaccess::getSPL1OutputMergerConfig(unsigned int x_coord, unsigned int y_coord) const
+std::vector<std::vector<bool> > const& HALaccess::getSPL1OutputMergerConfig(unsigned int x_coord, unsigned int y_coord) const
 {
 	size_t hic_id = to_id(x_coord, y_coord);
 
-	std::vector<std::vector<bool> > returnval = wafer().hicanns[hic_id].merger_tree_config;
-	return returnval;
+	return wafer().hicanns[hic_id].merger_tree_config;
 }
     
 //configure the ADC
@@ -532,6 +587,7 @@ void HALaccess::configADC(unsigned int adc_coord, uint32_t samples)
 {
     auto & config = wafer().adcs.at(adc_coord);
     config.num_samples = samples;
+    reset_adc_trace(adc_coord);
 }
     
 //prime the ADC
@@ -539,22 +595,23 @@ void HALaccess::primeADC(unsigned int adc_coord)
 {
     auto & config = wafer().adcs.at(adc_coord);
     config.enable = true;
+    reset_adc_trace(adc_coord);
 }
 
-std::vector<uint16_t> HALaccess::getADCTrace(unsigned int adc_coord) const
+//drops the samples of the last run and applies the sample count.
+//The buffer itself is kept, as it may still be attached to a neuron.
+void HALaccess::reset_adc_trace(unsigned int adc_coord)
+{
+    auto & trace = mADCTraces.at(adc_coord);
+    if (trace)
+        trace->resize(wafer().adcs.at(adc_coord).num_samples);
+}
+
+//determine the neurons with activated aout, which are read out by this ADC
+std::map<unsigned int,unsigned int> HALaccess::getADCInputNeurons(unsigned int adc_coord) const
 {
-    std::vector<uint16_t> returnval;
     using namespace HMF::Coordinate;
-    //chceck if this adc was primed
     const auto & config = wafer().adcs.at(adc_coord);
-    if(config.enable == false)
-    {
-        LOG4CXX_WARN(logger, "Trying to read out trace from ADC " << adc_coord << " which was not primed");
-        return std::vector<uint16_t>{};
-    }
-    //get the number of sample points
-    const uint32_t samples = config.num_samples;
-    //check if constellation of aout for neurons on this RETICLE ! is valid
     const unsigned int reticle = adc_coord / 2; // address of the reticle this ADC belongs to
     //determine which neurons (on quad) does this ADC read out
     NeuronOnQuad neuron_on_quad;
@@ -601,6 +658,49 @@ std::vector<uint16_t> HALaccess::getADCTrace(unsigned int adc_coord) const
             }
         }
     }
+    return record_neurons;
+}
+
+ESS::adc_trace* HALaccess::getADCTraceBuffer(unsigned int x_coord, unsigned int y_coord, unsigned int denmem)
+{
+    using namespace HMF::Coordinate;
+    const size_t hic_id = to_id(x_coord, y_coord);
+    const unsigned int reticle = HICANNOnWafer{Enum{hic_id}}.toDNCOnWafer().id().value();
+    //each reticle has 2 ADCs
+    for (unsigned int adc_coord = 2*reticle; adc_coord < 2*reticle + 2; ++adc_coord)
+    {
+        const auto & config = wafer().adcs.at(adc_coord);
+        if (config.enable == false || config.num_samples == 0)
+            continue;
+        const auto record_neurons = getADCInputNeurons(adc_coord);
+        const auto it = record_neurons.find(hic_id);
+        if (it != record_neurons.end() && it->second == denmem)
+        {
+            auto & trace = mADCTraces.at(adc_coord);
+            if (!trace)
+                trace.reset(new ESS::adc_trace(config.num_samples));
+            LOG4CXX_DEBUG(logger, "ADC " << adc_coord << " captures " << config.num_samples
+                    << " samples of neuron " << denmem << " on HICANN " << hic_id << " in memory");
+            return trace.get();
+        }
+    }
+    return nullptr;
+}
+
+std::vector<uint16_t> HALaccess::getADCTrace(unsigned int adc_coord) const
+{
+    std::vector<uint16_t> returnval;
+    //chceck if this adc was primed
+    const auto & config = wafer().adcs.at(adc_coord);
+    if(config.enable == false)
+    {
+        LOG4CXX_WARN(logger, "Trying to read out trace from ADC " << adc_coord << " which was not primed");
+        return std::vector<uint16_t>{};
+    }
+    //get the number of sample points
+    const uint32_t samples = config.num_samples;
+    //check if constellation of aout for neurons on this RETICLE ! is valid
+    const std::map<unsigned int,unsigned int> record_neurons = getADCInputNeurons(adc_coord);
     //make sure that exactly 1 neuron is recorded
     if (record_neurons.size() == 0)
     {
@@ -623,9 +723,22 @@ std::vector<uint16_t> HALaccess::getADCTrace(unsigned int adc_coord) const
     {
         const unsigned int hic_id = record_neurons.begin()->first;
         const unsigned int nrn_id = record_neurons.begin()->second;
-        LOG4CXX_DEBUG(logger, "Recording Trace of ADC " << adc_coord << " belonging to neuron " << nrn_id << " on HICANN " << hic_id);
-        //read in the trace
-        returnval = read_analog_trace(hic_id,nrn_id,samples);
+        ESS::adc_trace const* trace = mADCTraces.at(adc_coord).get();
+        if (trace && !trace->empty())
+        {
+            //samples were captured in memory during simulation
+            LOG4CXX_DEBUG(logger, "Reading Trace of ADC " << adc_coord << " belonging to neuron " << nrn_id << " on HICANN " << hic_id << " from memory");
+            const size_t num = std::min<size_t>(samples, trace->num_available());
+            returnval.reserve(num);
+            for (size_t i = 0; i < num; ++i)
+                returnval.push_back((*trace)[i]);
+        }
+        else
+        {
+            //ADC was primed after the neurons were built, fall back to the voltage file
+            LOG4CXX_DEBUG(logger, "Recording Trace of ADC " << adc_coord << " belonging to neuron " << nrn_id << " on HICANN " << hic_id);
+            returnval = read_analog_trace(hic_id,nrn_id,samples);
+        }
     }
     return returnval;
 }
@@ -655,240 +768,128 @@ std::vector<uint16_t> HALaccess::read_analog_trace(unsigned int hicann, unsigned
     //get the filepath
     std::string filepath = getVoltageFile(hicann_x,hicann_y,nrn);
     LOG4CXX_DEBUG(logger, "Recording Trace of Neuron " << nrn << " on hicann " << hicann << " from file " << filepath);
-    //initialize the filestream
-	std::ifstream read_in{filepath, std::ifstream::in};
-	
-    //define constants
-    //data format: the voltage value has a length of 12 characters
-	const size_t len = 12;
-	//the maximal voltage value is 1.8 V
-    const double v_max	= 1.8;
-    //the maximal value of uint16 is 2^16 - 1 = 65535
-	const uint16_t uint16_max = 65535;
-    
-	//read in sample lines
-    //skip the first line which contains the header
-	std::string _;
-	getline(read_in,_);
-	//read in
-    size_t i = 0;
-	while (i < samples && read_in.good())
+    //read the voltage samples, the file is mapped and not parsed line by line
+    const std::vector<double> voltages = ESS::read_voltage_trace(filepath, samples);
+
+    returnval.reserve(voltages.size());
+    for (size_t i = 0; i < voltages.size(); ++i)
 	{
-		std::string line;
-		getline(read_in,line);
-		//data format: the voltage value begins after the first tab and has a length of len = 12 character
-		size_t const tab_pos = line.find("\t");
-        std::string val_str;
-        try {
-            val_str = line.substr(tab_pos, tab_pos + len);
-        }
-        catch (...) {
-            LOG4CXX_WARN(logger, "While recording Trace of Neuron " << nrn << " on HICANN " 
-                    << hicann << " a blank line (number " << i << ") was read in, trying to read in  " 
-                    << samples << " lines. Recording of trace stopped.");
-            break;
-        }
-		//convert the string value (which corresponds to a floating point number) to a double
-		double val_double = std::stof(val_str);
-		//convert the double value to a uint16_t
-        uint16_t val_int = (val_double / v_max ) * uint16_max;
-        //clip the value
-        if (val_double < 0)
-        {
-            val_int = 0;
-            LOG4CXX_DEBUG(logger, "Recording Trace of Neuron" << nrn << " on HICANN " 
-                    << hicann << " value " << i << " = " << val_double << " clipped to " << 0 );
-        }
-        if (val_double > v_max)
-        {
-            val_int = uint16_max;
-            LOG4CXX_DEBUG(logger, "Recording Trace of Neuron" << nrn << " on HICANN " 
-                    << hicann << " value " << i << " = " << val_double << " clipped to " << uint16_max );
-        }
-		returnval.push_back(val_int);
-		i++;
+		returnval.push_back(ESS::voltage_to_adc(voltages[i]));
 	}
-	read_in.close();
+    if (returnval.size() < samples)
+    {
+        LOG4CXX_WARN(logger, "While recording Trace of Neuron " << nrn << " on HICANN " 
+                << hicann << " only " << returnval.size() << " of " << samples
+                << " samples were available. Recording of trace stopped.");
+    }
     return returnval;
 }
 
-//stuff for the graph used to recollect nrns from the denmem switch config
-//datastructure for the graph
-struct HALaccess::node {
-    node* vert_conn;        //pointer to the vertical node
-    node* hori_conn;
-    unsigned int denmem_id;
+//disjoint sets of the 512 denmems, used to recollect nrns from the denmem switch config
+struct HALaccess::denmem_sets {
+    std::array<uint16_t,512> parent;
+
+    denmem_sets()
+    {
+        for(size_t id = 0; id < parent.size(); id++)
+            parent[id] = id;
+    }
+
+    //representative of the set of den_id, which is the lowest denmem in the set
+    size_t find(size_t den_id)
+    {
+        while(parent[den_id] != den_id)
+        {
+            parent[den_id] = parent[parent[den_id]];
+            den_id = parent[den_id];
+        }
+        return den_id;
+    }
+
+    void join(size_t a, size_t b)
+    {
+        a = find(a);
+        b = find(b);
+        if(a < b)
+            parent[b] = a;
+        else if(b < a)
+            parent[a] = b;
+    }
 };
 
-//builds the graph of interconnected denmems 
-void HALaccess::build_graph(size_t hic_id, std::array<node,512> & nodes) const
+//joins the sets of all interconnected denmems
+void HALaccess::connect_denmems(size_t hic_id, denmem_sets & sets, std::array<bool,512> & connected) const
 {
 	const auto & Switches = wafer().hicanns[hic_id].connection_config;
 	const auto & Dends = wafer().hicanns[hic_id].neurons_on_hicann;
 
-    //build the graph
-    size_t offset = 256;
-    node* curr_top = &nodes[0];
-    node* curr_bot = &nodes[offset];
-    for(size_t i = 0; i < offset-1; ++i)
+    const size_t offset = 256;
+    auto join = [&sets, &connected](size_t a, size_t b)
+    {
+        sets.join(a,b);
+        connected[a] = true;
+        connected[b] = true;
+    };
+    //the horizontal connections never reach beyond denmem 255 (i%2==0 or i%32==31),
+    //so the loop covers the vertical switch of the last column as well
+    for(size_t i = 0; i < offset; ++i)
     {
-        node* next_top = &nodes[i+1];
-        node* next_bot = &nodes[offset+i+1];
         //set the horizontal connections inside the denmem quad
-        //these connections ar not directed so it is sufficient to check every second step if they are set
         if(i%2==0)
         {
             //upper switches
             if(Switches[i/2].hori[0] == true)
-            {
-                curr_top->hori_conn = next_top;
-            }
+                join(i, i+1);
             //lower switches
             if(Switches[i/2].hori[1] == true)
-            {
-                curr_bot->hori_conn = next_bot;
-            }
+                join(offset+i, offset+i+1);
         }
         //set the horizontal connections between denmem quads
         //these connections are directed, but this is neglected, because it does not matter in the ESS
         //make sure that there are no connections over neuron block boundaries (i%32 != 0, i%32 != 31)
         if(i%32 !=0 && i%32 != 31)
         {
-            //upper switches
-            if(Dends[i].enable_fire_input == true) 
+            for(size_t row : {size_t(0), offset})
             {
-                if(i%2==1)
-                {
-                    curr_top->hori_conn = next_top;
-                }
-                else if (i%2==0)
+                if(Dends[row+i].enable_fire_input == true)
                 {
+                    if(i%2==1)
+                    {
+                        join(row+i, row+i+1);
+                    }
                     //check for combinations of enable_fire_input that are not valid
-                    if(Dends[i-1].enable_fire_input == true)
+                    else if(Dends[row+i-1].enable_fire_input == true)
                     {
-                        LOG4CXX_ERROR(logger, "Getting nrns from denswitches on HICANN " << hic_id << " invalid combination: enable_fire_input = true on denmems: " << i-1 << " and " << i);
+                        LOG4CXX_ERROR(logger, "Getting nrns from denswitches on HICANN " << hic_id << " invalid combination: enable_fire_input = true on denmems: " << row+i-1 << " and " << row+i);
                         throw std::runtime_error("HALaccess: Getting nrns from denswitches : invalid combination: enable_fire_input = true ");
                     }
                     else
                     {
-                        nodes[i-1].hori_conn = curr_top;
+                        join(row+i-1, row+i);
                     }
                 }
             }
-            //lower switches
-            if(Dends[offset+i].enable_fire_input == true) 
-            {
-                if(i%2==1)
-                {
-                    curr_bot->hori_conn = next_bot;
-                }
-                else if (i%2==0)
-                {
-                    //check for combinations of enable_fire_input that are not valid
-                    if(Dends[offset+i-1].enable_fire_input == true)
-                    {
-                        LOG4CXX_ERROR(logger, "Getting nrns from denswitches on HICANN " << hic_id << " invalid combination: enable_fire_input = true on denmems: " << offset+i-1 << " and " << offset+i);
-                        throw std::runtime_error("HALaccess: Getting nrns from denswitches : invalid combination: enable_fire_input = true ");
-                    }
-                    nodes[offset+i-1].hori_conn = curr_bot;
-                }
-            }
         }
         //set the vertical connections
-        if(i%2==0 && Switches[i/2].vert[0] == true )
-        {
-            curr_top->vert_conn = curr_bot;
-            curr_bot->vert_conn = curr_top;
-        }
-        else if(i%2==1 && Switches[i/2].vert[1] == true )
-        {
-            curr_top->vert_conn = curr_bot;
-            curr_bot->vert_conn = curr_top;
-        }
-        
-        curr_top = next_top;
-        curr_bot = next_bot;
+        if(Switches[i/2].vert[i%2] == true)
+            join(i, offset+i);
     }
 }
 
-void HALaccess::visit(size_t nrn_id, node const * curr_node, std::map<size_t,size_t> & den2nrn, std::vector<ESS::neuron> & denmem, std::array<bool,512> & visited)
+void HALaccess::Denmem2Neuron(size_t hic_id)
 {
-    size_t den_id = curr_node->denmem_id;
-    if(visited[den_id] == false)
-    {
-        den2nrn.insert(std::pair<size_t,size_t>(den_id,nrn_id));
-        denmem[den_id].is_connected = true;
-        visited[den_id] = true;
-        if(curr_node->hori_conn != NULL)
-        {
-            visit(nrn_id,curr_node->hori_conn,den2nrn,denmem,visited);
-        }
-        if(curr_node->vert_conn != NULL)
-        {
-            visit(nrn_id,curr_node->vert_conn,den2nrn,denmem,visited);
-        }
-    }
-}
+    //collect the connected denmem, every set of denmems is identified by its lowest denmem
+    denmem_sets sets;
+    std::array<bool,512> connected;
+    connected.fill(false);
+    connect_denmems(hic_id, sets, connected);
 
-//search the graph stored in nodes via depth first algorithm to collect all denmems connected with the den_id-th denmem
-//data is stored in den2nrn
-void HALaccess::search_graph(size_t hic_id, size_t nrn_id, node const* start_node, std::map<size_t,size_t> & den2nrn)
-{
 	auto & denmem = wafer().hicanns[hic_id].neurons_on_hicann;
-    std::array<bool,512> visited;
-    visited.fill(false);
-    visit(nrn_id,start_node,den2nrn,denmem,visited);
-    //check if the starting node really is connected
-    if(start_node->hori_conn == NULL && start_node->vert_conn == NULL)
-        denmem[start_node->denmem_id].is_connected = false;
-}
-
-//return the next (lowest) denmem address, that is not part of den2nrn (key)
-//if all denmem were processed, i.e. all denmem addresses are part of den2nrn return 513 > 512 = # of dennen
-size_t HALaccess::next_missing_denmem(std::map<size_t,size_t> const & den2nrn) const
-{
-    size_t i = 0;
-    for(auto it = den2nrn.begin(); it != den2nrn.end(); ++it)
-    {
-        if(i != it->first)
-        {
-            break;
-        }
-        i++;
-    }
-    return i;
-}
-
-
-void HALaccess::Denmem2Neuron(size_t hic_id)
-{
-    //initialize all nodes
-    std::array<node,512> nodes;
-    for(size_t id = 0; id < nodes.size(); id++)
-    {
-        nodes[id].denmem_id = id;
-        nodes[id].vert_conn = NULL;
-        nodes[id].hori_conn = NULL;
-    }
-    
-    //build the graph
-    build_graph(hic_id,nodes);
-    
-    //search graph to get connected denmem
-    size_t den_id  = 0; //counter for the denmem
-    size_t log_nrn = 0; //counter for the logical neuron
-    std::map<size_t,size_t> den2nrn_aux;
-    while(den_id < nodes.size())
-    {
-        node* curr_node = &nodes[den_id]; 
-        search_graph(hic_id, den_id, curr_node, den2nrn_aux);
-        den_id = next_missing_denmem(den2nrn_aux);
-        log_nrn++;
-    }
+    for(size_t den_id = 0; den_id < connected.size(); ++den_id)
+        denmem[den_id].is_connected = connected[den_id];
 
     //write the denmem2neuron configuration to data
     auto & den2nrn = wafer().hicanns[hic_id].denmem2nrn;
-	const auto & denmem = wafer().hicanns[hic_id].neurons_on_hicann;
     den2nrn.clear();
     //map for logical neurons that were set to logical neurons that will actually be build
     std::map<size_t, int> log_nrn_map;
@@ -896,21 +897,21 @@ void HALaccess::Denmem2Neuron(size_t hic_id)
     int log_nrn_num = -1;
    
     LOG4CXX_DEBUG(logger, "On HICANN " << hic_id << " connecting denmem to logical neurons:" ); 
-    for (auto it = den2nrn_aux.begin(); it != den2nrn_aux.end(); it++)
+    for (size_t den_id = 0; den_id < connected.size(); ++den_id)
     {
-		LOG4CXX_DEBUG(logger, "den2nrn_aux[" << it->first << "] = " << it->second );
+        size_t const set_id = sets.find(den_id);
+		LOG4CXX_DEBUG(logger, "denmem " << den_id << " in set " << set_id );
         //only write denmem, which shall be activated
-		if (is_active(denmem[it->first]) || denmem[it->first].is_connected == true) {
-			//check if log_nrn (a.k.a it->second) has already been added
-            if (log_nrn_map.find(it->second) == log_nrn_map.end())
+		if (is_active(denmem[den_id]) || denmem[den_id].is_connected == true) {
+			//check if the set has already been added
+            if (log_nrn_map.find(set_id) == log_nrn_map.end())
             {
                 log_nrn_num++;
-                log_nrn_map.insert( std::pair<size_t, int>(it->second, log_nrn_num) );
+                log_nrn_map.insert( std::pair<size_t, int>(set_id, log_nrn_num) );
             }
-            den2nrn.insert( std::pair<size_t,size_t>(it->first, log_nrn_map[it->second]) );
-            LOG4CXX_DEBUG( logger, "Denmem " << it->first << " connected to logical Neuron " << log_nrn_map[it->second] );
+            den2nrn.insert( std::pair<size_t,size_t>(den_id, log_nrn_map[set_id]) );
+            LOG4CXX_DEBUG( logger, "Denmem " << den_id << " connected to logical Neuron " << log_nrn_map[set_id] );
         }
-        
     }
     
     //check that for all hw_neuron exactly one denmem is activated (fires and sends spl1 output)
@@ -984,7 +985,7 @@ void HALaccess::initCalib()
 
 	if (mCalibPath == "") {
 		LOG4CXX_INFO(logger, "Using the default calibration (No calibration path specified)");
-		for (auto hicann : wafer().hicanns) {
+		for (auto const& hicann : wafer().hicanns) {
 			if (hicann.available) {
 				mCalibs[hicann.hicann_id] = mDefaultCalib;
 			}
@@ -1006,7 +1007,8 @@ void HALaccess::initCalib()
 
 	calibtic::MetaData md;
 
-	for (auto hicann : wafer().hicanns) {
+	for (auto const& hicann : wafer().hicanns) {
+		// also for HICANNs loaded from a snapshot, a reconfiguration translates them again
 		if (hicann.available) {
 			std::stringstream calib_file;
 			calib_file << "w" << mWaferId;
@@ -1030,3 +1032,92 @@ void HALaccess::initCalib()
 		}
 	}
 }
+
+ESS::translated_hicann const* HALaccess::getTranslated(size_t hic_id) const
+{
+	auto it = mTranslated.find(hic_id);
+	return it != mTranslated.end() ? &it->second : nullptr;
+}
+
+ESS::translated_hicann HALaccess::translate(size_t hic_id)
+{
+	const unsigned int x = wafer().hicanns[hic_id].mX;
+	const unsigned int y = wafer().hicanns[hic_id].mY;
+	ESS::translated_hicann translated;
+	translated.num_neurons = getNeuronsOnHicann(x, y); // runs Denmem2Neuron
+	for (auto side : {ESS::HICANNSide::S_LEFT, ESS::HICANNSide::S_RIGHT})
+		for (auto block : {ESS::HICANNBlock::BL_UP, ESS::HICANNBlock::BL_DOWN})
+			for (unsigned int drv = 0; drv < ESS::translated_hicann::num_syndrivers/4; ++drv)
+				translated.syndriver_params[ESS::translated_hicann::syndriver_index(block, side, drv)] =
+					getSyndriverParameters(x, y, block, side, drv);
+	for (auto const& den : wafer().hicanns[hic_id].denmem2nrn)
+		translated.denmem_params[den.first] = getNeuronParametersSingleDenmem(x, y, den.first);
+	return translated;
+}
+
+void HALaccess::saveConfigSnapshot(std::string const& fn)
+{
+	std::vector<unsigned int> hicann_ids;
+	for (auto const& hicann : wafer().hicanns)
+		if (hicann.available)
+			hicann_ids.push_back(hicann.hicann_id);
+	// the translations stay prepared, so they are used for building the HICANNs
+	// and dropped afterwards by releasePreparedHicanns()
+	prepareHicanns(hicann_ids);
+	ESS::config_snapshot::save(fn, wafer(), mGlobalParams, mTranslated);
+}
+
+void HALaccess::prepareHicanns(std::vector<unsigned int> const& hicann_ids)
+{
+	std::vector<unsigned int> todo;
+	for (auto hic_id : hicann_ids)
+		if (!getTranslated(hic_id))
+			todo.push_back(hic_id);
+
+	// the translation of a HICANN only writes to its own container (Denmem2Neuron)
+	// and to its own result, the calibration data is only read
+	std::vector<ESS::translated_hicann> results(todo.size());
+	std::vector<std::exception_ptr> errors(todo.size());
+	std::atomic<size_t> next(0);
+	auto worker = [&]() {
+		for (size_t i = next++; i < todo.size(); i = next++) {
+			try {
+				results[i] = translate(todo[i]);
+			} catch (...) {
+				errors[i] = std::current_exception();
+			}
+		}
+	};
+	const size_t num_threads = std::min<size_t>(todo.size(), std::max(1u, std::thread::hardware_concurrency()));
+	LOG4CXX_INFO(logger, "Translating the configuration of " << todo.size() << " HICANNs in " << num_threads << " threads");
+	std::vector<std::thread> threads;
+	for (size_t t = 1; t < num_threads; ++t)
+		threads.emplace_back(worker);
+	worker();
+	for (auto& thread : threads)
+		thread.join();
+
+	// report the error of the first HICANN, as the sequential translation does
+	for (auto const& error : errors)
+		if (error)
+			std::rethrow_exception(error);
+	for (size_t i = 0; i < todo.size(); ++i) {
+		mTranslated[todo[i]] = std::move(results[i]);
+		mPrepared.push_back(todo[i]);
+	}
+}
+
+void HALaccess::releasePreparedHicanns()
+{
+	for (auto hic_id : mPrepared)
+		mTranslated.erase(hic_id);
+	mPrepared.clear();
+}
+
+void HALaccess::loadConfigSnapshot(std::string const& fn)
+{
+	ESS::config_snapshot::load(fn, wafer(), mGlobalParams, mTranslated);
+	// dropped after the HICANNs are built, as the translations of prepareHicanns()
+	for (auto const& translated : mTranslated)
+		mPrepared.push_back(translated.first);
+}
@@ -8,6 +8,7 @@
 
 #include "HAL2ESSEnum.h"
 #include "HAL2ESSContainer.h"
+#include "ConfigSnapshot.h"
 
 
 // forward declaration
@@ -33,6 +34,11 @@ public:
 
     uint8_t getPLLFrequency(unsigned int hicann_id) const;
 
+	/// true if the HICANN has to be simulated, i.e. if it has active or recorded neurons,
+	/// is connected to a DNC or is part of an L1 route (repeaters, switches or syndrivers enabled).
+	/// Unused HICANNs are not instantiated.
+	bool isHicannUsed(unsigned int hicann_id) const;
+
 	//method that returns number a vector, which size corresponds to the number of neurons to be mapped on this hicann
 	unsigned int getNeuronsOnHicann(unsigned int x_coord, unsigned int y_coord );
 
@@ -40,11 +46,11 @@ public:
     ESS::global_parameter const& getGlobalHWParameters() const;
     ESS::global_parameter & getGlobalHWParameters();
 
-	//returns the synapse array
-	std::vector<std::vector<ESS::Synapse_t> > getSynapses(unsigned int x_coord, unsigned int y_coord ) const;
+	//returns the synapse array, the reference points into the container and stays valid as long as this HALaccess
+	std::vector<std::vector<ESS::Synapse_t> > const& getSynapses(unsigned int x_coord, unsigned int y_coord ) const;
 
 	//method that returns the configuration of the Syndrivers as a vector of syndriver_cfg_t
-	std::vector<ESS::syndriver_cfg> getSyndriverConfig(
+	std::vector<ESS::syndriver_cfg> const& getSyndriverConfig(
 			unsigned int x_coord,
 			unsigned int y_coord,
 			enum ESS::HICANNSide side) const;
@@ -79,7 +85,8 @@ public:
     std::string getVoltageFile(unsigned int x_coord, unsigned int y_coord, unsigned int denmem) const;
 	bool getCurrentInput(unsigned int x_coord, unsigned int y_coord, unsigned int denmem) const;
 
-    ESS::StimulusContainer getCurrentStimulus(
+    //returns the current stimulus of a block, the reference stays valid as long as this HALaccess
+    ESS::StimulusContainer const& getCurrentStimulus(
             unsigned int x_coord,
             unsigned int y_coord,
             enum ESS::HICANNSide side,
@@ -94,25 +101,25 @@ public:
 
 	//method that configures the repeaters by returnig a vector, normal repeaters as well as spL1-repeaters are configuered, but i dont 
 	//know what happens exactly,currently has some repeater class, which indicates the repeater location as input
-	std::vector<unsigned char> getRepeaterConfig(
+	std::vector<unsigned char> const& getRepeaterConfig(
 			unsigned int x_coord,
 			unsigned int y_coord,
 			ESS::RepeaterLocation rep_block) const; //input needs to be reworked
 
 	//method that configures the crossbar switches, returns a vector of boolean vectors, representing the configuration of the crossbar-
 	//switch-matrix. gets input which indicates the position of the crossbar switch
-	std::vector<std::vector<bool> > getCrossbarSwitchConfig(unsigned int x_coord, unsigned int y_coord, enum ESS::HICANNSide side) const; //input needs to be reworked  
+	ESS::crossbar_type const& getCrossbarSwitchConfig(unsigned int x_coord, unsigned int y_coord, enum ESS::HICANNSide side) const; //input needs to be reworked  
 
 	//method that configures the Syndriver-Switches by returning a vector of boolean vectors, which represents the configuration of the 
 	//SyndriverSwitch, gets input which indicates the position of the syndriver
-	std::vector<std::vector<bool> > getSyndriverSwitchConfig(
+	ESS::synswitch_type const& getSyndriverSwitchConfig(
 			unsigned int x_coord,
 			unsigned int y_coord,
 			enum ESS::HICANNBlock block,
 			enum ESS::HICANNSide side) const; //input needs to be reworked
 
 	//method that configures the spL1-OutputMerger-Config, returns a vector of boolean vectors
-	std::vector<std::vector<bool> > getSPL1OutputMergerConfig(unsigned int x_coord, unsigned int y_coord) const;
+	std::vector<std::vector<bool> > const& getSPL1OutputMergerConfig(unsigned int x_coord, unsigned int y_coord) const;
 
     //configure the ADC
     void configADC(unsigned int adc_coord, uint32_t samples);
@@ -123,6 +130,10 @@ public:
     //get the recorded Neuron Trace from virtual ESS ADC
     std::vector<uint16_t> getADCTrace(unsigned int adc_coord) const;
 
+    //returns the in-memory sample buffer of the primed ADC which records this denmem,
+    //nullptr if the denmem is not read out by a primed ADC
+    ESS::adc_trace* getADCTraceBuffer(unsigned int x_coord, unsigned int y_coord, unsigned int denmem);
+
     // returns the ADEX-model parameter of the specified neuron
     ESS::BioParameter getScaledBioParameter(ESS::BioParameter const & parameter) const;
 
@@ -142,15 +153,40 @@ public:
 	/// If no directory was specified, the default calibration is used.
 	void initCalib();
 
+	/// Translates the configuration of all available HICANNs and writes it,
+	/// together with the container data, to a binary snapshot.
+	/// The translations are kept until the HICANNs are built (see releasePreparedHicanns()).
+	/// Has to be called after the configuration is complete and initCalib().
+	void saveConfigSnapshot(std::string const& fn);
+
+	/// Loads the configuration of a snapshot written by saveConfigSnapshot().
+	/// The HICANNs are built from the stored translated configuration, without Denmem2Neuron.
+	/// As for prepareHicanns(), the translations are dropped after the HICANNs are built,
+	/// so a reconfiguration translates the changed configuration with the calibration data.
+	/// Has to be called before initCalib(), which loads the calibration of the stored HICANNs.
+	void loadConfigSnapshot(std::string const& fn);
+
+	/// Translates the configuration of the given HICANNs (calibration, parameter
+	/// transformations and Denmem2Neuron) in parallel threads, before the HICANNs are built.
+	/// The HICANNs then read the translated configuration, so that only the construction
+	/// of the modules remains sequential. HICANNs loaded from a snapshot are skipped.
+	/// Has to be called after the configuration is complete and initCalib().
+	void prepareHicanns(std::vector<unsigned int> const& hicann_ids);
+
+	/// Drops the configuration translated by prepareHicanns() after the HICANNs are built,
+	/// so that later changes of the configuration (reconfiguration) are translated again.
+	void releasePreparedHicanns();
+
 private:
+    std::map<unsigned int,unsigned int> getADCInputNeurons(unsigned int adc_coord) const;
+    void reset_adc_trace(unsigned int adc_coord);
     std::vector<uint16_t> read_analog_trace(unsigned int const hicann, unsigned int const nrn, uint32_t const samples) const;
     //stuff for Denmem2NeuronV2
-    struct node;
-    void build_graph(size_t hic_id, std::array<node,512> & nodes) const;
-    void visit(size_t nrn_id, node const* curr_node, std::map<size_t,size_t> & den2nrn, std::vector<ESS::neuron> & denmem, std::array<bool,512> & visited);
-    void search_graph(size_t hic_id, size_t nrn_id, node const * start_node, std::map<size_t, size_t> & den2nrn);
-    size_t next_missing_denmem(std::map<size_t, size_t> const &  den2nrn) const;
+    struct denmem_sets;
+    void connect_denmems(size_t hic_id, denmem_sets & sets, std::array<bool,512> & connected) const;
     void Denmem2Neuron(size_t hic_id);
+    //translates the configuration of one HICANN, runs Denmem2Neuron
+    ESS::translated_hicann translate(size_t hic_id);
 	// get row-wise synapse trafo from calibration data
 	// returns vector of coefficients of a polynomial trafo (index equals degree) from digital to
 	// analog weights in Siemens.
@@ -163,11 +199,17 @@ private:
 
 	std::shared_ptr<calib_type> getCalib(unsigned int x_coord, unsigned int y_coord) const;
 
+	/// translated configuration of a HICANN, NULL if it was not translated in advance
+	ESS::translated_hicann const* getTranslated(size_t hic_id) const;
+
 	ESS::wafer waf;
     ESS::global_parameter mGlobalParams;
+    std::array<std::unique_ptr<ESS::adc_trace>, 2*ESS::wafer::num_dncs> mADCTraces; ///< samples captured in memory by the ADCs
 	unsigned int mWaferId; ///< wafer id needed for calibration data
 	std::string mFilepath;
 	std::string mCalibPath;
 	std::shared_ptr<calib_type> mDefaultCalib;
 	std::map<unsigned int, std::shared_ptr<calib_type> > mCalibs;
+	ESS::translated_wafer mTranslated; ///< configuration translated in advance or loaded from a snapshot
+	std::vector<unsigned int> mPrepared; ///< HICANNs translated by prepareHicanns()
 };
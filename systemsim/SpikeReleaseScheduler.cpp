@@ -0,0 +1,89 @@
+#include "SpikeReleaseScheduler.h"
+#include "state_archive.h"
+#include <stdexcept>
+#include <log4cxx/logger.h>
+
+static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("ESS.HICANN.Neuron");
+
+SpikeReleaseScheduler::SpikeReleaseScheduler(sc_module_name name, sc_port<anncore_pulse_if> *a):
+	sc_module(name)
+	,anc(a)
+	,release_spike_buffer(0)
+	,delay(L1_DELAY_REP_TO_DENMEM, SC_NS)
+	,enabled(true)
+{
+	SC_HAS_PROCESS(SpikeReleaseScheduler);
+
+	SC_METHOD(release);
+	dont_initialize();
+	sensitive << rel_spike;
+}
+
+void SpikeReleaseScheduler::reserve(size_t max_spikes)
+{
+	release_spike_buffer.resize(max_spikes);
+	LOG4CXX_DEBUG(logger, name() << ": reserved release buffer for " << max_spikes << " spikes" );
+}
+
+void SpikeReleaseScheduler::schedule(unsigned int logical_neuron, unsigned int addr, unsigned int wta)
+{
+	if (!enabled)
+		return;
+	pending_spike spike = { sc_time_stamp() + delay, logical_neuron, addr, wta };
+	const bool was_empty = release_spike_buffer.empty();
+	if ( !release_spike_buffer.insert(spike) ) {
+		LOG4CXX_ERROR(logger, name() << ": schedule(): release buffer full (capacity " << release_spike_buffer.capacity() << ")" );
+		throw std::runtime_error("SpikeReleaseScheduler::schedule(): release buffer full");
+	}
+	// release times are monotonic, so a pending notification is never later than this spike.
+	if (was_empty)
+		rel_spike.notify(delay);
+}
+
+void SpikeReleaseScheduler::set_enable(bool enable)
+{
+	enabled = enable;
+}
+
+void SpikeReleaseScheduler::clear()
+{
+	rel_spike.cancel();
+	while ( !release_spike_buffer.empty() )
+		release_spike_buffer.pop();
+}
+
+void SpikeReleaseScheduler::checkpoint(ess::state_archive& ar)
+{
+	ar.section(name());
+	ar.value(enabled);
+	std::vector<pending_spike> spikes;
+	for (size_t i = 0; i < release_spike_buffer.num_available(); ++i)
+		spikes.push_back(release_spike_buffer[i]);
+	ar.sequence(spikes, [&ar](pending_spike& spike){
+		ar.time(spike.release_time);
+		ar.value(spike.logical_neuron);
+		ar.value(spike.addr);
+		ar.value(spike.wta);
+	});
+	if (ar.loading()) {
+		clear();
+		for (auto const& spike : spikes)
+			if ( !release_spike_buffer.insert(spike) )
+				throw std::runtime_error("SpikeReleaseScheduler::checkpoint(): release buffer too small");
+		if ( !release_spike_buffer.empty() )
+			rel_spike.notify( release_spike_buffer.front().release_time - sc_time_stamp() );
+	}
+}
+
+void SpikeReleaseScheduler::release()
+{
+	const sc_time now = sc_time_stamp();
+	while ( !release_spike_buffer.empty() && release_spike_buffer.front().release_time <= now ) {
+		const pending_spike& spike = release_spike_buffer.front();
+		LOG4CXX_TRACE(logger, name() << ": release():" << now << "\t Neuron_ID : " << spike.logical_neuron <<  " with addr " << spike.addr );
+		(*anc)->handle_spike(spike.logical_neuron, spike.addr, spike.wta);
+		release_spike_buffer.pop();
+	}
+	if ( !release_spike_buffer.empty() )
+		rel_spike.notify( release_spike_buffer.front().release_time - now );
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "systemc.h"
+#include "anncore_pulse_if.h"
+#include "ring_buffer.h"
+
+namespace ess { class state_archive; }
+
+/** delays the output spikes of all compound neurons of one anncore.
+ * Spikes are released L1_DELAY_REP_TO_DENMEM after they were emitted.
+ * As this delay is the same for all neurons, spikes are queued in order of
+ * their release time in a single preallocated ring buffer, and all spikes
+ * due at one time are released in one activation of `release()`.
+ */
+class SpikeReleaseScheduler : public sc_module
+{
+public:
+	SpikeReleaseScheduler(sc_module_name name, sc_port<anncore_pulse_if> *a);
+
+	/** sets the capacity of the release buffer.
+	 * Must be called before simulation, pending spikes are discarded.
+	 * @param max_spikes maximum number of spikes in flight at the same time
+	 */
+	void reserve(size_t max_spikes);
+
+	/** schedules release of a spike after L1_DELAY_REP_TO_DENMEM.
+	 * @param logical_neuron id of the firing denmem
+	 * @param addr 6-bit address on layer 1 bus
+	 * @param wta ID of Priority Encoder(WTA) the neuron is connected to: 0..7
+	 */
+	void schedule(unsigned int logical_neuron, unsigned int addr, unsigned int wta);
+
+	/** enables or disables the release of spikes.
+	 * Spikes scheduled while disabled are dropped. Used to silence the neurons
+	 * while the system is drained between two runs.
+	 */
+	void set_enable(bool enable);
+
+	/** discards all pending spikes.*/
+	void clear();
+
+	/** stores or restores the pending spikes.
+	 * When restoring, the release is rescheduled for the first pending spike.*/
+	void checkpoint(ess::state_archive& ar);
+
+private:
+	struct pending_spike
+	{
+		sc_time release_time;
+		unsigned int logical_neuron;
+		unsigned int addr;
+		unsigned int wta;
+	};
+
+	/** this is the target where the anncore delivers its output spikes.*/
+	sc_port<anncore_pulse_if> *anc;
+
+	ess::ring_buffer<pending_spike> release_spike_buffer; ///< spikes ordered by release time
+	sc_event rel_spike; ///< triggers release(), pending as long as buffer is not empty
+	const sc_time delay; ///< L1_DELAY_REP_TO_DENMEM
+	bool enabled; ///< if false, scheduled spikes are dropped
+
+	/** releases all spikes that are due now */
+	void release();
+};
@@ -0,0 +1,61 @@
+#include "SynapseTrafo.h"
+
+#include <map>
+#include <mutex>
+
+#include "paramtrafo_types.h"
+
+namespace {
+
+typedef std::map< std::vector<double>, std::weak_ptr<SynapseTrafo const> > pool_type;
+
+std::mutex pool_mutex;
+
+pool_type& pool()
+{
+	static pool_type instances;
+	return instances;
+}
+
+/// removes the entry of an instance from the pool, when the last syndriver row releases it
+struct pool_deleter
+{
+	void operator()(SynapseTrafo const* trafo) const
+	{
+		{
+			std::lock_guard<std::mutex> lock(pool_mutex);
+			auto it = pool().find(trafo->coefficients());
+			// another thread might already have interned a new instance for these coefficients
+			if (it != pool().end() && it->second.expired())
+				pool().erase(it);
+		}
+		delete trafo;
+	}
+};
+
+} // anonymous namespace
+
+SynapseTrafo::SynapseTrafo(std::vector<double> const& coefficients)
+	: _coefficients(coefficients)
+{
+	for (size_t dw = 0; dw < _analog_weight.size(); ++dw)
+		_analog_weight[dw] = trafo_polynomial<double,double>(static_cast<double>(dw), _coefficients);
+}
+
+std::shared_ptr<SynapseTrafo const> SynapseTrafo::get(std::vector<double> const& coefficients)
+{
+	std::lock_guard<std::mutex> lock(pool_mutex);
+	std::weak_ptr<SynapseTrafo const>& entry = pool()[coefficients];
+	std::shared_ptr<SynapseTrafo const> trafo = entry.lock();
+	if (!trafo) {
+		trafo = std::shared_ptr<SynapseTrafo const>(new SynapseTrafo(coefficients), pool_deleter());
+		entry = trafo;
+	}
+	return trafo;
+}
+
+size_t SynapseTrafo::num_interned()
+{
+	std::lock_guard<std::mutex> lock(pool_mutex);
+	return pool().size();
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+/** polynomial synapse trafo from digital to analog weight together with its
+ * evaluation for all 16 digital weights.
+ * Instances are interned: all syndriver rows using the same trafo share one
+ * instance, so that the table is evaluated only once per distinct trafo.
+ */
+class SynapseTrafo
+{
+public:
+	typedef std::array<double, 16> table_type;
+
+	/** returns the shared instance for the trafo coefficients.
+	 * The table is evaluated, if no syndriver row uses these coefficients yet.
+	 * @param coefficients polynomial coefficients, index equals degree, in Siemens
+	 */
+	static std::shared_ptr<SynapseTrafo const> get(std::vector<double> const& coefficients);
+
+	/// number of distinct trafos in use, i.e. number of evaluated tables.
+	/// The entry of a trafo is removed, when its last user releases it.
+	static size_t num_interned();
+
+	std::vector<double> const& coefficients() const { return _coefficients; }
+
+	/// analog weight in Siemens of a digital weight 0..15
+	double analog_weight(size_t digital_weight) const { return _analog_weight[digital_weight]; }
+
+	explicit SynapseTrafo(std::vector<double> const& coefficients);
+
+private:
+	std::vector<double> _coefficients;
+	table_type _analog_weight;
+};
@@ -0,0 +1,187 @@
+#include "TraceMemory.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+#include <log4cxx/logger.h>
+
+#include "state_archive.h"
+
+static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("ESS.Layer2");
+
+const size_t TraceMemory::chunk_entries;
+const size_t TraceMemory::spill_entry_bytes;
+
+TraceMemory::TraceMemory()
+	: _front_offset(0)
+	, _size(0)
+	, _max_chunks(0)
+	, _spill_written(0)
+	, _spill_read(0)
+	, _warned(false)
+{}
+
+TraceMemory::~TraceMemory()
+{
+	_spill.close();
+}
+
+void TraceMemory::configure(size_t budget_bytes, std::string const& spill_file)
+{
+	const size_t chunk_bytes = chunk_entries*sizeof(ESS::trace_entry);
+	_max_chunks = budget_bytes ? std::max<size_t>(1, budget_bytes/chunk_bytes) : 0;
+	_spill_fn = spill_file;
+	clear();
+}
+
+void TraceMemory::push_back(ESS::trace_entry const& entry)
+{
+	if (_chunks.empty() || _chunks.back().size() == chunk_entries) {
+		if (_max_chunks && _chunks.size() >= _max_chunks) {
+			if (!_spill_fn.empty()) {
+				spill_front();
+			} else if (!_warned) {
+				LOG4CXX_WARN(logger, "TraceMemory: memory budget of the trace memory exceeded and no spill file given, keeping the pulses in memory");
+				_warned = true;
+			}
+		}
+		_chunks.push_back(std::vector<ESS::trace_entry>());
+		_chunks.back().reserve(chunk_entries);
+	}
+	_chunks.back().push_back(entry);
+	++_size;
+}
+
+void TraceMemory::spill_front()
+{
+	if (!_spill.is_open() && !_spill.open(_spill_fn, "wb")) {
+		LOG4CXX_ERROR(logger, "TraceMemory: could not open spill file " << _spill_fn );
+		throw std::runtime_error("TraceMemory: could not open spill file " + _spill_fn);
+	}
+	std::vector<ESS::trace_entry> const& chunk = _chunks.front();
+	std::vector<unsigned char> data;
+	data.reserve((chunk.size() - _front_offset)*spill_entry_bytes);
+	for (size_t i = _front_offset; i < chunk.size(); ++i) {
+		const uint64_t time = chunk[i].fpga_time;
+		const uint16_t label = chunk[i].event.getLabel();
+		const uint16_t stamp = chunk[i].event.getTime();
+		for (size_t b = 0; b < 8; ++b)
+			data.push_back((time >> (8*b)) & 0xff);
+		for (size_t b = 0; b < 2; ++b)
+			data.push_back((label >> (8*b)) & 0xff);
+		for (size_t b = 0; b < 2; ++b)
+			data.push_back((stamp >> (8*b)) & 0xff);
+	}
+	_spill.write(data.data(), data.size());
+	_spill_written += chunk.size() - _front_offset;
+	_chunks.pop_front();
+	_front_offset = 0;
+}
+
+void TraceMemory::read_spill(ESS::trace_container_t& out, size_t first, size_t n)
+{
+	if (n == 0)
+		return;
+	// the data handed over to the writer thread has to be on disk
+	_spill.flush();
+	ess::async_writer::instance().flush();
+
+	FILE* f = fopen(_spill_fn.c_str(), "rb");
+	if (!f || fseek(f, first*spill_entry_bytes, SEEK_SET) != 0) {
+		if (f)
+			fclose(f);
+		LOG4CXX_ERROR(logger, "TraceMemory: could not read spill file " << _spill_fn );
+		throw std::runtime_error("TraceMemory: could not read spill file " + _spill_fn);
+	}
+	std::vector<unsigned char> data(spill_entry_bytes*std::min<size_t>(n, chunk_entries));
+	out.reserve(out.size() + n);
+	while (n > 0) {
+		const size_t num = std::min(n, data.size()/spill_entry_bytes);
+		if (fread(data.data(), spill_entry_bytes, num, f) != num) {
+			fclose(f);
+			throw std::runtime_error("TraceMemory: spill file " + _spill_fn + " is truncated");
+		}
+		for (size_t i = 0; i < num; ++i) {
+			unsigned char const* p = &data[i*spill_entry_bytes];
+			uint64_t time = 0;
+			for (size_t b = 0; b < 8; ++b)
+				time |= uint64_t(p[b]) << (8*b);
+			ESS::trace_entry entry;
+			entry.fpga_time = time;
+			entry.event.setLabel(p[8] | (p[9] << 8));
+			entry.event.setTime(p[10] | (p[11] << 8));
+			out.push_back(entry);
+		}
+		n -= num;
+	}
+	fclose(f);
+}
+
+size_t TraceMemory::drain(ESS::trace_container_t& out, size_t max_entries)
+{
+	size_t drained = std::min(max_entries, _spill_written - _spill_read);
+	read_spill(out, _spill_read, drained);
+	_spill_read += drained;
+
+	while (drained < max_entries && !_chunks.empty()) {
+		std::vector<ESS::trace_entry> const& chunk = _chunks.front();
+		const size_t num = std::min(max_entries - drained, chunk.size() - _front_offset);
+		out.insert(out.end(), chunk.begin() + _front_offset, chunk.begin() + _front_offset + num);
+		_front_offset += num;
+		drained += num;
+		// the last chunk is kept for the following pulses
+		if (_front_offset == chunk.size() && (_chunks.size() > 1 || chunk.size() == chunk_entries)) {
+			_chunks.pop_front();
+			_front_offset = 0;
+		} else if (_front_offset == chunk.size()) {
+			break;
+		}
+	}
+	_size -= drained;
+	return drained;
+}
+
+ESS::trace_container_t TraceMemory::all()
+{
+	ESS::trace_container_t out;
+	out.reserve(_size);
+	read_spill(out, _spill_read, _spill_written - _spill_read);
+	for (size_t c = 0; c < _chunks.size(); ++c)
+		out.insert(out.end(), _chunks[c].begin() + (c == 0 ? _front_offset : 0), _chunks[c].end());
+	return out;
+}
+
+void TraceMemory::clear()
+{
+	_chunks.clear();
+	_front_offset = 0;
+	_size = 0;
+	_spill.close();
+	if (_spill_written)
+		std::remove(_spill_fn.c_str());
+	_spill_written = 0;
+	_spill_read = 0;
+	_warned = false;
+}
+
+void TraceMemory::checkpoint(ess::state_archive& ar)
+{
+	ESS::trace_container_t pulses;
+	if (!ar.loading())
+		pulses = all();
+	ar.sequence(pulses, [&ar](ESS::trace_entry& entry){
+		ar.value(entry.fpga_time);
+		uint32_t label = entry.event.getLabel();
+		uint32_t time = entry.event.getTime();
+		ar.value(label);
+		ar.value(time);
+		entry.event.setLabel(label);
+		entry.event.setTime(time);
+	});
+	if (ar.loading()) {
+		clear();
+		for (auto const& entry : pulses)
+			push_back(entry);
+	}
+}
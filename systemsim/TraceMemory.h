@@ -0,0 +1,78 @@
+#pragma once
+
+#include <deque>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "HAL2ESSContainer.h"
+#include "async_writer.h"
+
+namespace ess { class state_archive; }
+
+/** trace memory of an FPGA.
+ * Recorded pulses are stored in preallocated chunks. If a memory budget is set
+ * and exceeded, the oldest chunks are written to a binary spill file in the
+ * background, if one is given. Pulses are read in recording order, either
+ * all at once or incrementally with drain(), e.g. between two run() segments.
+ *
+ * spill file layout: per pulse (little-endian)
+ *   uint64   fpga_time
+ *   uint16   label
+ *   uint16   time stamp
+ */
+class TraceMemory
+{
+public:
+	/// number of pulses per chunk
+	static const size_t chunk_entries = 1 << 14;
+
+	TraceMemory();
+	~TraceMemory();
+
+	/// sets the memory budget and the spill file, discards all recorded pulses.
+	void configure(
+			size_t budget_bytes,          //!< memory for recorded pulses, 0: unlimited
+			std::string const& spill_file //!< file for pulses exceeding the budget, empty: keep them in memory
+			);
+
+	void push_back(ESS::trace_entry const& entry);
+
+	/// number of recorded pulses which were not drained yet
+	size_t size() const { return _size; }
+
+	/// number of pulses written to the spill file since the last clear()
+	size_t spilled() const { return _spill_written; }
+
+	/// moves up to max_entries of the oldest pulses to the end of out, returns their number.
+	size_t drain(ESS::trace_container_t& out, size_t max_entries = std::numeric_limits<size_t>::max());
+
+	/// copies all pulses which were not drained yet
+	ESS::trace_container_t all();
+
+	/// discards all pulses and truncates the spill file
+	void clear();
+
+	/// stores or restores the pulses which were not drained yet
+	void checkpoint(ess::state_archive& ar);
+
+private:
+	static const size_t spill_entry_bytes = 12;
+
+	void spill_front();
+	/// appends n pulses of the spill file starting with pulse first to out
+	void read_spill(ESS::trace_container_t& out, size_t first, size_t n);
+
+	std::deque< std::vector<ESS::trace_entry> > _chunks;
+	size_t _front_offset;  ///< drained pulses of the first chunk
+	size_t _size;
+	size_t _max_chunks;    ///< chunks in memory before spilling, 0: unlimited
+	std::string _spill_fn;
+	ess::async_file _spill;
+	size_t _spill_written; ///< pulses in the spill file
+	size_t _spill_read;    ///< pulses drained from the spill file
+	bool _warned;          ///< budget exceeded without spill file was reported
+
+	TraceMemory(const TraceMemory&);
+	const TraceMemory& operator=(const TraceMemory&);
+};
@@ -0,0 +1,278 @@
+#include "VoltageTrace.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include <log4cxx/logger.h>
+
+#include "mapped_file.h"
+#include "state_archive.h"
+
+static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("ESS.HICANN.Neuron");
+
+namespace ESS {
+
+namespace {
+
+void put_u32(ess::async_file& f, uint32_t v)
+{
+	unsigned char b[4];
+	for (size_t i = 0; i < 4; ++i)
+		b[i] = (v >> (8*i)) & 0xff;
+	f.write(b, 4);
+}
+
+void put_u64(ess::async_file& f, uint64_t v)
+{
+	unsigned char b[8];
+	for (size_t i = 0; i < 8; ++i)
+		b[i] = (v >> (8*i)) & 0xff;
+	f.write(b, 8);
+}
+
+void put_float(ess::async_file& f, float v)
+{
+	uint32_t u;
+	std::memcpy(&u, &v, sizeof(u));
+	put_u32(f, u);
+}
+
+void put_double(ess::async_file& f, double v)
+{
+	uint64_t u;
+	std::memcpy(&u, &v, sizeof(u));
+	put_u64(f, u);
+}
+
+uint32_t get_u32(const unsigned char* p)
+{
+	uint32_t v = 0;
+	for (size_t i = 0; i < 4; ++i)
+		v |= uint32_t(p[i]) << (8*i);
+	return v;
+}
+
+uint64_t get_u64(const unsigned char* p)
+{
+	uint64_t v = 0;
+	for (size_t i = 0; i < 8; ++i)
+		v |= uint64_t(p[i]) << (8*i);
+	return v;
+}
+
+float get_float(const unsigned char* p)
+{
+	uint32_t u = get_u32(p);
+	float v;
+	std::memcpy(&v, &u, sizeof(v));
+	return v;
+}
+
+double get_double(const unsigned char* p)
+{
+	uint64_t u = get_u64(p);
+	double v;
+	std::memcpy(&v, &u, sizeof(v));
+	return v;
+}
+
+void read_binary(ess::mapped_file const& file, size_t max_samples, std::vector<double>& V)
+{
+	const unsigned char* p = file.data;
+	const uint32_t version = get_u32(p + 4);
+	const double interval = get_double(p + 8);
+	const size_t stride = get_u32(p + 28);
+	if (version != VoltageTraceWriter::version || stride < VoltageTraceWriter::sample_size || interval <= 0.) {
+		LOG4CXX_WARN(logger, "read_voltage_trace: unsupported trace version " << version );
+		return;
+	}
+
+	const size_t num_entries = (file.size - VoltageTraceWriter::header_size) / stride;
+	if (num_entries == 0)
+		return;
+	const unsigned char* entries = p + VoltageTraceWriter::header_size;
+	const double t_last = get_double(entries + (num_entries-1)*stride);
+	// time stamps are multiples of the interval, allow for rounding
+	const double eps = 0.5*interval;
+
+	V.reserve(std::min<size_t>(max_samples, size_t(t_last/interval) + 1));
+	size_t idx = 0;
+	for (size_t k = 0; k < max_samples; ++k) {
+		const double t = k*interval;
+		if (t > t_last + eps)
+			break;
+		while (idx + 1 < num_entries && get_double(entries + (idx+1)*stride) <= t + eps)
+			++idx;
+		V.push_back(get_float(entries + idx*stride + 8));
+	}
+}
+
+void read_text(ess::mapped_file const& file, size_t max_samples, std::vector<double>& V)
+{
+	const char* p = reinterpret_cast<const char*>(file.data);
+	// only complete lines are parsed, so that strtod never runs past the mapping
+	const void* last_nl = memrchr(p, '\n', file.size);
+	if (!last_nl)
+		return;
+	const char* end = static_cast<const char*>(last_nl) + 1;
+
+	while (p < end && V.size() < max_samples) {
+		const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+		if (*p != '#') {
+			char* next;
+			std::strtod(p, &next); // t
+			const double v = std::strtod(next, &next);
+			if (next == p || next > nl)
+				break;
+			V.push_back(v);
+		}
+		p = nl + 1;
+	}
+}
+
+} // anonymous namespace
+
+voltage_trace_config::voltage_trace_config() :
+	binary(false),
+	decimation(1),
+	tolerance(0.)
+{}
+
+const char VoltageTraceWriter::magic[4] = {'E', 'S', 'S', 'V'};
+const uint32_t VoltageTraceWriter::version;
+const size_t VoltageTraceWriter::header_size;
+const size_t VoltageTraceWriter::sample_size;
+
+VoltageTraceWriter::VoltageTraceWriter() :
+	mSeen(0),
+	mLastV(0.),
+	mHasPending(false)
+{}
+
+VoltageTraceWriter::~VoltageTraceWriter()
+{
+	close();
+}
+
+void VoltageTraceWriter::open(std::string const& fn, double interval, voltage_trace_config const& cfg)
+{
+	close();
+	mConfig = cfg;
+	if (mConfig.decimation == 0)
+		mConfig.decimation = 1;
+	mSeen = 0;
+	mHasPending = false;
+
+	if (!mFile.open(fn, mConfig.binary ? "wb" : "w")) {
+		LOG4CXX_ERROR(logger, "VoltageTraceWriter::open(): could not open file: " << fn );
+		throw std::runtime_error("VoltageTraceWriter::open(): could not open file " + fn);
+	}
+
+	if (mConfig.binary) {
+		mFile.write(magic, 4);
+		put_u32(mFile, version);
+		put_double(mFile, interval);
+		put_double(mFile, mConfig.tolerance);
+		put_u32(mFile, mConfig.decimation);
+		put_u32(mFile, sample_size);
+	} else {
+		mFile.printf("#t[Seconds]\tV[Volt]\tw[Ampere]\tg_e[Siemens]\tg_i[Siemens]\n");
+	}
+}
+
+void VoltageTraceWriter::sample(double t, double V, double w, double g_e, double g_i)
+{
+	if (!mFile.is_open())
+		return;
+	const entry e = {t, V, w, g_e, g_i};
+	bool due = (mSeen % mConfig.decimation) == 0;
+	if (due && mConfig.tolerance > 0. && mSeen > 0 && std::fabs(V - mLastV) <= mConfig.tolerance)
+		due = false;
+	++mSeen;
+
+	if (due) {
+		write(e);
+		mHasPending = false;
+	} else {
+		mPending = e;
+		mHasPending = true;
+	}
+}
+
+void VoltageTraceWriter::close()
+{
+	if (!mFile.is_open())
+		return;
+	// the last sample marks the end of the trace
+	if (mHasPending)
+		write(mPending);
+	mHasPending = false;
+	mFile.close();
+}
+
+bool VoltageTraceWriter::is_open() const
+{
+	return mFile.is_open();
+}
+
+void VoltageTraceWriter::checkpoint(ess::state_archive& ar)
+{
+	ar.value(mSeen);
+	ar.value(mLastV);
+	ar.value(mHasPending);
+	ar.value(mPending.t);
+	ar.value(mPending.V);
+	ar.value(mPending.w);
+	ar.value(mPending.g_e);
+	ar.value(mPending.g_i);
+}
+
+void VoltageTraceWriter::write(entry const& e)
+{
+	if (mConfig.binary) {
+		put_double(mFile, e.t);
+		put_float(mFile, e.V);
+		put_float(mFile, e.w);
+		put_float(mFile, e.g_e);
+		put_float(mFile, e.g_i);
+	} else {
+		// same as std::ios::scientific with default precision of 6
+		mFile.printf("%e\t%e\t%e\t%e\t%e\n", e.t, e.V, e.w, e.g_e, e.g_i);
+	}
+	mLastV = e.V;
+}
+
+std::vector<double> read_voltage_trace(std::string const& fn, size_t max_samples)
+{
+	std::vector<double> V;
+	ess::mapped_file file(fn);
+	if (!file.data) {
+		LOG4CXX_WARN(logger, "read_voltage_trace: could not map file: " << fn );
+		return V;
+	}
+
+	if (file.size >= VoltageTraceWriter::header_size &&
+			std::memcmp(file.data, VoltageTraceWriter::magic, 4) == 0)
+		read_binary(file, max_samples, V);
+	else
+		read_text(file, max_samples, V);
+	return V;
+}
+
+uint16_t voltage_to_adc(double V)
+{
+	//the maximal voltage value is 1.8 V
+	const double v_max = 1.8;
+	//the maximal value of uint16 is 2^16 - 1 = 65535
+	const uint16_t uint16_max = 65535;
+
+	if (V < 0)
+		return 0;
+	if (V > v_max)
+		return uint16_max;
+	return (V / v_max) * uint16_max;
+}
+
+} // end namespace ESS
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "async_writer.h"
+
+namespace ess { class state_archive; }
+
+namespace ESS {
+
+/// settings for the recording of membrane voltage traces
+struct voltage_trace_config
+{
+	voltage_trace_config();
+
+	bool         binary;     //!< write binary little-endian samples instead of text columns
+	unsigned int decimation; //!< only every n-th sample is written, 1 = every sample
+	double       tolerance;  //!< in Volt. If > 0, a sample is only written when V differs by more than this from the last written sample
+};
+
+/** Binary voltage trace format (all values little-endian):
+ *
+ *  header (32 bytes):
+ *    char[4]  magic "ESSV"
+ *    uint32   version
+ *    double   recording interval in seconds
+ *    double   tolerance in Volt
+ *    uint32   decimation
+ *    uint32   size of one sample in bytes
+ *
+ *  samples (24 bytes each):
+ *    double   t[Seconds]
+ *    float    V[Volt]
+ *    float    w[Ampere]
+ *    float    g_e[Siemens]
+ *    float    g_i[Siemens]
+ *
+ *  The text format is the legacy one: a header line followed by one tab
+ *  separated line "t V w g_e g_i" per sample.
+ */
+class VoltageTraceWriter
+{
+public:
+	static const char     magic[4];
+	static const uint32_t version = 1;
+	static const size_t   header_size = 32;
+	static const size_t   sample_size = 24;
+
+	VoltageTraceWriter();
+	~VoltageTraceWriter();
+
+	/// opens the file and writes the header, throws std::runtime_error on failure
+	void open(
+			std::string const& fn,            //!< filename
+			double interval,                  //!< recording interval in seconds
+			voltage_trace_config const& cfg   //!< format, decimation and tolerance
+			);
+
+	/// passes one sample, which is written depending on decimation and tolerance
+	void sample(double t, double V, double w, double g_e, double g_i);
+
+	/// writes the last sample if it was skipped, and closes the file.
+	void close();
+
+	bool is_open() const;
+
+	/// stores or restores the decimation state, so that a reopened recording continues seamlessly
+	void checkpoint(ess::state_archive& ar);
+
+private:
+	struct entry
+	{
+		double t;
+		double V;
+		double w;
+		double g_e;
+		double g_i;
+	};
+
+	void write(entry const& e);
+
+	ess::async_file mFile;       ///< written by the background thread of ess::async_writer
+	voltage_trace_config mConfig;
+	unsigned long mSeen;         ///< number of samples passed to sample()
+	double mLastV;               ///< V of the last written sample
+	entry mPending;              ///< last sample, if it was not written
+	bool mHasPending;
+
+	VoltageTraceWriter(VoltageTraceWriter const&);
+	VoltageTraceWriter& operator=(VoltageTraceWriter const&);
+};
+
+/** reads the membrane voltage from a trace file.
+ * The file is mapped into memory. For binary traces, samples are returned on
+ * the uniform grid of the recording interval, samples omitted by decimation or
+ * tolerance are filled by holding the last written value. Text traces are
+ * returned row by row.
+ * Returns at most max_samples values, an empty vector if the file can not be read.
+ */
+std::vector<double> read_voltage_trace(std::string const& fn, size_t max_samples);
+
+/// converts a membrane voltage to the 16 bit value of the virtual ADC.
+/// the range 0 .. 1.8 V is mapped to 0 .. 65535, values outside are clipped.
+uint16_t voltage_to_adc(double V);
+
+} // end namespace ESS
@@ -25,6 +25,7 @@
 #include "hw_neuron_IFSC.h"
 
 #include "jf_utils.h"
+#include "state_archive.h"
 
 //#include "Tools/stage2/NN_def.h" // for VOID_NEURON
 #include "calibtic/HMF/SynapseDecoderDisablingSynapse.h"
@@ -34,13 +35,14 @@
 
 static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("ESS.HICANN");
 
-anncore_behav::anncore_behav(const sc_module_name& anncore_i, short anncore_id, ess::mutexfile& spike_rcx_file, uint8_t PLL_period_ns, bool enable_spike_debugging) :
+anncore_behav::anncore_behav(const sc_module_name& anncore_i, short anncore_id, ess::async_file& spike_rcx_file, uint8_t PLL_period_ns, bool enable_spike_debugging) :
 	sc_module(anncore_i),
     _anncore_id(anncore_id),
     _spike_debugging(enable_spike_debugging),
     _hw_neuron_count(0),
 	_hw_neurons_created(false),
     _bio_neuron_count(0),
+    _spike_release("spike_release", &out_port),
     _clock("clock", 4*PLL_period_ns, SC_NS),    //Factor 4 because the HICANN_SLOW_Clock responsible for the current stimuli is 4 times slower than the PLL_frequency
     _fg_stim(),
     _global_cnt(0), 
@@ -117,6 +119,48 @@ anncore_behav::~anncore_behav()
     LOG4CXX_INFO(logger, "anncore_behav destructor id: " << _anncore_id);
 }
 
+void anncore_behav::set_output_enable(bool enable)
+{
+	_spike_release.set_enable(enable);
+}
+
+void anncore_behav::finish_run()
+{
+	for (auto cmn : _compound_neurons)
+		cmn->finish_run();
+}
+
+void anncore_behav::reset(sc_time const& origin)
+{
+	_spike_release.clear();
+	_spike_release.set_enable(true);
+	for (auto& drv : _syndrivers)
+		drv.reset_STP();
+	// the stimuli are initialized again at the next clock cycle
+	_global_cnt = 0;
+	for (auto cmn : _compound_neurons)
+		cmn->reset(origin);
+    LOG4CXX_DEBUG(logger, name() << ": dynamic state reset at " << origin );
+}
+
+void anncore_behav::checkpoint(ess::state_archive& ar)
+{
+	ar.section(name());
+	ar.value(_global_cnt);
+	for (auto& stim : _fg_stim) {
+		ar.value(stim.enable);
+		ar.value(stim.position);
+		ar.value(stim.clk_counter);
+	}
+	ar.check_size(_syndrivers.size());
+	for (auto& drv : _syndrivers)
+		drv.checkpoint(ar);
+	_spike_release.checkpoint(ar);
+	ar.check_size(_compound_neurons.size());
+	for (auto cmn : _compound_neurons)
+		cmn->checkpoint(ar);
+}
+
 //Functions for Stimcurrent
 
 void anncore_behav::check_for_stimchange()
@@ -206,16 +250,14 @@ void anncore_behav::recv_pulse(unsigned int syndr, unsigned int addr)
 
     if(_spike_debugging)
     {
-        FILE *fpt = spike_rx_file.aquire_fp();
-	    fprintf(fpt,"%.8i %.3i %.3i %.2i\n",(uint)sc_simulation_time(),_anncore_id,(uint)syndr, (unsigned char)addr);
-	    fflush(fpt);
-	    spike_rx_file.release_fp(fpt);
+	    spike_rx_file.printf("%.8i %.3i %.3i %.2i\n",(uint)sc_simulation_time(),_anncore_id,(uint)syndr, (unsigned char)addr);
     }
 
 	// only do stuff if the driver receives L1 Input (hence get_l1() == true)
     if( _syndrivers[syndr].get_l1() )
     {
         int num_pulses = 0;
+        static_cast<void>(num_pulses); // only logged
         // check if this syndriver is enabled and send a pulse if it does
         if( _syndrivers[syndr].get_enable() )
         {
@@ -323,8 +365,9 @@ void anncore_behav::configWeights(const std::vector<char>& weights)
 		// whether std::copy() is supported by possible basics:: implementation.
 		for(size_t i = 0; i < weights.size(); ++i)
         {
-            if (weights[i] != 0)
+            if (weights[i] != 0) {
                 LOG4CXX_DEBUG(logger, "anncore_behav::configWeigths(): setting weight of synapse " << i << " to " << (int)weights[i]);
+            }
 
             _weights[i] = weights[i];
         }
@@ -429,8 +472,7 @@ unsigned int anncore_behav::initializeNeurons(
 		for(;it_fdna != it_fdna_end; ++it_fdna)
 		{
 			unsigned int denmem_id = it_fdna->first;
-			unsigned int l1_address = it_fdna->second;
-            LOG4CXX_DEBUG(logger, "Processing denmem " << denmem_id << " with address " << l1_address);
+            LOG4CXX_DEBUG(logger, "Processing denmem " << denmem_id << " with address " << it_fdna->second);
 			snprintf(buffer,sizeof(buffer),"anncore_i%i_compound_neuron_i%i",_anncore_id,denmem_id);
 			unsigned int wta_id = (denmem_id%256)/32;
 
@@ -438,7 +480,7 @@ unsigned int anncore_behav::initializeNeurons(
             getConnectedDenmems(connected_denmems, denmems2nrns, _hw_neuron_count, denmem_id);
             LOG4CXX_DEBUG(logger, "Number of denmem connected to this neuron: " << connected_denmems.size() << ": ");
 
-			CompoundNeuronModule* cmn = new CompoundNeuronModule(buffer,connected_denmems.size(), denmem_id, wta_id, &(this->out_port));
+			CompoundNeuronModule* cmn = new CompoundNeuronModule(buffer,connected_denmems.size(), denmem_id, wta_id, &_spike_release);
 			_compound_neurons.push_back(cmn);
 			_firing_denmem_2_compound_neuron[denmem_id] = cmn;
 
@@ -456,6 +498,10 @@ unsigned int anncore_behav::initializeNeurons(
 			++_hw_neuron_count;
 		}
 
+		// each neuron fires at most once per tick, so this many spikes can be in flight at once
+		_spike_release.reserve(_compound_neurons.size() *
+				(L1_DELAY_REP_TO_DENMEM/CompoundNeuronModule::tick_period_ns + 1));
+
 		_hw_neurons_created = true;
 	} else {
         LOG4CXX_ERROR(logger, "anncore_behav"<< _anncore_id << ": initializeNeurons() called several times. Which is currently not supported.");
@@ -518,12 +564,13 @@ unsigned int anncore_behav::get_6_bit_address( unsigned int denmem_id ) const
 	}
 }
 
-void anncore_behav::configCompoundNeuron( unsigned int denmem_id, unsigned int addr, bool rec, std::string fn, double dt)
+void anncore_behav::configCompoundNeuron( unsigned int denmem_id, unsigned int addr, bool rec, std::string fn, double dt,
+		ESS::voltage_trace_config const& trace_cfg)
 {
 	if ( _firing_denmem_2_compound_neuron.find(denmem_id) != _firing_denmem_2_compound_neuron.end() )
 	{
 		CompoundNeuronModule* cmn = _firing_denmem_2_compound_neuron[denmem_id];
-		cmn->init(addr%L1_ADDR_RANGE, rec, fn,dt);
+		cmn->init(addr%L1_ADDR_RANGE, rec, fn, dt, trace_cfg);
         LOG4CXX_DEBUG(logger, "Hardware Neuron (Denmem) " << denmem_id << "configured.");
 	}
 	else {
@@ -531,6 +578,17 @@ void anncore_behav::configCompoundNeuron( unsigned int denmem_id, unsigned int a
 	}
 }
 
+void anncore_behav::setADCTrace( unsigned int denmem_id, ess::ring_buffer<uint16_t>* trace)
+{
+	auto it = _firing_denmem_2_compound_neuron.find(denmem_id);
+	if ( it != _firing_denmem_2_compound_neuron.end() ) {
+		it->second->setADCTrace(trace);
+	}
+	else {
+        LOG4CXX_WARN(logger, "Trying to attach an ADC to denmem (" << denmem_id << "), for which no hw_neuron exists. Not doing anything.");
+	}
+}
+
 hw_neuron * anncore_behav::get_neuron(unsigned int nrn)
 {
 	auto it = _firing_denmem_2_hw_neuron.find(nrn);
@@ -11,7 +11,7 @@
 
 #include "systemc.h"
 
-#include "mutexfile.h"
+#include "async_writer.h"
 #include "anncore_task_if.h"
 #include "anncore_pulse_if.h"
 #include "syndriver.h"
@@ -66,12 +66,14 @@ class anncore_behav :
 		std::vector< CompoundNeuronModule* > _compound_neurons;
 		/** map of firing denmems to compound neurons */
 		std::map<unsigned int, CompoundNeuronModule*> _firing_denmem_2_compound_neuron;
+		/** delays and releases the output spikes of all compound neurons */
+		SpikeReleaseScheduler _spike_release;
 
         //**********************************
         //Implementation of Current Stimulus
         //**********************************
         
-        sc_clock _clock;
+        sc_light_clock _clock;
 
         //struct for current stimulus
         struct CurrentStimulus
@@ -108,7 +110,7 @@ class anncore_behav :
                                     unsigned int const hw_neuron_id,
                                     unsigned int const denmem_id) const;
     protected:
-		ess::mutexfile& spike_rx_file;	///<FILE handle for recording of received events
+		ess::async_file& spike_rx_file;	///<FILE handle for recording of received events
 
 	public:
 	    /// SC_HAS_PROCESS needed for declaration of SC_METHOD if not using SC_CTOR for current stimuli
@@ -117,7 +119,7 @@ class anncore_behav :
 		anncore_behav (
 				const sc_module_name& anncore_i,    //!< module instance name
 				short _anncore_id,                  //!< ID of this ANNCORE
-				ess::mutexfile& spike_rcx_file,     //!< FILE to handle recording of received events
+				ess::async_file& spike_rcx_file,     //!< FILE to handle recording of received events
 				uint8_t PLL_period_ns,              //!< Period of the PLL
                 bool enable_spike_debugging         //!< Flag for spike_debugging
                 );
@@ -219,7 +221,15 @@ class anncore_behav :
 				unsigned int addr,  //!< 9-bit address: first 3-bit for wta, and 6-bit for l1-address on wta.
 				bool rec,  //!< if flag is true, voltage of this neuron will be recorded.
 				std::string fn,  //!< string of filename, to which the voltage shall be recorded.
-				double dt  //!< integration time-step for this neuron
+				double dt,  //!< integration time-step for this neuron
+				ESS::voltage_trace_config const& trace_cfg //!< format, decimation and tolerance of the voltage recording
+				);
+
+		/** attach the in-memory sample buffer of a virtual ADC to a compound neuron.
+		 * Must be called before configCompoundNeuron().*/
+		void setADCTrace(
+				unsigned int denmem_id, //< id of firing denmem.
+				ess::ring_buffer<uint16_t>* trace //!< sample buffer, owned by HALaccess
 				);
 
 		/** Print Configuration  of Anncore to a file for Debugging */
@@ -231,5 +241,22 @@ class anncore_behav :
 
         void disable_weight_distortion();
 
+		/** enables or disables the output spikes of all neurons.
+		 * Used to silence the anncore while the system is drained between two runs.*/
+		void set_output_enable(bool enable);
+
+		/** completes the voltage recordings of a run, which is not ended by sc_stop().*/
+		void finish_run();
+
+		/** resets the dynamic state for a new run starting at `origin`:
+		 * neuron state variables and recordings, STP state of the syndrivers,
+		 * pending output spikes and current stimuli.
+		 * The configuration is kept.*/
+		void reset(sc_time const& origin);
+
+		/** stores or restores the dynamic state: current stimuli, STP state of the syndrivers,
+		 * pending output spikes and the compound neurons.*/
+		void checkpoint(ess::state_archive& ar);
+
 };
 #endif //ANNCORE_BEHAV_H
@@ -1,6 +1,7 @@
 #include "bg_event_generator.h"
 #include "merger_pulse_if.h"
 #include "sim_def.h"
+#include "state_archive.h"
 #include <bitset>
 
 bg_event_generator::bg_event_generator(
@@ -38,6 +39,13 @@ bg_event_generator::reset_n(
 	}
 }
 
+void
+bg_event_generator::reset() {
+	next_spike.cancel();
+	_lfsr = 1u;
+	_can_fire = false;
+}
+
 void
 bg_event_generator::release_spike() {
 	// note that, that an existing event in the input[1] of _bg_merger is overwritten here.
@@ -81,3 +89,11 @@ bg_event_generator::generate_spike() {
 	next_spike.notify(cycles*_PLL_period_ns, SC_NS); // sys_clock_period = 5 ns
 }
 
+
+void
+bg_event_generator::checkpoint(ess::state_archive& ar) {
+	ar.section(name());
+	ar.value(_can_fire);
+	ar.value(_lfsr);
+	ar.event(next_spike);
+}
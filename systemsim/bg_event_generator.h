@@ -5,9 +5,12 @@
 
 #include <stdint.h>
 
+#include "timed_event.h"
+
 
 // pre-declaration
 class merger_pulse_if;
+namespace ess { class state_archive; }
 
 /** The Background Event Generator class.
  * Models a Background event generators.
@@ -38,6 +41,13 @@ public:
 			uint16_t seed  //!< initialize LFSR to this seed, if enable=1
 			);
 
+	/** stops the event generator and sets its state (LFSR, evout) to the state after construction.
+	 * The configuration (random, addr, period) is kept.*/
+	void reset();
+
+	/** stores or restores the LFSR and the next scheduled spike.*/
+	void checkpoint(ess::state_archive& ar);
+
 	/** constructor.
 	 */
 	bg_event_generator(
@@ -68,7 +78,7 @@ private:
 	short _addr; //!< 6-bit l1-address
 	uint16_t _lfsr; //!< state of the linear feedback shift register
 	uint16_t _period; //!< event period in sysclock cycles (4ns) (not 0)
-	sc_event next_spike; ///< triggers spike_out()
+	ess::timed_event next_spike; ///< triggers spike_out()
     uint8_t _PLL_period_ns;
 };
 #endif // _bg_event_generator_h_
@@ -26,16 +26,11 @@ void dnc_if::rx_l2_ctrl()
 
 	if(this->dnc_channel_i->fifo_rx_event.num_available())
 	{
-		uint value = 0;
-		sc_uint<L2_EVENT_WIDTH> out;
+		uint32_t value = 0;
 
 		this->dnc_channel_i->fifo_rx_event.nb_read(value);
-		//cout << "DNC_IF: ENTER rx_pls_l2_ctrl " << value << endl;
-		//printf("ENTER rx_pls_l2_ctrl %.8X, at time: %i\n",value, (unsigned int) sc_simulation_time());fflush(stdout);
-		out = value;
-		//cout << "@ " << sc_simulation_time() << "From L1: " << hex << value << " from " << id << "\n";
-		this->receive_event(out);
-		LostEventLogger::count_dnc_if_rx_l2_ctrl();
+		this->receive_event(ess::l2_event::from(value));
+		LostEventLogger::count_dnc_if_rx_l2_ctrl(hicannid);
 	} else if(this->dnc_channel_i->fifo_rx_cfg.num_available())
 	{
 		this->dnc_channel_i->fifo_rx_cfg.nb_read(value_cfg);
@@ -58,7 +53,7 @@ void dnc_if::l1_task_if(const unsigned char& channel, const unsigned char& _nrni
 		{
 			// pulse_event.notify();
             LOG4CXX_DEBUG(logger, "DNC_IF: Start Layer1 Pulse L1->DNC: nrnid=" << (uint) _nrnid << ", channel=" << (uint) channel << ", hicannid=" << hicannid << ", @time=" << sc_time_stamp());
-			LostEventLogger::count_dnc_if_l1_task_if();
+			LostEventLogger::count_dnc_if_l1_task_if(hicannid);
 			start_pulse_dnc();
 		} else {
             LOG4CXX_WARN(logger, "DNC_IF: StoppedLayer1 Pulse L1->DNC: nrnid=" << (uint) _nrnid << ", channel=" << (uint) channel << ", hicannid=" << hicannid << ", @time=" << sc_time_stamp() << ". Direction of this Bus is set towards HICANN");
@@ -74,37 +69,34 @@ void dnc_if::start_pulse_dnc()
 {
 	// divide simtime by 4 to get system clock cycles
     LOG4CXX_DEBUG(logger, "DNC_IF: Pulse send to DNC: nrnid " << (unsigned int) nrnid);
-	dnc_channel_i -> start_event(((nrnid & 0xfff)<<TIMESTAMP_WIDTH) + (((uint)(sim_time)>>2) & 0x7fff));
-	LostEventLogger::count_dnc_if_start_pulse_dnc();
+	dnc_channel_i -> start_event(ess::l2_event::make(nrnid, (uint)(sim_time)>>2));
+	LostEventLogger::count_dnc_if_start_pulse_dnc(hicannid);
 }
 
 
 /// external interface for l2 packet receive.
 /// upper bits of packets selects layer1 channel
 /// @param l1event: l2 packet with [L1_Bus_nr + Neuron_nr + Timestamp]
-void dnc_if::receive_event(const sc_uint<L2_EVENT_WIDTH>& l1event)
+void dnc_if::receive_event(ess::l2_event l1event)
 {
-	unsigned int channel = l1event.to_uint() >> (TIMESTAMP_WIDTH+L1_ADDR_WIDTH);
+	unsigned int channel = l1event.l1bus();
 	if (enable[channel]) {
 		// check here if l1_bus is configured in direction DNC->L1
 		if(l1direction[channel]==TO_HICANN){
-			l2tol1_tx_i[channel]->transmit(l1event & 0x3ffffff);
-			LostEventLogger::count_dnc_if_receive_event();
-			char buffer[256];
-			sprintf(buffer, "DNC_IF: %X :\t received DNC event @ HICANN %i DNC_IF %.8X in channel %i\n",(unsigned int)sc_simulation_time(), hicannid, l1event.to_uint(),channel);
-            LOG4CXX_DEBUG(logger, buffer);
+			l2tol1_tx_i[channel]->transmit(l1event);
+			LostEventLogger::count_dnc_if_receive_event(hicannid);
+            LOG4CXX_DEBUG(logger, "DNC_IF: " << hex << (unsigned int)sc_simulation_time() << " :\t received DNC event @ HICANN " << dec << hicannid
+					<< " DNC_IF " << hex << l1event.value << dec << " in channel " << channel);
 		}	
 		else {
-			char buffer[256];
-			sprintf(buffer, "DNC_IF: WARNING::%X :\t received invalid DNC event @ HICANN %i DNC_IF %.8X in channel %i: l1direction is set to TOWARDS_DNC!\n",(unsigned int)sc_simulation_time(), hicannid, l1event.to_uint(),channel);
-            LOG4CXX_WARN(logger, buffer);
-			LostEventLogger::log(/*downwards*/ true, name());
+            LOG4CXX_WARN(logger, "DNC_IF: WARNING::" << hex << (unsigned int)sc_simulation_time() << " :\t received invalid DNC event @ HICANN " << dec << hicannid
+					<< " DNC_IF " << hex << l1event.value << dec << " in channel " << channel << ": l1direction is set to TOWARDS_DNC!");
+			LostEventLogger::log(/*downwards*/ true, name(), hicannid);
 		}
 	} else {
-		char buffer[256];
-		sprintf(buffer, "DNC_IF: WARNING::%X :\t received DNC event @ HICANN %i DNC_IF %.8X in channel %i: which is DISABLED\n",(unsigned int)sc_simulation_time(), hicannid, l1event.to_uint(),channel);
-        LOG4CXX_WARN(logger, buffer);
-		LostEventLogger::log(/*downwards*/ true, name());
+        LOG4CXX_WARN(logger, "DNC_IF: WARNING::" << hex << (unsigned int)sc_simulation_time() << " :\t received DNC event @ HICANN " << dec << hicannid
+				<< " DNC_IF " << hex << l1event.value << dec << " in channel " << channel << ": which is DISABLED");
+		LostEventLogger::log(/*downwards*/ true, name(), hicannid);
 	}
 }
 
@@ -127,3 +119,11 @@ void dnc_if::set_enables(const std::vector<bool>& enables) {
 		enable[i] = enables[i];
 	}
 }
+
+void dnc_if::checkpoint(ess::state_archive& ar)
+{
+	ar.section(name());
+	dnc_channel_i->checkpoint(ar);
+	for (size_t i = 0; i < DNCL1BUSINCOUNT; ++i)
+		l2tol1_tx_i[i]->checkpoint(ar);
+}
@@ -44,7 +44,7 @@ public:
 		TO_HICANN= 1
 	};
 	short hicannid; ///< identification number of hicann
-	sc_clock clk;
+	sc_light_clock clk;
 
 	direction l1direction[DNCL1BUSINCOUNT]; ///< direction of channels TO_DNC, TO_HICANN
 	bool enable[DNCL1BUSINCOUNT]; ///< enable of channels: true means enabled
@@ -106,11 +106,13 @@ public:
 			const unsigned char& channel, //!< channel id (0..7)
 			const unsigned char& _nrnid //!< 6-bit neuron id
 			);
-	void receive_event(const sc_uint<L2_EVENT_WIDTH>&);
+	void receive_event(ess::l2_event);
 	/// sets direction for each L2toL1 channel.
 	void set_directions(const std::vector< enum dnc_if::direction >& directions);
 	/// sets enable for each L2toL1 channel.
 	void set_enables(const std::vector<bool>& enables);
+	/// stores or restores the dynamic state of the channel and the L2toL1 delay lines.
+	void checkpoint(ess::state_archive& ar);
 
 protected:
 	Logger& log; ///< Logger for a unique outputstream for debugging.
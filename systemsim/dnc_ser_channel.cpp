@@ -25,9 +25,9 @@ static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("ESS.Layer2");
 /// It is accessed by sc_port of another dnc_ser_channel in a DNC or a DNC_IF.
 /// It receives a pulse events and saves it temporarally. 
 /// In parallel it generates an event for further event handling.
-void dnc_ser_channel::receive_event (const sc_uint<L2_EVENT_WIDTH>& rx_event)
+void dnc_ser_channel::receive_event (ess::l2_event rx_event)
 {
-    event = rx_event.to_uint();
+    event = rx_event;
     receive_sc_event.notify();
 	LostEventLogger::count_dnc_ser_channel_receive_event(side==DNC_IF);
     LOG4CXX_DEBUG(logger, name() << "::receive event: " << event << " @ " << (uint)sc_simulation_time() );
@@ -64,7 +64,7 @@ void dnc_ser_channel::write_fifo()
 {
 	if(fill_fifo_lock)
 	{
-		if(this->fifo_rx_event.nb_write(event_save))
+		if(this->fifo_rx_event.nb_write(event_save.value))
 			LostEventLogger::count_dnc_ser_channel_write_fifo(side==DNC_IF);
 		else
 			LostEventLogger::log(/*downwards*/ side==DNC_IF, name());
@@ -99,12 +99,12 @@ void dnc_ser_channel::write_cfg_fifo()
 
 /// Function to transmit events to network.
 /// If data in tx_fifo and if SERDES time is reached.
-/// Checks permanently the status of the transmit memories. 
+/// Checks the status of the transmit memories, when triggered by trigger_transmit().
 /// If data is available in config or pulse event FIFO, 
 /// it reads FIFO and generates event for transmission delayed by serialization time.
 void dnc_ser_channel::transmit()
 {
-	uint data;
+	uint32_t data;
 	if(this->fifo_tx_cfg.num_available() && !transmit_lock)
 	{
 		transmit_lock = true;
@@ -121,13 +121,27 @@ void dnc_ser_channel::transmit()
 	}
 }
 
+/// The link is serialized at the clock edges only, hence a packet departs at the first edge,
+/// at which it is enqueued and the previous packet has arrived.
+void dnc_ser_channel::trigger_transmit()
+{
+	transmit_trigger.notify_next_edge(sc_time(CLK_PER_DNC_SER_CHANNEL, SC_NS));
+}
+
 /// Transmits pulse event by accessing TBV port. 
 void dnc_ser_channel::transmit_start_event()
 {
 	if(transmit_lock)
 	{
-		l2_dnc_if->receive_event((uint)value);
+		// the channel is not bound, if the HICANN is not used and hence not instantiated.
+		// Only channels of the DNC are left unbound, so the event was sent downwards.
+		if (l2_dnc_if.size())
+			l2_dnc_if->receive_event(ess::l2_event::from(value));
+		else
+			LostEventLogger::log(/*downwards*/ true, name());
 		transmit_lock = false;
+		// packets enqueued in this delta cycle are not visible yet, hence trigger unconditionally
+		trigger_transmit();
 		LostEventLogger::count_dnc_ser_channel_transmit_start_event(side==DNC);
 	}
 }
@@ -138,19 +152,23 @@ void dnc_ser_channel::transmit_start_cfg()
 	if(transmit_lock)
 	{
 //			printf("in DNC transmit start cfg: %.8X %.8X @ %i\n",(value >> MEM_DATA_WIDTH)&0xffffffff,(value)&0xffffffff,(uint)sc_simulation_time());
-		l2_dnc_if->receive_config(value);
+		if (l2_dnc_if.size())
+			l2_dnc_if->receive_config(value);
 		transmit_lock = false;
+		trigger_transmit();
 	}
 }
 
 
 /// Access for transmitter for pulse event transmission.
-void dnc_ser_channel::start_event(const sc_uint<L2_EVENT_WIDTH>& event)
+void dnc_ser_channel::start_event(ess::l2_event event)
 {
-	if(this->heap_tx_mem.insert(event.to_uint()))
+	if(this->heap_tx_mem.insert(event.value))
 		LostEventLogger::count_dnc_ser_channel_start_event(side==DNC);
 	else
 		LostEventLogger::log(/*downwards*/ side==DNC, name());
+	if (!transmit_lock)
+		trigger_transmit();
 }
 
 /// Access for transmitter for configuration transmission.
@@ -160,4 +178,27 @@ void dnc_ser_channel::start_config(const sc_uint<L2_CFGPKT_WIDTH>& cfg_data)
 //	cout << name() << ": cfg_data = " << cfg_data << endl;
 //	printf("in DNC start cfg: %.8X %.8X @ %i\n",(value >> MEM_DATA_WIDTH)&0xffffffff,(value)&0xffffffff,(uint)sc_simulation_time());
 	this->fifo_tx_cfg.nb_write(value);
+	if (!transmit_lock)
+		trigger_transmit();
+}
+
+void dnc_ser_channel::checkpoint(ess::state_archive& ar)
+{
+	ar.section(name());
+	heap_tx_mem.checkpoint(ar);
+	ar.fifo(fifo_rx_event);
+	ar.fifo(fifo_rx_cfg);
+	ar.fifo(fifo_tx_cfg);
+	ar.value(fill_fifo_lock);
+	ar.value(transmit_lock);
+	ar.value(value);
+	ar.value(event.value);
+	ar.value(event_save.value);
+	ar.value(cfg_packet);
+	ar.value(cfg_packet_save);
+	ar.event(write_fifo_event);
+	ar.event(write_fifo_cfg);
+	ar.event(transmit_event);
+	ar.event(transmit_cfg);
+	ar.event(transmit_trigger);
 }
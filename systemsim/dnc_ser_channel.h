@@ -41,10 +41,9 @@ public:
 	SIDE side;
 	void set_side(enum SIDE side_){side=side_;}
 
-	sc_clock clk;
 	//heap_mem<uint> heap_tx_mem; 	///< transmit heap mem for pulse events
-    ess::sized_queue<uint> heap_tx_mem; 	///< transmit heap mem for pulse events
-	sc_fifo<uint> fifo_rx_event; 	///< receive FIFO for pulse events
+    ess::sized_queue<uint32_t> heap_tx_mem; 	///< transmit heap mem for pulse events (ess::l2_event::value)
+	sc_fifo<uint32_t> fifo_rx_event; 	///< receive FIFO for pulse events (ess::l2_event::value)
 	sc_fifo<uint64> fifo_rx_cfg;	///< receive FIFO for configuration
 	sc_fifo<uint64> fifo_tx_cfg;	///< transmit FIFO for configuration
 
@@ -57,26 +56,26 @@ public:
 
 	//data
 	uint64 value;
-	uint event;
-	uint event_save;
+	ess::l2_event event;
+	ess::l2_event event_save;
 	uint64 cfg_packet;
 	uint64 cfg_packet_save;
 
 	//events
 	sc_event receive_sc_event;
 	sc_event receive_cfg;
-	sc_event write_fifo_event;
-	sc_event write_fifo_cfg;
-	sc_event transmit_event;
-	sc_event transmit_cfg;
+	ess::timed_event write_fifo_event;
+	ess::timed_event write_fifo_cfg;
+	ess::timed_event transmit_event;
+	ess::timed_event transmit_cfg;
+	ess::timed_event transmit_trigger; ///< next clock edge, at which a packet can be sent
 
 	SC_HAS_PROCESS(dnc_ser_channel);
 
 	// constructor
 
 	dnc_ser_channel (sc_module_name dnc_ser_channel_i)
-		: clk("clk",CLK_PER_DNC_SER_CHANNEL,SC_NS)
-		, heap_tx_mem(CHANNEL_MEM_SIZE_OUT)
+		: heap_tx_mem(CHANNEL_MEM_SIZE_OUT)
 		, fifo_rx_event(CHANNEL_MEM_SIZE_IN)
 		, fifo_rx_cfg(CHANNEL_MEM_SIZE_IN)
 		, fifo_tx_cfg(CHANNEL_MEM_SIZE_OUT)
@@ -86,9 +85,11 @@ public:
 	{
 		static_cast<void>(dnc_ser_channel_i);
 
+		// transmit is only triggered, when a packet is enqueued or the link gets free.
+		// It runs at the edges of a clock with period CLK_PER_DNC_SER_CHANNEL.
         SC_METHOD(transmit);
 		dont_initialize();
-		sensitive_pos << clk;
+		sensitive << transmit_trigger;
 
 		SC_METHOD(fill_fifo);
 		dont_initialize();
@@ -116,19 +117,23 @@ public:
 
 	}
 
-	void start_event(const sc_uint<L2_EVENT_WIDTH>&);
+	void start_event(ess::l2_event);
 	void start_config(const sc_uint<L2_CFGPKT_WIDTH>&);
 	void transmit_start_event();
 	void transmit_start_cfg();
 	void transmit();
+	/// triggers transmit at the next clock edge
+	void trigger_transmit();
 	bool can_transmit() const{ return !transmit_lock;}
 	void fill_fifo();
 	void write_fifo();
 	void fill_cfg_fifo();
 	void write_cfg_fifo();
 
+	/// stores or restores the dynamic state
+	void checkpoint(ess::state_archive& ar);
 
-	virtual void receive_event(const sc_uint<L2_EVENT_WIDTH>&);
+	virtual void receive_event(ess::l2_event);
 	/// interface for config packets.
 	virtual void receive_config(const sc_uint<L2_CFGPKT_WIDTH>&);
 
@@ -17,9 +17,9 @@
 #include "lost_event_logger.h"
 
 /// Function to get events from network.
-void dnc_tx_fpga::receive_event (const sc_uint<HYP_EVENT_WIDTH>& rx_event)
+void dnc_tx_fpga::receive_event (ess::l2_event rx_event)
 {
-    event = rx_event.to_uint64();
+    event = rx_event;
     receive_sc_event.notify();
 	LostEventLogger::count_dnc_tx_fpga_receive_event(side==DNC);
 }
@@ -58,7 +58,7 @@ void dnc_tx_fpga::write_fifo()
 {
 	if(fill_fifo_lock)
 	{
-		if(this->fifo_rx_event.nb_write(event_save))
+		if(this->fifo_rx_event.nb_write(event_save.value))
 			LostEventLogger::count_dnc_tx_fpga_write_fifo(side==DNC);
 		else
 			LostEventLogger::log(/*downwards*/ side==DNC, name());
@@ -83,7 +83,9 @@ void dnc_tx_fpga::transmit()
 		if(this->fifo_tx_event.num_available() && !transmit_lock)
 		{
 			transmit_lock = true;
-			fifo_tx_event.nb_read(value);
+			uint32_t event_value;
+			fifo_tx_event.nb_read(event_value);
+			value = event_value;
 			transmit_event.notify(TIME_HYP_OUT_PULSE,SC_NS);
 			LostEventLogger::count_dnc_tx_fpga_transmit(side==FPGA);
 //			printf("in Fpga transmit pls: %.16X @ %i\n",value,(uint)sc_simulation_time());
@@ -97,12 +99,21 @@ void dnc_tx_fpga::transmit()
 		}
 }
 
+/// The link is serialized at the clock edges only, hence a packet departs at the first edge,
+/// at which it is enqueued and the previous packet has arrived.
+void dnc_tx_fpga::trigger_transmit()
+{
+	transmit_trigger.notify_next_edge(sc_time(CLK_PER_DNC_TX_FPGA, SC_NS));
+}
+
 void dnc_tx_fpga::transmit_start_event()
 {
 		if(transmit_lock)
 		{
-            l2_dncfpga_if->receive_event(value);
+            l2_dncfpga_if->receive_event(ess::l2_event::from(value));
 			transmit_lock = false;
+			// packets enqueued in this delta cycle are not visible yet, hence trigger unconditionally
+			trigger_transmit();
 			LostEventLogger::count_dnc_tx_fpga_transmit_start_event(side==FPGA);
 		}
 }
@@ -113,16 +124,18 @@ void dnc_tx_fpga::transmit_start_cfg()
 		{
             l2_dncfpga_if->receive_config(value_target ,value);
 			transmit_lock = false;
+			trigger_transmit();
 		}
 }
 
 /// Function to externally write into tx_fifo.
-void dnc_tx_fpga::start_event(const sc_uint<HYP_EVENT_WIDTH>& event){
-//	printf("start_event dnc_tx_fpga packet: %.8X\n",event.to_uint());
-	if(this->fifo_tx_event.nb_write(event.to_uint()))
+void dnc_tx_fpga::start_event(ess::l2_event event){
+	if(this->fifo_tx_event.nb_write(event.value))
 		LostEventLogger::count_dnc_tx_fpga_start_event(side==FPGA);
 	else
 		LostEventLogger::log(/*downwards*/ side==FPGA, name());
+	if (!transmit_lock)
+		trigger_transmit();
 }
 
 void dnc_tx_fpga::start_cfg(const sc_uint<DNC_TARGET_WIDTH>& cfg_addr, const sc_uint<L2_CFGPKT_WIDTH>& cfg_data)
@@ -132,6 +145,8 @@ void dnc_tx_fpga::start_cfg(const sc_uint<DNC_TARGET_WIDTH>& cfg_addr, const sc_
 	//printf("in Fpga start cfg: target %i = %.8X %.8X @ %i\n",value_target,(value >> 32)&0xffffffff,(value)&0xffffffff,(uint)sc_simulation_time());
 	this->fifo_tx_cfg.nb_write(value);
 	this->fifo_tx_cfg_target.nb_write(value_target);
+	if (!transmit_lock)
+		trigger_transmit();
 }
 
 void dnc_tx_fpga::tx_instant_config(const ess::l2_packet_t& cfg_packet)
@@ -145,3 +160,31 @@ void dnc_tx_fpga::rx_instant_config(const ess::l2_packet_t& cfg_packet)
 		this->dnc_access->instant_config(cfg_packet);
 }
 
+
+void dnc_tx_fpga::checkpoint(ess::state_archive& ar)
+{
+	ar.section(name());
+	ar.fifo(fifo_tx_event);
+	ar.fifo(fifo_tx_cfg);
+	ar.fifo(fifo_tx_cfg_target);
+	ar.fifo(fifo_rx_event);
+	ar.fifo(fifo_rx_cfg);
+	ar.fifo(fifo_rx_cfg_target);
+	ar.value(fill_fifo_lock);
+	ar.value(transmit_lock);
+	ar.value(fill_cfg_fifo_lock);
+	ar.value(event.value);
+	ar.value(event_save.value);
+	ar.value(value);
+	ar.value(value_target);
+	ar.value(cfg_packet);
+	ar.value(cfg_packet_target);
+	ar.value(cfg_packet_save);
+	ar.value(cfg_packet_target_save);
+	ar.value(cfg_value);
+	ar.event(write_fifo_event);
+	ar.event(write_fifo_cfg_event);
+	ar.event(transmit_event);
+	ar.event(transmit_cfg);
+	ar.event(transmit_trigger);
+}
@@ -21,6 +21,7 @@
 #include "types.h"
 #include "l2_hyp_task_if.h"
 #include "l2_dnc.h"
+#include "state_archive.h"
 
 /// This class represents a hypertransport channel between one DNC and one FPGA.
 /// Each DNC has one of these channel, while each FPGA offers DNC_FPGA channel.
@@ -36,9 +37,7 @@ public:
 	void set_side(enum SIDE side_) { side = side_;}
 private:
 	// instantiations
-	sc_clock clk;
-
-	sc_fifo<uint64> fifo_tx_event;
+	sc_fifo<uint32_t> fifo_tx_event; ///< ess::l2_event::value
 	sc_fifo<uint64> fifo_tx_cfg;
 	sc_fifo<unsigned char> fifo_tx_cfg_target;
 
@@ -50,8 +49,8 @@ private:
 	bool side; // false = FPGA, true: DNC
 
 	//data
-	uint64 event;
-	uint64 event_save;
+	ess::l2_event event;
+	ess::l2_event event_save;
 	uint64 value;
 	unsigned char value_target;
 
@@ -62,18 +61,21 @@ private:
 	uint64 cfg_value;
 
 	sc_event receive_sc_event;
-	sc_event write_fifo_event;
+	ess::timed_event write_fifo_event;
 	sc_event receive_cfg_event;
-	sc_event write_fifo_cfg_event;
+	ess::timed_event write_fifo_cfg_event;
 
-	sc_event transmit_event;
-	sc_event transmit_cfg;
+	ess::timed_event transmit_event;
+	ess::timed_event transmit_cfg;
+	ess::timed_event transmit_trigger; ///< next clock edge, at which a packet can be sent
 
 	SC_HAS_PROCESS(dnc_tx_fpga);
 
 	// function declarations
 
 	void transmit();
+	/// triggers transmit at the next clock edge
+	void trigger_transmit();
 	void transmit_start_event();
 	void transmit_start_cfg();
 	void fill_fifo();
@@ -87,28 +89,31 @@ public:
 	sc_port< l2_hyp_task_if,1,SC_ZERO_OR_MORE_BOUND> l2_dncfpga_if;
 
 	// instantiations
-	sc_fifo<uint64> fifo_rx_event;
+	sc_fifo<uint32_t> fifo_rx_event; ///< ess::l2_event::value
 	sc_fifo<uint64> fifo_rx_cfg;
 	sc_fifo<unsigned char> fifo_rx_cfg_target;
 
 	l2_dnc *dnc_access;
 
-	void start_event(const sc_uint<HYP_EVENT_WIDTH>&);
+	void start_event(ess::l2_event);
 	void start_cfg(const sc_uint<DNC_TARGET_WIDTH>&, const sc_uint<L2_CFGPKT_WIDTH>&);
 	void tx_instant_config(const ess::l2_packet_t&);  // configuration at time 0
 	virtual void receive_config(const sc_uint<DNC_TARGET_WIDTH>&, const sc_uint<L2_CFGPKT_WIDTH>&); // interface for config packets
-	virtual void receive_event(const sc_uint<HYP_EVENT_WIDTH>&); // interface for pule event packets
+	virtual void receive_event(ess::l2_event); // interface for pule event packets
 	virtual void rx_instant_config(const ess::l2_packet_t&);  // configuration at time 0
 
+	/// stores or restores the dynamic state
+	void checkpoint(ess::state_archive& ar);
+
 	// constructor
 
 	dnc_tx_fpga (sc_module_name dnc_tx_fpga_i,l2_dnc *dnc_access)
-		: clk("clk",CLK_PER_DNC_TX_FPGA,SC_NS)
-		, fifo_tx_event(CHANNEL_HYP_SIZE_OUT)
+		: fifo_tx_event(CHANNEL_HYP_SIZE_OUT)
 		, fifo_tx_cfg(CHANNEL_HYP_SIZE_OUT)
 		, fifo_tx_cfg_target(CHANNEL_HYP_SIZE_OUT)
 		, fill_fifo_lock(false)
 		, transmit_lock(false)
+		, fill_cfg_fifo_lock(false)
 		// transaction streams and generators
 		, fifo_rx_event(CHANNEL_HYP_SIZE_IN)
 		, fifo_rx_cfg(CHANNEL_HYP_SIZE_IN)
@@ -117,9 +122,11 @@ public:
 	{
         static_cast<void>(dnc_tx_fpga_i);
 
+		// transmit is only triggered, when a packet is enqueued or the link gets free.
+		// It runs at the edges of a clock with period CLK_PER_DNC_TX_FPGA.
 		SC_METHOD(transmit);
 		dont_initialize();
-		sensitive_pos << clk;
+		sensitive << transmit_trigger;
 
 		SC_METHOD(transmit_start_event);
 		dont_initialize();
@@ -10,6 +10,7 @@
 #include "dnc_if.h"
 #include "spl1_merger.h"
 #include "l2_dnc.h"
+#include "state_archive.h"
 #include <log4cxx/logger.h>
 #include <stdexcept>
 
@@ -18,8 +19,8 @@ static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("ESS.HICANN");
 hicann_behav_V2::hicann_behav_V2(
 			sc_module_name hicann_i,   //!< instance name
 			short hicannid,            //!< identification id
-			mutexfile& spike_rcx_file, //!< FILE handle for received events
-			mutexfile& spike_tcx_file, //!< FILE handle for transmitted events
+			async_file& spike_rcx_file, //!< FILE handle for received events
+			async_file& spike_tcx_file, //!< FILE handle for transmitted events
 			std::string temp_folder,   //!< Folder for temporary and debug files during simulation
 			HALaccess* hala,           //!< Pointer to the Reference of HALaccess
 			short hicann_on_dnc
@@ -27,6 +28,7 @@ hicann_behav_V2::hicann_behav_V2(
 				,hicannid(hicannid)
 				,sim_folder(temp_folder)
 				,hal_access(hala)
+				,PLL_period_ns(0)
 {
     LOG4CXX_INFO(logger, "Building Hicann " << hicannid);
 
@@ -34,7 +36,7 @@ hicann_behav_V2::hicann_behav_V2(
     uint8_t PLL = hal_access->getPLLFrequency(hicannid);
     
     //calculate the PLL_period
-    unsigned int PLL_period_ns = 1000 / PLL; //calculate the period of the PLL (in MHz) in ns 
+    PLL_period_ns = 1000 / PLL; //calculate the period of the PLL (in MHz) in ns 
     
     LOG4CXX_DEBUG(logger, "Hicann: " << hicannid << " setting PLLFrequency to " << (int) PLL << " MHz correspoding to Period " << PLL_period_ns  << " ns");
 
@@ -51,6 +53,7 @@ hicann_behav_V2::hicann_behav_V2(
 	l1_behav_i = std::unique_ptr<l1_behav_V2>(new l1_behav_V2(hicannid, sim_folder, (const char *)hicann_i));
 	
 	dnc_if_i = std::shared_ptr<dnc_if>(new dnc_if("dnc_if_i",hicann_on_dnc));
+	dnc_if_i->dnc_channel_i->heap_tx_mem.set_pool(&pulse_pool_i);
 	
 	anncore_behav_i = std::shared_ptr<anncore_behav>(new anncore_behav("anncore_behav", hicannid, spike_rcx_file, PLL_period_ns,enable_spike_debugging));
 	
@@ -84,6 +87,60 @@ hicann_behav_V2::hicann_behav_V2(
 hicann_behav_V2::~hicann_behav_V2()
 {}
 
+void hicann_behav_V2::quiesce()
+{
+	anncore_behav_i->set_output_enable(false);
+	spl1_merger_i->reset_background();
+}
+
+void hicann_behav_V2::reconfigure(ESS::config_delta const& delta)
+{
+	LOG4CXX_INFO(logger, "Reconfiguring Hicann " << hicannid << ": synapses=" << delta.synapses
+			<< ", neuron parameters=" << delta.neuron_parameters);
+
+	if (delta.synapses)
+		config_synapses();
+
+	const std::map<unsigned int, unsigned int> dendrites2neurons = hal_access->getDendrites(x_coord, y_coord);
+	if (dendrites2neurons.empty())
+		return;
+
+	config_current_stimuli();
+
+	const std::map< unsigned int, unsigned int > firing_denmems_and_addresses = hal_access->getFiringDenmemsAndSPL1Addresses(x_coord, y_coord);
+	for (auto const& fdna : firing_denmems_and_addresses) {
+		const unsigned int dendrite = fdna.first;
+		if (delta.neuron_parameters) {
+			std::set< unsigned int > connected_denmems;
+			anncore_behav_i->getConnectedDenmems(connected_denmems, dendrites2neurons, dendrites2neurons.at(dendrite), dendrite);
+			for (auto connected : connected_denmems)
+				config_denmem(dendrite, connected);
+		}
+		// attaches the sample buffer of the ADC reading out this neuron, if any
+		anncore_behav_i->setADCTrace(dendrite, hal_access->getADCTraceBuffer(x_coord, y_coord, dendrite));
+	}
+}
+
+void hicann_behav_V2::reset(sc_time const& origin)
+{
+	anncore_behav_i->reset(origin);
+	// restarts the background event generators with their seeds
+	config_spl1_merger();
+}
+
+void hicann_behav_V2::finish_run()
+{
+	anncore_behav_i->finish_run();
+}
+
+void hicann_behav_V2::checkpoint(ess::state_archive& ar)
+{
+	ar.section(name());
+	dnc_if_i->checkpoint(ar);
+	anncore_behav_i->checkpoint(ar);
+	spl1_merger_i->checkpoint(ar);
+}
+
 /// function to get access to GraphModel for config of Hicann and Submodules
 void hicann_behav_V2::config_hicann(unsigned int id)
 {
@@ -111,7 +168,7 @@ void hicann_behav_V2::config_anncore()
 	if(nrns_on_hic>0)
 	{
 	// Get Global HW Parameters
-	auto global_parameters = hal_access->getGlobalHWParameters();	
+	auto const& global_parameters = hal_access->getGlobalHWParameters();	
 	double speedup = 10000;
 	double bio_timestep = 0.01;
 
@@ -142,63 +199,16 @@ void hicann_behav_V2::config_anncore()
         LOG4CXX_DEBUG(logger, "Global Parameter: Weight distortion disabled" );
         anncore_behav_i->disable_weight_distortion();
     }
-	unsigned int i,j;
-	// Configure Addresses
-	// first create vector with addresses and weights
-	std::vector<char> addresses;
-	std::vector<char> weights;
-	std::vector<char> syndr_mirrors;
-
-	////////////////////////////////////
-	//	Configuration of SYNAPSES
-	////////////////////////////////////
-
-	// initialize all addresses with the 4-bit address, that was chosen to disable a synapse and all weights to 0.
-	// FIXME: PM: refactor so that both mapping frameworks are compatible at once -> set disabled address in mapping, not here
-    const int tot_synapses = SYN_PER_ROW*ROWS_PER_SYNDRIVER*SYNDRIVERS*2;
-    addresses.resize(tot_synapses,HMF::HICANN::four_bit_address_disabling_synapse);
-	weights.resize(tot_synapses,0);		// init with 0 (inactive)
+	// Configure Addresses and weights
+	config_synapses();
 
-	// Synapse Access: get Configuration from HALbe
-	std::vector<std::vector<ESS::Synapse_t> > synapses = hal_access->getSynapses(x_coord, y_coord);
-    //make sure the sizes match
-    const int size_read = synapses.size()*synapses[0].size();
-    if (tot_synapses != size_read)
-    {
-        LOG4CXX_ERROR(logger, "On HICANN: " << hicannid << " Size of SynapseArrays does not match: Size expected = " << tot_synapses << " != Size read = " << size_read );
-        throw std::runtime_error("hicann_behav:  Size of SynapseArrays does not match");
-    }
-    LOG4CXX_INFO(logger, "Synapses read on Hicann " << hicannid << ".");
-
-	int syn_count = 0;
-    LOG4CXX_DEBUG(logger, "outer vector size: " << synapses.size() << " inner vector size: " << synapses[0].size() );
-
-	// Be careful here: structure of synapses vector vector: synapses[i=column][j=row]
-	for(i=0; i<synapses.size();i++){
-		for(j=0; j<synapses[i].size(); j++){
-			ESS::Synapse_t  current_synapse = synapses[i][j];
-			addresses[j*SYN_PER_ROW + i]=current_synapse.address;
-			weights[j*SYN_PER_ROW + i]=current_synapse.weight;
-			syn_count++;
-            //only log if the synapse is active (weight != 0)
-            if (current_synapse.weight != 0)
-            {
-                LOG4CXX_TRACE(logger, "Synapse[" << i << "][" << j << "]: address(" << (size_t)synapses[i][j].address << "), weight(" << (size_t)synapses[i][j].weight << ")" );
-		    }
-        }
-	}
-	
-	// Send CONFIG to ANNCORE	
-	anncore_behav_i->configAddressDecoders(addresses);
-	anncore_behav_i->configWeights(weights);
+	unsigned int i;
 
 	/////////////////////////////////////////////////////////
 	//<	Configuration of SYNDRIVERS	
     ///////////////////////////////////////////////////////////
-	std::vector< ESS::syndriver_cfg > syndr_config_left  = hal_access->getSyndriverConfig(x_coord, y_coord, ESS::HICANNSide::S_LEFT);
-	std::vector< ESS::syndriver_cfg > syndr_config_right = hal_access->getSyndriverConfig(x_coord, y_coord, ESS::HICANNSide::S_RIGHT);
-	std::vector< ESS::syndriver_cfg > syndr_config = syndr_config_left;
-	syndr_config.insert(syndr_config.end(), syndr_config_right.begin(), syndr_config_right.end());
+	std::vector< ESS::syndriver_cfg > const& syndr_config_left  = hal_access->getSyndriverConfig(x_coord, y_coord, ESS::HICANNSide::S_LEFT);
+	std::vector< ESS::syndriver_cfg > const& syndr_config_right = hal_access->getSyndriverConfig(x_coord, y_coord, ESS::HICANNSide::S_RIGHT);
 	// Get Syndriver Parameters
 	for(i=0;i<2*SYNDRIVERS;i++){
 
@@ -243,7 +253,7 @@ void hicann_behav_V2::config_anncore()
         }
 
 		// using data from config_struct:
-        ESS::syndriver_cfg& config = syndr_config.at(i);
+        ESS::syndriver_cfg const& config = (i < SYNDRIVERS) ? syndr_config_left.at(i) : syndr_config_right.at(i - SYNDRIVERS);
         anncore_behav_i->configSyndriver(i, config, syndrv_params.g_trafo_up, syndrv_params.g_trafo_down,
 				syndrv_params.tau_rec, syndrv_params.lambda, syndrv_params.N_dep, syndrv_params.N_fac);
 	}
@@ -252,14 +262,7 @@ void hicann_behav_V2::config_anncore()
     //< Configuration of current stimuli
     ////////////////////////////////////
     
-    ESS::StimulusContainer stim0 = hal_access->getCurrentStimulus(x_coord, y_coord, ESS::HICANNSide::S_LEFT, ESS::HICANNBlock::BL_UP); 
-    ESS::StimulusContainer stim1 = hal_access->getCurrentStimulus(x_coord, y_coord, ESS::HICANNSide::S_LEFT, ESS::HICANNBlock::BL_DOWN); 
-    ESS::StimulusContainer stim2 = hal_access->getCurrentStimulus(x_coord, y_coord, ESS::HICANNSide::S_RIGHT, ESS::HICANNBlock::BL_UP); 
-    ESS::StimulusContainer stim3 = hal_access->getCurrentStimulus(x_coord, y_coord, ESS::HICANNSide::S_RIGHT, ESS::HICANNBlock::BL_DOWN); 
-    anncore_behav_i->configCurrentStimulus(stim0, ESS::HICANNSide::S_LEFT, ESS::HICANNBlock::BL_UP); 
-    anncore_behav_i->configCurrentStimulus(stim1, ESS::HICANNSide::S_LEFT, ESS::HICANNBlock::BL_DOWN); 
-    anncore_behav_i->configCurrentStimulus(stim2, ESS::HICANNSide::S_RIGHT, ESS::HICANNBlock::BL_UP); 
-    anncore_behav_i->configCurrentStimulus(stim3, ESS::HICANNSide::S_RIGHT, ESS::HICANNBlock::BL_DOWN); 
+    config_current_stimuli();
 	
     ///////////////////////////////////////////////////
 	//<	Configuration of hw_neurons
@@ -314,30 +317,15 @@ void hicann_behav_V2::config_anncore()
 		anncore_behav_i->getConnectedDenmems(connected_denmems, dendrites2neurons, logical_neuron, dendrite);
 		for (auto connected : connected_denmems) {
 			//if (connected != dendrite ) {
-			ESS::BioParameter neuron_parameter = hal_access->getNeuronParametersSingleDenmem(x_coord, y_coord, connected);
-
-			LOG4CXX_DEBUG(logger, "NeuronParameters for dendrite " << dendrite << " on hicann " << hicannid);
-			//Logging all params
-			LOG4CXX_DEBUG(logger, "Parameter: g_l:        " << neuron_parameter.g_l         << " nS" );
-			LOG4CXX_DEBUG(logger, "Parameter: E_l:        " << neuron_parameter.v_rest      << " mV" );
-			LOG4CXX_DEBUG(logger, "Parameter: a:          " << neuron_parameter.a           << " nS" );
-			LOG4CXX_DEBUG(logger, "Parameter: tau_w:      " << neuron_parameter.tau_w       << " ms" );
-			LOG4CXX_DEBUG(logger, "Parameter: b:          " << neuron_parameter.b           << " nA" );
-			LOG4CXX_DEBUG(logger, "Parameter: V_exp:      " << neuron_parameter.v_thresh    << " mV" );
-			LOG4CXX_DEBUG(logger, "Parameter: delta_t:    " << neuron_parameter.delta_T     << " mV" );
-			LOG4CXX_DEBUG(logger, "Parameter: E_syn_i:    " << neuron_parameter.e_rev_I     << " mV" );
-			LOG4CXX_DEBUG(logger, "Parameter: E_syn_e:    " << neuron_parameter.e_rev_E     << " mV" );
-			LOG4CXX_DEBUG(logger, "Parameter: tau_syn_I:  " << neuron_parameter.tau_syn_I   << " ms" );
-			LOG4CXX_DEBUG(logger, "Parameter: tau_syn_E:  " << neuron_parameter.tau_syn_E   << " ms" );
-			LOG4CXX_DEBUG(logger, "Parameter: tau_refrac: " << neuron_parameter.tau_refrac  << " ms" );
-			LOG4CXX_DEBUG(logger, "Parameter: v_spike:    " << neuron_parameter.v_spike     << " mV" );
-			LOG4CXX_DEBUG(logger, "Parameter: V_reset:    " << neuron_parameter.v_reset     << " mV" );
-			LOG4CXX_DEBUG(logger, "Parameter: Cap:        " << neuron_parameter.cm          << " nF");
-
-			anncore_behav_i->configSingleDenmem(connected, neuron_parameter);
+			config_denmem(dendrite, connected);
 		}
+		// capture samples of primed ADCs in memory, independent of the voltage file
+		ESS::adc_trace* trace = hal_access->getADCTraceBuffer(x_coord, y_coord, dendrite);
+		if (trace)
+			anncore_behav_i->setADCTrace(dendrite, trace);
+
 		// Then configure and initialize compound neuron
-		anncore_behav_i->configCompoundNeuron(dendrite, it_fdna->second, rec, rec_file, hw_timestep);
+		anncore_behav_i->configCompoundNeuron(dendrite, it_fdna->second, rec, rec_file, hw_timestep, global_parameters.voltage_trace);
 	}
 
 	// current input
@@ -359,6 +347,97 @@ void hicann_behav_V2::config_anncore()
 }
 
 
+void hicann_behav_V2::config_synapses()
+{
+	unsigned int i,j;
+	// Configure Addresses
+	// first create vector with addresses and weights
+	std::vector<char> addresses;
+	std::vector<char> weights;
+	std::vector<char> syndr_mirrors;
+
+	////////////////////////////////////
+	//	Configuration of SYNAPSES
+	////////////////////////////////////
+
+	// initialize all addresses with the 4-bit address, that was chosen to disable a synapse and all weights to 0.
+	// FIXME: PM: refactor so that both mapping frameworks are compatible at once -> set disabled address in mapping, not here
+    const int tot_synapses = SYN_PER_ROW*ROWS_PER_SYNDRIVER*SYNDRIVERS*2;
+    addresses.resize(tot_synapses,HMF::HICANN::four_bit_address_disabling_synapse);
+	weights.resize(tot_synapses,0);		// init with 0 (inactive)
+
+	// Synapse Access: get Configuration from HALbe
+	std::vector<std::vector<ESS::Synapse_t> > const& synapses = hal_access->getSynapses(x_coord, y_coord);
+    //make sure the sizes match
+    const int size_read = synapses.size()*synapses[0].size();
+    if (tot_synapses != size_read)
+    {
+        LOG4CXX_ERROR(logger, "On HICANN: " << hicannid << " Size of SynapseArrays does not match: Size expected = " << tot_synapses << " != Size read = " << size_read );
+        throw std::runtime_error("hicann_behav:  Size of SynapseArrays does not match");
+    }
+    LOG4CXX_INFO(logger, "Synapses read on Hicann " << hicannid << ".");
+
+	int syn_count = 0;
+    LOG4CXX_DEBUG(logger, "outer vector size: " << synapses.size() << " inner vector size: " << synapses[0].size() );
+
+	// Be careful here: structure of synapses vector vector: synapses[i=column][j=row]
+	for(i=0; i<synapses.size();i++){
+		for(j=0; j<synapses[i].size(); j++){
+			ESS::Synapse_t const& current_synapse = synapses[i][j];
+			addresses[j*SYN_PER_ROW + i]=current_synapse.address;
+			weights[j*SYN_PER_ROW + i]=current_synapse.weight;
+			syn_count++;
+            //only log if the synapse is active (weight != 0)
+            if (current_synapse.weight != 0)
+            {
+                LOG4CXX_TRACE(logger, "Synapse[" << i << "][" << j << "]: address(" << (size_t)synapses[i][j].address << "), weight(" << (size_t)synapses[i][j].weight << ")" );
+		    }
+        }
+	}
+	
+	// Send CONFIG to ANNCORE	
+	anncore_behav_i->configAddressDecoders(addresses);
+	anncore_behav_i->configWeights(weights);
+}
+
+void hicann_behav_V2::config_current_stimuli()
+{
+    ESS::StimulusContainer const& stim0 = hal_access->getCurrentStimulus(x_coord, y_coord, ESS::HICANNSide::S_LEFT, ESS::HICANNBlock::BL_UP); 
+    ESS::StimulusContainer const& stim1 = hal_access->getCurrentStimulus(x_coord, y_coord, ESS::HICANNSide::S_LEFT, ESS::HICANNBlock::BL_DOWN); 
+    ESS::StimulusContainer const& stim2 = hal_access->getCurrentStimulus(x_coord, y_coord, ESS::HICANNSide::S_RIGHT, ESS::HICANNBlock::BL_UP); 
+    ESS::StimulusContainer const& stim3 = hal_access->getCurrentStimulus(x_coord, y_coord, ESS::HICANNSide::S_RIGHT, ESS::HICANNBlock::BL_DOWN); 
+    anncore_behav_i->configCurrentStimulus(stim0, ESS::HICANNSide::S_LEFT, ESS::HICANNBlock::BL_UP); 
+    anncore_behav_i->configCurrentStimulus(stim1, ESS::HICANNSide::S_LEFT, ESS::HICANNBlock::BL_DOWN); 
+    anncore_behav_i->configCurrentStimulus(stim2, ESS::HICANNSide::S_RIGHT, ESS::HICANNBlock::BL_UP); 
+    anncore_behav_i->configCurrentStimulus(stim3, ESS::HICANNSide::S_RIGHT, ESS::HICANNBlock::BL_DOWN); 
+}
+
+void hicann_behav_V2::config_denmem(unsigned int dendrite, unsigned int denmem)
+{
+	ESS::BioParameter neuron_parameter = hal_access->getNeuronParametersSingleDenmem(x_coord, y_coord, denmem);
+
+	static_cast<void>(dendrite); // only logged
+	LOG4CXX_DEBUG(logger, "NeuronParameters for denmem " << denmem << " of dendrite " << dendrite << " on hicann " << hicannid);
+	//Logging all params
+	LOG4CXX_DEBUG(logger, "Parameter: g_l:        " << neuron_parameter.g_l         << " nS" );
+	LOG4CXX_DEBUG(logger, "Parameter: E_l:        " << neuron_parameter.v_rest      << " mV" );
+	LOG4CXX_DEBUG(logger, "Parameter: a:          " << neuron_parameter.a           << " nS" );
+	LOG4CXX_DEBUG(logger, "Parameter: tau_w:      " << neuron_parameter.tau_w       << " ms" );
+	LOG4CXX_DEBUG(logger, "Parameter: b:          " << neuron_parameter.b           << " nA" );
+	LOG4CXX_DEBUG(logger, "Parameter: V_exp:      " << neuron_parameter.v_thresh    << " mV" );
+	LOG4CXX_DEBUG(logger, "Parameter: delta_t:    " << neuron_parameter.delta_T     << " mV" );
+	LOG4CXX_DEBUG(logger, "Parameter: E_syn_i:    " << neuron_parameter.e_rev_I     << " mV" );
+	LOG4CXX_DEBUG(logger, "Parameter: E_syn_e:    " << neuron_parameter.e_rev_E     << " mV" );
+	LOG4CXX_DEBUG(logger, "Parameter: tau_syn_I:  " << neuron_parameter.tau_syn_I   << " ms" );
+	LOG4CXX_DEBUG(logger, "Parameter: tau_syn_E:  " << neuron_parameter.tau_syn_E   << " ms" );
+	LOG4CXX_DEBUG(logger, "Parameter: tau_refrac: " << neuron_parameter.tau_refrac  << " ms" );
+	LOG4CXX_DEBUG(logger, "Parameter: v_spike:    " << neuron_parameter.v_spike     << " mV" );
+	LOG4CXX_DEBUG(logger, "Parameter: V_reset:    " << neuron_parameter.v_reset     << " mV" );
+	LOG4CXX_DEBUG(logger, "Parameter: Cap:        " << neuron_parameter.cm          << " nF");
+
+	anncore_behav_i->configSingleDenmem(denmem, neuron_parameter);
+}
+
 void hicann_behav_V2::config_dncif()
 {
 	unsigned int i;
@@ -393,70 +472,30 @@ void hicann_behav_V2::config_dncif()
 void hicann_behav_V2::config_l1net()
 {
     // start repeater config
-    std::vector<unsigned char> rep_config;
-
-	rep_config = hal_access->getRepeaterConfig(x_coord, y_coord, ESS::REP_L);
-	for(size_t rep_id = 0; rep_id < rep_config.size();++rep_id){
-		l1_behav_i->set_repeater_config( ESS::REP_L, rep_id, rep_config[rep_id] );
-	}
-
-	rep_config = hal_access->getRepeaterConfig(x_coord, y_coord, ESS::REP_R);
-	for(size_t rep_id = 0; rep_id < rep_config.size();++rep_id){
-		l1_behav_i->set_repeater_config( ESS::REP_R, rep_id, rep_config[rep_id] );
-	}
-
-	rep_config = hal_access->getRepeaterConfig(x_coord, y_coord, ESS::REP_UL);
-	for(size_t rep_id = 0; rep_id < rep_config.size();++rep_id){
-		l1_behav_i->set_repeater_config( ESS::REP_UL, rep_id, rep_config[rep_id] );
-	}
-
-	rep_config = hal_access->getRepeaterConfig(x_coord, y_coord, ESS::REP_UR);
-	for(size_t rep_id = 0; rep_id < rep_config.size();++rep_id){
-		l1_behav_i->set_repeater_config( ESS::REP_UR, rep_id, rep_config[rep_id] );
-	}
-
-	rep_config = hal_access->getRepeaterConfig(x_coord, y_coord, ESS::REP_DL);
-	for(size_t rep_id = 0; rep_id < rep_config.size();++rep_id){
-		l1_behav_i->set_repeater_config( ESS::REP_DL, rep_id, rep_config[rep_id] );
-	}
-
-	rep_config = hal_access->getRepeaterConfig(x_coord, y_coord, ESS::REP_DR);
-	for(size_t rep_id = 0; rep_id < rep_config.size();++rep_id){
-		l1_behav_i->set_repeater_config( ESS::REP_DR, rep_id, rep_config[rep_id] );
+	const ESS::RepeaterLocation rep_blocks[] = {ESS::REP_L, ESS::REP_R, ESS::REP_UL, ESS::REP_UR, ESS::REP_DL, ESS::REP_DR};
+	for (auto rep_block : rep_blocks) {
+		std::vector<unsigned char> const& rep_config = hal_access->getRepeaterConfig(x_coord, y_coord, rep_block);
+		for(size_t rep_id = 0; rep_id < rep_config.size();++rep_id){
+			l1_behav_i->set_repeater_config( rep_block, rep_id, rep_config[rep_id] );
+		}
 	}
 	// end of repeater config
 
 	// switch config
+	// the configuration is read in place from the HAL2ESS container
+	auto set_switch_config = [this](switch_loc switch_location, std::vector< std::vector<bool> > const& switch_config) {
+		for(size_t row_id = 0; row_id < switch_config.size(); ++row_id) {
+			l1_behav_i->set_switch_row_config(switch_location, row_id, switch_config[row_id]);
+		}
+	};
 
 	// enum switch_loc {CBL=0, CBR=1, SYNTL=2, SYNTR=3 ,SYNBL=4, SYNBR=5};
-	std::vector< std::vector<bool> > switch_config;
-	switch_config = hal_access->getCrossbarSwitchConfig(x_coord, y_coord, ESS::HICANNSide::S_LEFT);
-	for(size_t row_id = 0; row_id < switch_config.size(); ++row_id) {
-		l1_behav_i->set_switch_row_config(CBL, row_id, switch_config[row_id]);
-	}
-
-	switch_config = hal_access->getCrossbarSwitchConfig(x_coord, y_coord, ESS::HICANNSide::S_RIGHT);
-	for(size_t row_id = 0; row_id < switch_config.size(); ++row_id) {
-		l1_behav_i->set_switch_row_config(CBR, row_id, switch_config[row_id]);
-	}
-
-	switch_config = hal_access->getSyndriverSwitchConfig(x_coord, y_coord, ESS::HICANNBlock::BL_UP, ESS::HICANNSide::S_LEFT);
-	for(size_t row_id = 0; row_id < switch_config.size(); ++row_id) {
-		l1_behav_i->set_switch_row_config(SYNTL, row_id, switch_config[row_id]);
-	}
-	switch_config = hal_access->getSyndriverSwitchConfig(x_coord, y_coord, ESS::HICANNBlock::BL_UP, ESS::HICANNSide::S_RIGHT);
-	for(size_t row_id = 0; row_id < switch_config.size(); ++row_id) {
-		l1_behav_i->set_switch_row_config(SYNTR, row_id, switch_config[row_id]);
-	}
-
-	switch_config = hal_access->getSyndriverSwitchConfig(x_coord, y_coord, ESS::HICANNBlock::BL_DOWN, ESS::HICANNSide::S_LEFT);
-	for(size_t row_id = 0; row_id < switch_config.size(); ++row_id) {
-		l1_behav_i->set_switch_row_config(SYNBL, row_id, switch_config[row_id]);
-	}
-	switch_config = hal_access->getSyndriverSwitchConfig(x_coord, y_coord, ESS::HICANNBlock::BL_DOWN, ESS::HICANNSide::S_RIGHT);
-	for(size_t row_id = 0; row_id < switch_config.size(); ++row_id) {
-		l1_behav_i->set_switch_row_config(SYNBR, row_id, switch_config[row_id]);
-	}
+	set_switch_config(CBL, hal_access->getCrossbarSwitchConfig(x_coord, y_coord, ESS::HICANNSide::S_LEFT));
+	set_switch_config(CBR, hal_access->getCrossbarSwitchConfig(x_coord, y_coord, ESS::HICANNSide::S_RIGHT));
+	set_switch_config(SYNTL, hal_access->getSyndriverSwitchConfig(x_coord, y_coord, ESS::HICANNBlock::BL_UP, ESS::HICANNSide::S_LEFT));
+	set_switch_config(SYNTR, hal_access->getSyndriverSwitchConfig(x_coord, y_coord, ESS::HICANNBlock::BL_UP, ESS::HICANNSide::S_RIGHT));
+	set_switch_config(SYNBL, hal_access->getSyndriverSwitchConfig(x_coord, y_coord, ESS::HICANNBlock::BL_DOWN, ESS::HICANNSide::S_LEFT));
+	set_switch_config(SYNBR, hal_access->getSyndriverSwitchConfig(x_coord, y_coord, ESS::HICANNBlock::BL_DOWN, ESS::HICANNSide::S_RIGHT));
 	// end of switch config
     
     std::stringstream file_path_1;
@@ -466,7 +505,7 @@ void hicann_behav_V2::config_l1net()
 
 void hicann_behav_V2::config_spl1_merger()
 {
-	std::vector< std::vector<bool> > neuron_control_config = hal_access->getSPL1OutputMergerConfig(x_coord, y_coord);
+	std::vector< std::vector<bool> > const& neuron_control_config = hal_access->getSPL1OutputMergerConfig(x_coord, y_coord);
     
     LOG4CXX_DEBUG(logger, "SPL1 Merger config of Hicann " << x_coord << ", " << y_coord );
 	
@@ -11,9 +11,11 @@
 // always needed
 #include "systemc.h"
 #include <string>
-#include "mutexfile.h"
+#include "async_writer.h"
+#include "pulse_pool.h"
+#include "HAL2ESSContainer.h"
 
-using namespace ess; // for mutexfile
+using namespace ess; // for async_file
 
 // forward declarations
 class HALaccess;
@@ -21,6 +23,7 @@ class l1_behav_V2;
 class anncore_behav;
 class dnc_if;
 class spl1_merger;
+namespace ess { class state_archive; }
 
 /// The High Input Count Analog Neural Network (hicann) class.
 /// It instantiates: \n
@@ -36,8 +39,8 @@ public:
 	hicann_behav_V2(
 			sc_module_name hicann_i,   	//!< instance name
 			short hicannid,            	//!< identification id
-			mutexfile& spike_rcx_file, 	//!< FILE handle for received events
-			mutexfile& spike_tcx_file, 	//!< FILE handle for transmitted events
+			async_file& spike_rcx_file, 	//!< FILE handle for received events
+			async_file& spike_tcx_file, 	//!< FILE handle for transmitted events
 			std::string temp_folder,   	//!< Folder for temporary and debug files during simulation
 			HALaccess* hala,			//!< pointer to HALaccess
 			short hicann_on_dnc
@@ -49,6 +52,37 @@ public:
 	/** destructor*/
 	virtual ~hicann_behav_V2();
 
+	///////////////////////////////////////
+	// Reconfiguration between two runs  //
+	///////////////////////////////////////
+
+	/// silences the neurons and background event generators,
+	/// so that the pulses in flight can drain before the next run.
+	void quiesce();
+
+	/// applies the changed configuration from HALaccess to the existing submodules.
+	/// Only the parts selected in delta are read again, the structure (neurons, routing) is kept.
+	void reconfigure(ESS::config_delta const& delta);
+
+	/// resets the dynamic state for a new run starting at origin,
+	/// and restarts the background event generators.
+	void reset(sc_time const& origin);
+
+	/// completes the recordings of a run, which is not ended by sc_stop().
+	void finish_run();
+
+	/// stores or restores the dynamic state of the submodules.
+	/// The layer 1 network has no state besides its configuration.
+	void checkpoint(ess::state_archive& ar);
+
+	/// allocation counts of the pulse storage, reported at the end of a run
+	ess::pulse_pool::statistics const& get_pulse_pool_statistics() const {return pulse_pool_i.get_statistics();}
+
+private:
+	/// storage of the pulses queued in the submodules, declared first as it has to outlive them
+	ess::pulse_pool pulse_pool_i;
+
+public:
 	////////////////
 	// Submodules //
 	////////////////
@@ -64,6 +98,8 @@ public:
 	unsigned int get_id() const {return hicannid;}
 	unsigned int get_x() const {return x_coord;}
 	unsigned int get_y() const {return y_coord;}
+	/// period of the PLL clock in ns, which drives the mergers, priority encoders and background generators
+	unsigned int get_PLL_period_ns() const {return PLL_period_ns;}
 private:
 
 	///////////////////
@@ -76,6 +112,7 @@ private:
 	unsigned int y_coord;	///< y-coordinate of hicann on wafer(needed for GMAccess)
 	std::string sim_folder; ///< Folder for temporary and debug files during simulation
 	HALaccess * hal_access; ///< instance of HALaccess for configuration
+	unsigned int PLL_period_ns; ///< period of the PLL clock in ns
 
 	/////////////////////////////////////////////
 	// Methods for configuration of submodules //
@@ -84,6 +121,15 @@ private:
 	/// function to configure anncore
 	void config_anncore();
 
+	/// configures the addresses and weights of the synapse arrays
+	void config_synapses();
+
+	/// configures the current stimuli of the 4 floating gate blocks
+	void config_current_stimuli();
+
+	/// configures the parameters of one denmem belonging to the logical neuron of the firing denmem dendrite
+	void config_denmem(unsigned int dendrite, unsigned int denmem);
+
 	/// function to configure layer 1 routing module 
 	void config_l1net();
 
@@ -15,7 +15,7 @@ class hw_neuron_ADEX_clocked: public hw_neuron
 {
 	private:
 		double mLastTime; ///< time of last update
-		sc_clock mClock; //!< systemc clock
+		sc_light_clock mClock; //!< systemc clock
 
 		sc_event trigger_record; //!< triggers function `record()`
 		double recording_interval; //!< recording interval in seconds.
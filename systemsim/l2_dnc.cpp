@@ -33,6 +33,8 @@ l2_dnc::l2_dnc (sc_module_name /*l2_dnc_i*/,char wafer,short id, const ESS::dnc_
 			snprintf(buffer,sizeof(buffer),"dnc_channel_i%i",i);
 			dnc_channel_i[i] = new dnc_ser_channel(buffer);
 			dnc_channel_i[i]->set_side(dnc_ser_channel::DNC);
+			dnc_channel_i[i]->heap_tx_mem.set_pool(&pulse_pool_i);
+			delay_mem[i].set_pool(&pulse_pool_i);
   		}
 		dnc_tx_fpga_i = new dnc_tx_fpga("dnc_tx_fpga_i",this);
 		dnc_tx_fpga_i->set_side(dnc_tx_fpga::DNC);
@@ -54,11 +56,7 @@ l2_dnc::l2_dnc (sc_module_name /*l2_dnc_i*/,char wafer,short id, const ESS::dnc_
 		// set time limits to default
         for (unsigned int nchannel=0;nchannel<DNC_TO_ANC_COUNT;++nchannel)
 			time_limits[nchannel] = DNC_TIME_LIMIT;
-        
-        // for debugging: fill routing memory with VOID_ENTRY values
-        for (unsigned int nchannel=0;nchannel<DNC_TO_ANC_COUNT;++nchannel)
-        for (unsigned int naddress=0;naddress<L2_LABEL_COUNT;++naddress)
-        	routing_mem[nchannel][naddress] = 0; // no additional delay
+        // the routing memory is initialized without additional delay
 	}
 l2_dnc::~l2_dnc()
 {
@@ -71,42 +69,31 @@ l2_dnc::~l2_dnc()
 }
 
 
-void l2_dnc::transmit_from_anc(const sc_uint<L2_EVENT_WIDTH>& rx_event, int channel)
+void l2_dnc::transmit_from_anc(ess::l2_event rx_event, int channel)
 {
-    sc_uint<L2_LABEL_WIDTH> rx_address = (rx_event>>TIMESTAMP_WIDTH) & 0x1ff; // get hicann address
-    sc_uint<TIMESTAMP_WIDTH> time = rx_event & 0x7fff; //get neuron address
-    sc_uint<HYP_EVENT_WIDTH> event;
-    uint sub_address;
-
-    sub_address = routing_mem[channel][rx_address.to_uint()] & 0xffff;
+	ess::l2_event event;
+	unsigned int l1bus = rx_event.l1bus();
 
-	event = (((channel << 9) + rx_address) << TIMESTAMP_WIDTH) + ((time + (sub_address&0x7fff)) & 0x7fff);
-
-	if (l2direction[(channel*8)+(rx_address.to_uint()>>L1_ADDR_WIDTH)] == 0) {
+	if (routing.from_hicann(channel, rx_event, event)) {
 		dnc_tx_fpga_i->start_event(event);
-        LOG4CXX_DEBUG(logger, name() << ": Received event from HICANN: " << channel << " l1bus: " << (rx_address.to_uint()>>L1_ADDR_WIDTH) << " send to FPGA");
+        LOG4CXX_DEBUG(logger, name() << ": Received event from HICANN: " << channel << " l1bus: " << l1bus << " send to FPGA");
 		LostEventLogger::count_l2_dnc_transmit_from_anc();
 	} else {
-        LOG4CXX_WARN(logger, name() << ": Received event from HICANN: " << channel << " l1bus: " << (rx_address.to_uint()>>L1_ADDR_WIDTH) << " that is not configured to send to FPGA");
+        LOG4CXX_WARN(logger, name() << ": Received event from HICANN: " << channel << " l1bus: " << l1bus << " that is not configured to send to FPGA");
 	}
 }
 
 
-void l2_dnc::transmit_from_fpga(const sc_uint<HYP_EVENT_WIDTH>& rx_event)
+void l2_dnc::transmit_from_fpga(ess::l2_event rx_event)
 {
-	sc_uint<L2_LABEL_WIDTH> rx_address = (rx_event>>TIMESTAMP_WIDTH) & 0x1ff; // get hicann and neuron address
-	sc_uint<TIMESTAMP_WIDTH> time = rx_event & 0x7fff; //get release time 
-	sc_uint<3> channel = (rx_event >> (TIMESTAMP_WIDTH+9))& 0x7; //get target channel
-	sc_uint<L2_EVENT_WIDTH> event;
-
-	// check direction
-	sc_uint<3> dncif_channel =  rx_address >> 6;
-	if (l2direction[ (channel*8)+ dncif_channel.to_uint() ]) {
-		event = (rx_address << TIMESTAMP_WIDTH) + time;
+	unsigned int channel;
+	ess::l2_event event;
+
+	if (routing.from_fpga(rx_event, channel, event)) {
 		transmit_to_anc(event, channel);
 		LostEventLogger::count_l2_dnc_transmit_from_fpga();
 	} else {
-        LOG4CXX_WARN(logger, name() << ": CANNOT send event to HICANN: " << channel << " l1bus: " << dncif_channel.to_uint() << ", that is not configured to send to HICANN");
+        LOG4CXX_WARN(logger, name() << ": CANNOT send event to HICANN: " << channel << " l1bus: " << event.l1bus() << ", that is not configured to send to HICANN");
 	}
 }
 
@@ -114,10 +101,9 @@ void l2_dnc::transmit_from_fpga(const sc_uint<HYP_EVENT_WIDTH>& rx_event)
 
 void l2_dnc::fifo_from_anc_ctrl()
 {
-	uint value = 0;
+	uint32_t value = 0;
 	uint64 value_cfg = 0;
 	int i;
-	sc_uint<L2_EVENT_WIDTH> out;
 
 //		wait(100,SC_PS);
         for(i=0;i<DNC_TO_ANC_COUNT;++i)
@@ -126,9 +112,8 @@ void l2_dnc::fifo_from_anc_ctrl()
 			{
 				dnc_channel_i[i]->fifo_rx_event.nb_read(value);
     			//printf("DNC FROM HICANN ENTER fifo_from_anc_ctrl @ %i: %i %.8X\n",id,i,value);fflush(stdout);
-				out = value;
 				//cout << "@ " << sc_simulation_time() << "From L1: " << hex << value << " from " << id << "\n";
-				transmit_from_anc(out,i);
+				transmit_from_anc(ess::l2_event::from(value),i);
 				LostEventLogger::count_l2_dnc_fifo_from_anc_ctrl();
 			} else if(dnc_channel_i[i]->fifo_rx_cfg.num_available())
 			{
@@ -142,20 +127,17 @@ void l2_dnc::fifo_from_anc_ctrl()
 
 void l2_dnc::fifo_from_fpga_ctrl()
 {
+	uint32_t event = 0;
 	uint64 value = 0;
 	unsigned char target = 0;
-	sc_uint<HYP_EVENT_WIDTH> out;
 	uint64 cfg_data = 0;
 	unsigned char cfg_target = 0;
 
 //		wait(100,SC_PS);
 		if(dnc_tx_fpga_i->fifo_rx_event.num_available())
 		{
-			dnc_tx_fpga_i->fifo_rx_event.nb_read(value);
-	   		//printf("ENTER fifo_from_fpga_ctrl @ %i: %.8X\n",id,(uint)value);fflush(stdout);
-			out = value;
-			//cout << "@ " << sc_simulation_time() << "From FPGA: " << hex << value << "\n";
-			transmit_from_fpga(out);
+			dnc_tx_fpga_i->fifo_rx_event.nb_read(event);
+			transmit_from_fpga(ess::l2_event::from(event));
 			LostEventLogger::count_l2_dnc_fifo_from_fpga_ctrl();
 		} else if(dnc_tx_fpga_i->fifo_rx_cfg.num_available())
 		{
@@ -169,11 +151,11 @@ void l2_dnc::fifo_from_fpga_ctrl()
 		}
 }
 
-void l2_dnc::transmit_to_anc(const sc_uint<L2_EVENT_WIDTH>& rx_event, int channel)
+void l2_dnc::transmit_to_anc(ess::l2_event rx_event, int channel)
 {
 //add to memory of channel
 	unsigned int value;
-	if(delay_mem[channel].insert(rx_event.to_uint())) {
+	if(delay_mem[channel].insert(rx_event.value)) {
 		LostEventLogger::count_l2_dnc_transmit_to_anc();
 		// _log(Logger::INFO) << name() << "::transmit_to_anc(" << rx_event.to_uint() << ", " << channel << ") successful";
 	}
@@ -190,7 +172,6 @@ void l2_dnc::delay_mem_ctrl()
 //	current time + tx_max time
 	uint value,val;
 	// uint count;
-	sc_uint<L2_EVENT_WIDTH> out;
 	int i;
 
 	double sim_time = sc_simulation_time();
@@ -228,19 +209,18 @@ void l2_dnc::delay_mem_ctrl()
 				<< "\t, diff =" << diff;
 			*/
 
-			if ( diff == (int) time_limits[i] )
+			if ( diff == time_limits[i] )
 			{
 				delay_mem[i].get(value);
 				delay_mem[i].view_next(val);
-				out = value;
 				// We directly trigger the sending of an event, by first starting and then sending it within one cycle
-				dnc_channel_i[i]->start_event(out);
+				dnc_channel_i[i]->start_event(ess::l2_event::from(value));
 				dnc_channel_i[i]->transmit();
 				// count=delay_mem[i].num_available();
 				LostEventLogger::count_l2_dnc_delay_mem_ctrl();
 				//printf("l2_dnc::delay_mem_ctrl@ %fl started to L1 transfer at DNC%i with data %.8X rest data: %i (next-> %.8X)\n",sc_simulation_time(),id,value,count,val);
 			}
-			else if ( diff < (int) time_limits[i] ) {
+			else if ( diff < time_limits[i] ) {
 			// else if ( diff > (1<<(TIMESTAMP_WIDTH-6)) ) {
 				delay_mem[i].get(value);
                 LOG4CXX_DEBUG(logger, name() << "expired event dropped"
@@ -267,8 +247,10 @@ void l2_dnc::config_from_fpga(unsigned char target, uint64 cfg_data)
 
 	if(target < DNC_TO_ANC_COUNT)
 	{
-		this->routing_mem[target][address] = cfg_data & 0xffffffff;
-		//printf("l2_dnc: configuring routing mem: channel 0x%X, address 0x%X = %.4X\n",target, address, routing_mem[target][address]);
+		if (address < (1 << DncRoutingTable::address_width))
+			this->routing.set_delay(target, address, cfg_data & 0xffffffff);
+		else
+			LOG4CXX_WARN(logger, name() << ": routing memory address " << address << " of channel " << (int)target << " out of range");
 	} else
 	{
 		//printf("ENTER l1route config %llX @ %i\n",cfg_data & 0xffffffffffffffff ,target-DNC_TO_ANC_COUNT);
@@ -305,13 +287,13 @@ void l2_dnc::instant_config(const ess::l2_packet_t& cfg_packet)
 				rt_entry = cfg_packet.data[ndata];
                 unsigned int channel = cfg_packet.sub_id;
                 unsigned int address = (rt_entry>>15) & 0x1ff;
-				this->routing_mem[channel][address] = rt_entry & 0x7fff;
-                LOG4CXX_DEBUG(logger, std::hex << std::uppercase << cfg_packet.data[ndata] << "  -> routing mem: channel 0x" << channel << ", address 0x" << address << " = " << routing_mem[channel][address]);
+				this->routing.set_delay(channel, address, rt_entry & 0x7fff);
+                LOG4CXX_DEBUG(logger, std::hex << std::uppercase << cfg_packet.data[ndata] << "  -> routing mem: channel 0x" << channel << ", address 0x" << address << " = " << routing[DncRoutingTable::label(channel, address)].delay);
 			}
 		break;
 
         case ess::l2_packet_t::DNC_DIRECTIONS:
-			this->l2direction = cfg_packet.data[0];
+			this->routing.set_directions(cfg_packet.data[0]);
 			for (unsigned int ndata=0;ndata<cfg_packet.data.size();++ndata)
                 LOG4CXX_DEBUG(logger, std::hex << cfg_packet.data[ndata] << " " );
 		break;
@@ -326,14 +308,28 @@ void l2_dnc::instant_config(const ess::l2_packet_t& cfg_packet)
 }
 
 void l2_dnc::set_time_limits(
-		const std::array< sc_uint<10>, DNC_TO_ANC_COUNT > & limits
+		const std::array< uint16_t, DNC_TO_ANC_COUNT > & limits
 		)
 {
-	time_limits = limits;
+	for (int i = 0; i < DNC_TO_ANC_COUNT; ++i)
+		time_limits[i] = limits[i] & 0x3ff;
 }
 
 void l2_dnc::set_hicann_directions(const std::bitset<64> & hicann_directions)
 {
-	l2direction = hicann_directions.to_ullong();
+	routing.set_directions(hicann_directions.to_ullong());
 }
 
+
+void l2_dnc::checkpoint(ess::state_archive& ar)
+{
+	ar.section(name());
+	routing.checkpoint(ar);
+	for (auto& limit : time_limits)
+		ar.value(limit);
+	for (int i = 0; i < DNC_TO_ANC_COUNT; ++i) {
+		delay_mem[i].checkpoint(ar);
+		dnc_channel_i[i]->checkpoint(ar);
+	}
+	dnc_tx_fpga_i->checkpoint(ar);
+}
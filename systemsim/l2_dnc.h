@@ -25,10 +25,10 @@
 // defines and helpers
 #include "sim_def.h"
 #include "types.h"
-#include "generic_array.h"
 
 // functional units
 #include "dnc_ser_channel.h"
+#include "DncRoutingTable.h"
 #include "sized_queue.h"
 #include "HAL2ESSContainer.h"
 
@@ -42,29 +42,26 @@ class l2_dnc :
 	short id;
 	char wafer;
 
-	sc_clock clk;
+	sc_light_clock clk;
 
-	//Routing table
-    ess::generic_array<unsigned int, DNC_TO_ANC_COUNT, L2_LABEL_COUNT, 1> routing_mem; ///< routing information memory	
-	//Delay memory downto ANC
-	// heap_mem<uint> delay_mem[DNC_TO_ANC_COUNT]; ///< delay memory for pulse vents
-    ess::sized_queue<uint> delay_mem[DNC_TO_ANC_COUNT]; ///< delay memory for pulse vents
-
-	/// holds the direction for all hicanns and all dnc if channels on it.
-	/// 0: TO_DNC
-	/// 1: TO_HICANN
-	/// numbering: 
+	/// Routing table, holds the delays of the events from the HICANNs and the directions of the dnc if channels.
+	/// The directions are numbered as follows, with 0: TO_DNC and 1: TO_HICANN:
 	/// BIT     | 0 ............7 | 8.............15|16 ...................... 63 |
 	/// HICANN  | 0               | 1               | 2               | ...
 	/// CHANNEL | 0 1 2 3 4 5 6 7 | 0 1 2 3 4 5 6 7 | 0 1 2 3 4 5 6 7 | ...
 	/// where HICANN is as seen from the DNC, i.e. NOT equal to HMF::Coordinate::HICANNOnDNC.id()
 	/// and the CHANNEL is the dnc if CHANNEL in hardware numbering: 7 - GbitLinkOnHICANN()
-	sc_uint<64> l2direction;
+	DncRoutingTable routing;
+	/// storage of the queued pulses of the delay memories and the channels
+	ess::pulse_pool pulse_pool_i;
+	//Delay memory downto ANC
+	// heap_mem<uint> delay_mem[DNC_TO_ANC_COUNT]; ///< delay memory for pulse vents
+    ess::sized_queue<uint> delay_mem[DNC_TO_ANC_COUNT]; ///< delay memory for pulse vents
 
 	/// holds for each hicann channel the time limits, which effect the release time of an event to the hicann.
 	/// size: 8
-	/// inner values: range from 0 .. 1023
-	std::array< sc_uint<10>, DNC_TO_ANC_COUNT >time_limits;
+	/// inner values: range from 0 .. 1023 (10 bit)
+	std::array< uint16_t, DNC_TO_ANC_COUNT >time_limits;
 
 public:
 	dnc_ser_channel *dnc_channel_i[DNC_TO_ANC_COUNT];	///< serial communication channels
@@ -85,13 +82,13 @@ public:
 	void delay_mem_ctrl();
 
 	/// Function to transmit events from HICANN.
-	void transmit_from_anc(const sc_uint<L2_EVENT_WIDTH>&, int);
+	void transmit_from_anc(ess::l2_event, int);
 
 	/// Function to transmit events from FPGA.
-	void transmit_from_fpga(const sc_uint<HYP_EVENT_WIDTH>&);
+	void transmit_from_fpga(ess::l2_event);
 
 	/// Function that adds pulses to delay memory to be sent to the HICANN
-	void transmit_to_anc(const sc_uint<L2_EVENT_WIDTH>&, int);
+	void transmit_to_anc(ess::l2_event, int);
 
 	/// Function to forward HICANN cfg packet data.
 	void config_from_anc(int i,uint64 cfg_data);
@@ -103,11 +100,19 @@ public:
     void instant_config(const ess::l2_packet_t& cfg_packet);
 
 	/// sets the time limits for all hicann channels , which effect the release time of an event to the hicann.
-	void set_time_limits(const std::array< sc_uint<10>, DNC_TO_ANC_COUNT > & limits);
+	/// Only the lower 10 bit of the limits are used.
+	void set_time_limits(const std::array< uint16_t, DNC_TO_ANC_COUNT > & limits);
 
 	/// sets the direction for all hicanns and all dnc if channels on it.
-	/// see member l2direction for details
+	/// see member routing for details
 	void set_hicann_directions(const std::bitset<64> & hicann_directions);
+
+	/// allocation counts of the pulse storage, reported at the end of a run
+	ess::pulse_pool::statistics const& get_pulse_pool_statistics() const {return pulse_pool_i.get_statistics();}
+
+	/// stores or restores the dynamic state including the channels.
+	/// Routing memory, time limits and directions are included, as they can be changed by configuration packets.
+	void checkpoint(ess::state_archive& ar);
 };
 
 
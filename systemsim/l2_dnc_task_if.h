@@ -21,6 +21,7 @@
 
 // defines and helpers
 #include "sim_def.h"
+#include "l2_event.h"
 
 /// This class provides provides a high level task interface for the Layer2 DNC.
 class l2_dnc_task_if : 
@@ -29,7 +30,7 @@ class l2_dnc_task_if :
 public:
 	/// receive interface for pulse event packets.
 	/// interface 2 other DNCs
-	virtual void receive_event(const sc_uint<L2_EVENT_WIDTH>&) = 0;
+	virtual void receive_event(ess::l2_event) = 0;
 	/// receive interface for configuration packets.	
 	virtual void receive_config(const sc_uint<L2_CFGPKT_WIDTH>&) = 0;
 	
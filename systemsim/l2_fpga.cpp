@@ -24,11 +24,16 @@
 
 static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("ESS.Layer2");
 
-l2_fpga::l2_fpga (sc_module_name /*l2_fpga_i*/, int id, int wafer_id, const ESS::fpga_config & config)
+l2_fpga::l2_fpga (sc_module_name /*l2_fpga_i*/, int id, int wafer_id, ESS::fpga_config config)
 	: id(id)
 	, wafer_id(wafer_id)
     ,_record(config.record)
 	,_stop(false)
+	,_playback_active(true)
+	,_restart_playback(true)
+	,_time_origin_ns(0.)
+	,_playback_index(0)
+	,_next_pulse_time(SC_ZERO_TIME)
 	, clk("clk",CLK_PER_L2_FPGA,SC_NS)
 	{
 		for(size_t i=0;i<DNC_FPGA;i++)
@@ -42,10 +47,11 @@ l2_fpga::l2_fpga (sc_module_name /*l2_fpga_i*/, int id, int wafer_id, const ESS:
 		dont_initialize();
 		sensitive << clk;
 		
-		SC_THREAD(play_tx_event);
+		SC_METHOD(play_tx_event);
 
 		// apply fpga config
-		setPlaybackPulses(config.playback_pulses);
+		setPlaybackPulses(std::move(config.playback_pulses));
+		_trace_pulses.configure(config.trace_memory_budget, config.trace_spill_file);
 	}
 
 l2_fpga::~l2_fpga()
@@ -58,8 +64,8 @@ l2_fpga::~l2_fpga()
 
 void l2_fpga::fifo_from_l2_ctrl()
 {
+	uint32_t event = 0;
 	uint64 value = 0;
-	sc_uint<HYP_EVENT_WIDTH> out;
 	unsigned char target = 0;
 	int i;
 
@@ -67,11 +73,10 @@ void l2_fpga::fifo_from_l2_ctrl()
 	{
 		if(dnc_tx_fpga_i[i]->fifo_rx_event.num_available())
 		{
-			dnc_tx_fpga_i[i]->fifo_rx_event.nb_read(value);
-			out = value;
+			dnc_tx_fpga_i[i]->fifo_rx_event.nb_read(event);
 
 			if(_record)
-				record_rx_event(i,out);
+				record_rx_event(i,ess::l2_event::from(event));
 
 			LostEventLogger::count_l2_fpga_fifo_from_l2_ctrl();
 		} else if (dnc_tx_fpga_i[i]->fifo_rx_cfg.num_available())
@@ -84,49 +89,111 @@ void l2_fpga::fifo_from_l2_ctrl()
 }
 
 
-void l2_fpga::play_tx_event()
+sc_time l2_fpga::playback_delay(size_t index) const
 {
 	static unsigned int num_times_warning_called = 0;
-	for (auto entry : _playback_pulses )
-	{
-		ESS::playback_entry::delta_time_t wait_time = entry.delta_time;
-
-		if (wait_time < 1 ) {
-			wait_time = 1;
-			if (num_times_warning_called < 5 ) {
-                LOG4CXX_WARN(logger, name() << ":play_tx_event(): Pulses come to close, pulse is delayed by one FPGA CLK cycle ( 8 ns)");
-				num_times_warning_called++;
-				if (num_times_warning_called == 5 ){
-                    LOG4CXX_WARN(logger, name() << ":play_tx_event(): Future warnings will be suppressed");
-				}
+	ESS::playback_entry::delta_time_t wait_time = _playback_pulses[index].delta_time;
+
+	if (wait_time < 1 ) {
+		wait_time = 1;
+		if (num_times_warning_called < 5 ) {
+			LOG4CXX_WARN(logger, name() << ":play_tx_event(): Pulses come to close, pulse is delayed by one FPGA CLK cycle ( 8 ns)");
+			num_times_warning_called++;
+			if (num_times_warning_called == 5 ){
+				LOG4CXX_WARN(logger, name() << ":play_tx_event(): Future warnings will be suppressed");
 			}
 		}
-		wait(wait_time*SYS_CLK_PER_L2_FPGA_NS,SC_NS);
+	}
+	return sc_time(wait_time*SYS_CLK_PER_L2_FPGA_NS,SC_NS);
+}
+
+void l2_fpga::play_tx_event()
+{
+	if (!_playback_active) {
+		next_trigger(_playback_changed);
+		return;
+	}
+	if (_restart_playback) {
+		_restart_playback = false;
+		_playback_index = 0;
+		if (!_playback_pulses.empty())
+			_next_pulse_time = sc_time_stamp() + playback_delay(0);
+	}
 
+	// release all pulses due now
+	while (_playback_index < _playback_pulses.size() && _next_pulse_time <= sc_time_stamp())
+	{
+		const ESS::playback_entry& entry = _playback_pulses[_playback_index];
 		size_t dnc_id = entry.event.getDncAddress();
 
-		/// we need to create an L2 Event:
-		/// MSB | <5bit unused> | <12 label(without dnc)> | <15bit time stamp> | LSB
-		uint32_t event = entry.event.getTime() % (1<<TIMESTAMP_WIDTH); // set time
-		event |= (entry.event.getLabel() % (1<<L2_LABEL_WIDTH)) << TIMESTAMP_WIDTH; // crop dnc from label and shift to the right position
-        
-        //TODO understand syntax 
+		/// we need to create an L2 Event, the dnc is cropped from the label
+		const ess::l2_event event = ess::l2_event::make(entry.event.getLabel(), entry.event.getTime());
+
         LOG4CXX_TRACE(logger, name() << ":play_tx_event(): event started: " << event);
 		dnc_tx_fpga_i[dnc_id]->start_event(event);
 		LostEventLogger::count_fpga();
+
+		if (++_playback_index < _playback_pulses.size())
+			_next_pulse_time += playback_delay(_playback_index);
 	}
+
+	if (_playback_index < _playback_pulses.size())
+		next_trigger(_next_pulse_time - sc_time_stamp(), _playback_changed);
+	else
+		next_trigger(_playback_changed); // wait until the playback is restarted for the next run
+}
+
+void l2_fpga::stop_playback()
+{
+	_playback_active = false;
+	_playback_changed.notify(SC_ZERO_TIME);
 }
 
-void l2_fpga::record_rx_event(const int dnc_id, const sc_uint<HYP_EVENT_WIDTH>& event)
+void l2_fpga::reset(sc_time const& origin)
+{
+	_trace_pulses.clear();
+	_stop = false;
+	_time_origin_ns = origin.to_seconds()*1.e9;
+	_playback_active = true;
+	_restart_playback = true;
+	_playback_changed.notify(SC_ZERO_TIME);
+}
+
+void l2_fpga::record_rx_event(const int dnc_id, ess::l2_event event)
 {
 	ESS::trace_entry entry;
-	entry.fpga_time = (uint) sc_simulation_time() / SYS_CLK_PER_L2_FPGA_NS; // FIXME: replace sc_simulation_time by sc_time_stamp
+	entry.fpga_time = (uint64_t) (sc_simulation_time() - _time_origin_ns) / SYS_CLK_PER_L2_FPGA_NS; // FIXME: replace sc_simulation_time by sc_time_stamp
 
-	uint16_t pulse_label = (dnc_id << L2_LABEL_WIDTH) | ((event.to_uint() >> TIMESTAMP_WIDTH) % (1<<L2_LABEL_WIDTH) );
-	uint16_t time_stamp = event.to_uint() % (1<<TIMESTAMP_WIDTH);
+	uint16_t pulse_label = (dnc_id << L2_LABEL_WIDTH) | event.label();
+	uint16_t time_stamp = event.time();
     LOG4CXX_TRACE(logger, name() << ":record_rx_event(): pulse recorded with label " << pulse_label << " @ " << time_stamp << " ns");
 	entry.event.setLabel(pulse_label);
 	entry.event.setTime(time_stamp);
 	_trace_pulses.push_back(entry);
 	LostEventLogger::count_l2_fpga_record_rx_event();
 }
+
+void l2_fpga::checkpoint(ess::state_archive& ar)
+{
+	ar.section(name());
+	for (size_t i = 0; i < DNC_FPGA; ++i)
+		dnc_tx_fpga_i[i]->checkpoint(ar);
+	ar.value(_record);
+	ar.value(_stop);
+	ar.value(_playback_active);
+	ar.value(_restart_playback);
+	ar.check_size(_playback_pulses.size());
+	ar.value(_playback_index);
+	// the time of the next pulse is only valid while pulses are pending
+	bool pulse_pending = _playback_active && !_restart_playback && _playback_index < _playback_pulses.size();
+	ar.value(pulse_pending);
+	if (pulse_pending)
+		ar.time(_next_pulse_time);
+	ar.simulation_time(_time_origin_ns);
+	_trace_pulses.checkpoint(ar);
+
+	if (ar.loading()) {
+		// the playback continues with the restored pulse
+		_playback_changed.notify(SC_ZERO_TIME);
+	}
+}
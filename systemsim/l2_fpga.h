@@ -27,6 +27,8 @@
 // functional units
 #include "dnc_tx_fpga.h"
 #include "HAL2ESSContainer.h"
+#include "TraceMemory.h"
+#include "state_archive.h"
 
 /// This class provides a Layer2 FPGA.
 class l2_fpga :
@@ -40,9 +42,20 @@ private:
 	bool _record; //!< flag for writing pulses to trace memory
 	bool _stop; //!< flag to see if stop_trace_memory was called
 	ESS::playback_container_t _playback_pulses;
-	ESS::trace_container_t _trace_pulses;
+	TraceMemory _trace_pulses;
 
-	sc_clock clk;
+	bool _playback_active; //!< if false, play_tx_event waits for the restart of the playback
+	bool _restart_playback; //!< if true, play_tx_event starts the playback with the first pulse
+	sc_event _playback_changed; //!< notified whenever the playback is stopped, restarted or restored
+	double _time_origin_ns; //!< start of the current run, the recorded times are relative to this
+	size_t _playback_index; //!< index of the next pulse to be played
+	sc_time _next_pulse_time; //!< time at which the pulse at _playback_index is played
+
+	/// time between the previous pulse and the pulse at index,
+	/// at least one FPGA clock cycle
+	sc_time playback_delay(size_t index) const;
+
+	sc_light_clock clk;
 		
 	SC_HAS_PROCESS(l2_fpga);
 	
@@ -51,7 +64,7 @@ public :
     dnc_tx_fpga *dnc_tx_fpga_i[DNC_FPGA];
 
 	/// constructor
-	l2_fpga (sc_module_name l2_fpga_i, int id, int wafer_id, const ESS::fpga_config & config);
+	l2_fpga (sc_module_name l2_fpga_i, int id, int wafer_id, ESS::fpga_config config);
 
 	/// destructor
 	~l2_fpga();
@@ -60,24 +73,46 @@ public :
 	void fifo_from_l2_ctrl();
 
 	/// records one pulse event to trace memory
-	void record_rx_event(const int dnc_id, const sc_uint<HYP_EVENT_WIDTH>&);
+	void record_rx_event(const int dnc_id, ess::l2_event);
 
 	/// plays pulses from playback memory
-	/// This is a sc_thread, which is started at the beginning of simulation.
-	/// between events, the thread waits for a given time and then resumes
-	/// with sending new events
+	/// This is a sc_method, which releases all pulses due at the current time
+	/// and is triggered again at the time of the next pulse or when the playback changes.
 	void play_tx_event();
 
+	/// stops the playback of pulses, used to drain the system between two runs.
+	void stop_playback();
+
+	/// prepares a new run starting at origin:
+	/// clears the trace memory and restarts the playback from the first pulse.
+	void reset(sc_time const& origin);
+
+	/// stores or restores the channels, the trace memory and the playback position.
+	/// When restoring, the playback is continued with the next pulse.
+	void checkpoint(ess::state_archive& ar);
+
     // Dummys for halbe_to_ess
     void setStopTrace(bool stop) {_stop=stop;}
     bool getStopTrace() const {return _stop;}
 
 	// TODO: Should we append playback pulses to the existing Pulses, instead of replacing them?
 	// Appending would be more like the real hardware...
-	void setPlaybackPulses( const ESS::playback_container_t & playback_pulses ) {_playback_pulses = playback_pulses;}
-
-	// TODO: When do we clear the traced spikes?
-	const ESS::trace_container_t & getTracePulses() const { return _trace_pulses; }
+	// The pulses are taken by value, pass an rvalue to move large inputs instead of copying them.
+	void setPlaybackPulses( ESS::playback_container_t playback_pulses ) {_playback_pulses = std::move(playback_pulses);}
+
+	/// copy of the recorded pulses which were not drained yet,
+	/// the trace memory is cleared by reset() at the start of the next run.
+	ESS::trace_container_t getTracePulses() { return _trace_pulses.all(); }
+
+	/// moves up to max_entries of the oldest recorded pulses to the end of out and returns their number.
+	/// Can be called between two runs to process long recordings in parts.
+	size_t drainTracePulses(ESS::trace_container_t & out, size_t max_entries = std::numeric_limits<size_t>::max())
+	{
+		return _trace_pulses.drain(out, max_entries);
+	}
+
+	/// number of recorded pulses which were not drained yet
+	size_t numTracePulses() const { return _trace_pulses.size(); }
     
 };
 
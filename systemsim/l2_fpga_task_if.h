@@ -21,6 +21,7 @@
 
 // defines and helpers
 #include "sim_def.h"
+#include "l2_event.h"
 
 /// This abtract class provides provides a high level task interface for the Layer2 FPGA.
 class l2_fpga_task_if : 
@@ -28,7 +29,7 @@ class l2_fpga_task_if :
 {
 public:
 	/// receive_fpga_event(...) is one hypertransport interface.
-	virtual void receive_fpga_event(const sc_uint<HYP_EVENT_WIDTH>&) = 0;
+	virtual void receive_fpga_event(ess::l2_event) = 0;
 	virtual ~l2_fpga_task_if() {}
 };
 
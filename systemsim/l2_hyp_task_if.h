@@ -23,6 +23,7 @@
 // defines and helpers
 #include "sim_def.h"
 #include "types.h"
+#include "l2_event.h"
 
 /// This class provides a high level task interface for a hypertransport - HTX channel.
 class l2_hyp_task_if : 
@@ -31,7 +32,7 @@ class l2_hyp_task_if :
 public:
 	/// provide L2 channel interfaces for other DNCs.
 	/// interface for pulse events.
-	virtual void receive_event(const sc_uint<HYP_EVENT_WIDTH>&) = 0; 
+	virtual void receive_event(ess::l2_event) = 0; 
 	/// interface for config packets.
 	virtual void receive_config(const sc_uint<DNC_TARGET_WIDTH>&, const sc_uint<L2_CFGPKT_WIDTH>&) = 0; 
 	virtual void rx_instant_config(const ess::l2_packet_t &) = 0; 
@@ -15,6 +15,7 @@
 
 #include "l2tol1_tx.h"
 #include "lost_event_logger.h"
+#include <algorithm>
 #include <sstream>
 #include <log4cxx/logger.h>
 
@@ -23,12 +24,12 @@ static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("ESS.Layer2");
 /// Gets received data from dnc_if and adds it into buffers.
 /// External interface!
 /// @param data_in: event containing timestamp and neuron number
-void l2tol1_tx::transmit(sc_uint <TIMESTAMP_WIDTH+L1_ADDR_WIDTH> data_in)
+void l2tol1_tx::transmit(ess::l2_event data_in)
 {
 	if (_direction == TO_HICANN) {
 		buffer = data_in;
 		rx_data.notify(TIME_DES_PULSE,SC_NS);
-		LostEventLogger::count_l2tol1_tx_transmit();
+		LostEventLogger::count_l2tol1_tx_transmit(hicannid);
 	}
 	else {
         LOG4CXX_WARN(logger, name() << "::transmit() received event but direction is set TO_DNC");
@@ -39,10 +40,10 @@ void l2tol1_tx::transmit(sc_uint <TIMESTAMP_WIDTH+L1_ADDR_WIDTH> data_in)
 void l2tol1_tx::add_buffer()
 {
 	if (_direction == TO_HICANN) {
-		sim_time = sc_simulation_time();	// sc_simulation_time returns time as a double in SC_NS(per default, comp. sc_get_default_time_unit
+		double sim_time = sc_simulation_time();	// sc_simulation_time returns time as a double in SC_NS(per default, comp. sc_get_default_time_unit
 		uint current_clock_cycle = (uint)(sim_time/SYSTIME_PERIOD_NS) & 0x7fff;
 		// check for expired events:
-		uint rel_time = (buffer & 0x7fff);
+		uint rel_time = buffer.time();
 		if ( ((rel_time - current_clock_cycle )>>(TIMESTAMP_WIDTH-1)) & 0x1 ) {
             LOG4CXX_TRACE(logger, name() << ":add_buffer(): EXPIRED EVENT: \tsim_time= " <<  sim_time
 				<< "\t, current_clock_cycle=" << current_clock_cycle
@@ -50,129 +51,122 @@ void l2tol1_tx::add_buffer()
 				<< "\t, delta=" << (int)(current_clock_cycle-rel_time));
 			std::stringstream ss;
 			ss << name() << " event expired";
-			LostEventLogger::log(/*downwards*/ true, ss.str());
+			LostEventLogger::log(/*downwards*/ true, ss.str(), hicannid);
 			return;
 		}
-		// check if event is already expired:
-		//if ( ((buffer & 0x1fff) - current_clock_cycle )
-		for(size_t i=0;i<DNC_IF_2_L2_BUFFERSIZE;i++)
-		{
-			if(memory[i].valid == false)
-			{
-				memory[i].valid = true;
-				memory[i].value = buffer;
-				/*
-				_log(Logger::INFO) << "l2tol1_tx::add_buffer(): sim_time= " <<  sim_time 
-					<< "\t, current_clock_cycle=" << current_clock_cycle
-					<< "\t, rel_time= " <<  (memory[i].value & 0x7fff)
-					<< "\t, delta=" << (int)(current_clock_cycle-(memory[i].value & 0x7fff))
-					<< "\t, memory=" << i;
-				*/
-				LostEventLogger::count_l2tol1_tx_add_buffer();
-				return;
-			}
-		}
 		// if no space in memory left -> pulse is lost
-		std::stringstream ss;
-		ss << name() << " no input buffer free";
-		LostEventLogger::log(/*downwards*/ true, ss.str());
+		if (memory.size() == DNC_IF_2_L2_BUFFERSIZE) {
+			std::stringstream ss;
+			ss << name() << " no input buffer free";
+			LostEventLogger::log(/*downwards*/ true, ss.str(), hicannid);
+			return;
+		}
+		// Only the last 10 bit of the time stamp are compared with the system time,
+		// hence the event is released in the first clock cycle from now on, which matches these.
+		const sc_time period(SYSTIME_PERIOD_NS, SC_NS);
+		const uint64_t next_cycle = (sc_time_stamp().value() + period.value() - 1) / period.value();
+		const uint64_t release_cycle = next_cycle + ((rel_time - next_cycle) & 0x3ff);
+
+		ess::l2tol1_buffer_element element;
+		element.release = sc_time::from_value(release_cycle*period.value());
+		element.order = arrivals++;
+		element.event = buffer;
+		memory.push_back(element);
+		std::push_heap(memory.begin(), memory.end(), ess::l2tol1_buffer_element::released_after);
+		wakeup.notify(element.release - sc_time_stamp());
+		LostEventLogger::count_l2tol1_tx_add_buffer(hicannid);
 	}
 }
 
-//****************************** Needs to be modified to handle correct timestamps
-/// Compare recv time stamp with current sim time.
-/// continously running process that compares 
-/// received timestamps with current simulation time
-/// reinvoked with help of clock
+/// Releases the events of the current clock cycle.
+/// At most one event is released per two clock cycles, a second event is kept in the output buffer,
+/// further events of the same cycle are dropped.
+/// Triggered by wakeup in the cycles of the pending releases and when the output buffer can be sent.
 void l2tol1_tx::check_time()
 {
 	if (_direction == TO_HICANN) {
-	// flag to unlock the output_lock.
-	// it is set to false, if an event has been serialized
-	bool unlock_at_end = true;
+	const sc_time now = sc_time_stamp();
+	const sc_time period(SYSTIME_PERIOD_NS, SC_NS);
 
-	if (!output_lock && out_buffer_valid ) {
+	if (now >= lock_end && out_buffer_valid) {
 		serialize(out_buffer);
 		out_buffer_valid = false;
-		unlock_at_end = false;
-		output_lock = true;
+		lock_end = now + 2*period;
 	}
 
-	sim_time = sc_simulation_time();	// sc_simulation_time returns time as a double in SC_NS(per default, comp. sc_get_default_time_unit
-	uint current_clock_cycle = (uint)(sim_time/SYSTIME_PERIOD_NS) & 0x7fff;
-	for(size_t j=0;j<DNC_IF_2_L2_BUFFERSIZE;++j)
+	while (!memory.empty() && memory.front().release <= now)
 	{
-		if(memory[j].valid == true)
-		{
-			// only 10 last bit:
-			if((memory[j].value & 0x3ff) == (current_clock_cycle & 0x3ff))
-			// if( ((memory[j].value & 0x7fff) - (current_clock_cycle+1))>>(TIMESTAMP_WIDTH-1) & 0x1)
-			// if((memory[j].value & 0x7fff) <= current_clock_cycle)
-			{
+		std::pop_heap(memory.begin(), memory.end(), ess::l2tol1_buffer_element::released_after);
+		const ess::l2_event value = memory.back().event;
+		memory.pop_back();
 
-				if( !output_lock ) {
-					memory[j].valid = false;
-					serialize(memory[j].value >> TIMESTAMP_WIDTH);
-					LostEventLogger::count_l2tol1_tx_check_time();
-					/*
-					_log(Logger::INFO) << "l2tol1_tx::check_time():SERIALIZE  sim_time= " <<  sim_time 
-						<< "\t, current_clock_cycle=" << current_clock_cycle
-						<< "\t, rel_time= " <<  (memory[j].value & 0x7fff)
-						<< "\t, delta=" << (int)(current_clock_cycle-(memory[j].value & 0x7fff))
-						<< "\t, memory=" << j;
-					*/
-
-					output_lock = true;
-					unlock_at_end = false;
-				}
-				// check for output_buffer
-				else if (!out_buffer_valid) {
-					memory[j].valid = false;
-					out_buffer = (memory[j].value >> TIMESTAMP_WIDTH);
-					out_buffer_valid = true;
-					/*
-					_log(Logger::INFO) << "l2tol1_tx::check_time():OUT_BUFFER sim_time= " <<  sim_time 
-						<< "\t, current_clock_cycle=" << current_clock_cycle
-						<< "\t, rel_time= " <<  (memory[j].value & 0x7fff)
-						<< "\t, delta=" << (int)(current_clock_cycle-(memory[j].value & 0x7fff))
-						<< "\t, memory=" << j;
-					*/
-					LostEventLogger::count_l2tol1_tx_check_time();
-				}
-				else {
-					// event is expired -> drop it
-					memory[j].valid = false;
-                    LOG4CXX_DEBUG(logger, name() << ":check_time():DROP        sim_time= " <<  sim_time 
-						<< "\t, current_clock_cycle=" << current_clock_cycle
-						<< "\t, rel_time= " <<  (memory[j].value & 0x7fff)
-						<< "\t, delta=" << (int)(current_clock_cycle-(memory[j].value & 0x7fff))
-						<< "\t, memory=" << j);
-					std::stringstream ss;
-					ss << name() << " check_time(): neither output nor output buffer free";
-					LostEventLogger::log(/*downwards*/ true, ss.str());
-				}
-			}
+		if( now >= lock_end ) {
+			serialize(value.neuron());
+			LostEventLogger::count_l2tol1_tx_check_time(hicannid);
+			lock_end = now + 2*period;
+		}
+		// check for output_buffer
+		else if (!out_buffer_valid) {
+			out_buffer = value.neuron();
+			out_buffer_valid = true;
+			LostEventLogger::count_l2tol1_tx_check_time(hicannid);
+		}
+		else {
+			// event is expired -> drop it
+			LOG4CXX_DEBUG(logger, name() << ":check_time():DROP        sim_time= " <<  sc_simulation_time()
+				<< "\t, current_clock_cycle=" << ((uint)(now.value()/period.value()) & 0x7fff)
+				<< "\t, rel_time= " <<  value.time()
+				<< "\t, delta=" << (int)(((uint)(now.value()/period.value()) & 0x7fff)-value.time()));
+			std::stringstream ss;
+			ss << name() << " check_time(): neither output nor output buffer free";
+			LostEventLogger::log(/*downwards*/ true, ss.str(), hicannid);
 		}
 	}
-	if (unlock_at_end) {
-		output_lock=false;
-	}
+
+	// sleep until the output buffer can be sent or the next event is due
+	if (out_buffer_valid)
+		wakeup.notify(lock_end - now);
+	if (!memory.empty())
+		wakeup.notify(memory.front().release - now);
 	} // direction is TO_HICANN
 }
 
 /// Serializes event at release time.
 /// @param neuron: Neuron number of event
-void l2tol1_tx::serialize(sc_uint <L1_ADDR_WIDTH> neuron)
+void l2tol1_tx::serialize(unsigned int neuron)
 {
 	if( l1bus_tx_if->rcv_pulse_from_dnc_if_channel(neuron, channel_id) ) {
-		LostEventLogger::count_l2tol1_tx_serialize();
+		LostEventLogger::count_l2tol1_tx_serialize(hicannid);
 	} else {
 		std::stringstream ss;
 		ss << name() << " input of dnc_merger is not empty";
-		LostEventLogger::log(/*downwards*/ true, ss.str());
+		LostEventLogger::log(/*downwards*/ true, ss.str(), hicannid);
 	}
 }
 
 void l2tol1_tx::set_direction(enum l2tol1_tx::direction dir) {
 	_direction = dir;
 }
+
+void l2tol1_tx::checkpoint(ess::state_archive& ar)
+{
+	ar.section(name());
+	ar.value(buffer.value);
+	ar.value(out_buffer);
+	ar.value(out_buffer_valid);
+	// the end of the output lock is only stored while it is ahead
+	bool locked = lock_end > sc_time_stamp();
+	ar.value(locked);
+	if (locked)
+		ar.time(lock_end);
+	else if (ar.loading())
+		lock_end = SC_ZERO_TIME;
+	ar.value(arrivals);
+	ar.sequence(memory, [&ar](ess::l2tol1_buffer_element& m){
+		ar.time(m.release);
+		ar.value(m.order);
+		ar.value(m.event.value);
+	});
+	ar.event(rx_data);
+	ar.event(wakeup);
+}
@@ -19,11 +19,15 @@
 // always needed
 #include "systemc.h"
 
+#include <vector>
+
 // defines and helpers
 #include "sim_def.h"
+#include "state_archive.h"
 
 // functional units
 //#include "l1bus_tx.h"
+#include "l2_event.h"
 #include "l2tol1_buffer_element.h"
 #include "spl1_task_if.h"
 
@@ -37,19 +41,21 @@ public:
 		TO_HICANN= 1
 	};
 	sc_port <spl1_task_if, 1, SC_ZERO_OR_MORE_BOUND> l1bus_tx_if;  //!< interface to the spl1-merger tree for sending spikes to the hicann
-	sc_clock clk; ///< reference clock
 
-	double sim_time; ///< contains simulation time
 	short hicannid; ///< id of hicanna
 	int channel_id; ///< id of channel (0..7)
 	direction _direction;
-	bool output_lock; ///<  ensures that output is disabled for one clock cycle after release
-	sc_uint <TIMESTAMP_WIDTH+L1_ADDR_WIDTH> buffer; ///< buffer for events (in!)
-	sc_uint <L1_ADDR_WIDTH> out_buffer; ///< buffer for events, is filled, when two pulse shall fire at the same time.
+	sc_time lock_end; ///< output is disabled until this time, i.e. for one clock cycle after a release
+	ess::l2_event buffer; ///< buffer for events (in!)
+	unsigned int out_buffer; ///< buffer for events, is filled, when two pulse shall fire at the same time.
 	bool out_buffer_valid; ///< valid bit of buffer for events
-	sc_event rx_data; ///< signal at event arrival
+	ess::timed_event rx_data; ///< signal at event arrival
+	ess::timed_event wakeup; ///< notified at the next release and when the output is unlocked
 
-    ess::l2tol1_buffer_element memory[DNC_IF_2_L2_BUFFERSIZE]; ///< memory structure to store events and to offer fast access to timestamp
+	/// events waiting for their release (at most DNC_IF_2_L2_BUFFERSIZE),
+	/// kept as heap with the event released first on top.
+	std::vector<ess::l2tol1_buffer_element> memory;
+	uint64_t arrivals; ///< number of events stored in memory so far
 
 	///SystemC macro to allow continously running event controlled methods
 	SC_HAS_PROCESS(l2tol1_tx);
@@ -59,39 +65,40 @@ public:
 	///\param hicann_id: identificationnumber of hicann
 	///\param channel_id:
 	l2tol1_tx (sc_module_name l2tol1_tx, short hicann_id, int channel_id)
-		:clk("clk",CLK_PER_L2TOL1_TX,SC_NS)
-		, hicannid(hicann_id)
+		: hicannid(hicann_id)
 		, channel_id(channel_id)
 		, _direction(l2tol1_tx::TO_HICANN)
-		, output_lock(false)
+		, lock_end(SC_ZERO_TIME)
 		, out_buffer(0)
 		, out_buffer_valid(false)
+		, arrivals(0)
 	{
 
         //void cast to avoid unused parameter warning
         (void) l2tol1_tx;
 
-		int k;
-		for(k=0;k<DNC_IF_2_L2_BUFFERSIZE;++k)
-		{
-            memory[k].valid = false;
-		}
+		memory.reserve(DNC_IF_2_L2_BUFFERSIZE);
 
+		// check_time only runs in the clock cycles of releases, an idle channel has no activations
 		SC_METHOD(check_time);
 		dont_initialize();
-		sensitive_pos << clk;
+		sensitive << wakeup;
 
 		SC_METHOD(add_buffer);
 		dont_initialize();
 		sensitive << rx_data;
 	}
 
-	void transmit(sc_uint <TIMESTAMP_WIDTH+L1_ADDR_WIDTH>);
+	void transmit(ess::l2_event);
 
+	/// releases the due events, triggered by wakeup
 	void check_time();
-	void serialize(sc_uint <L1_ADDR_WIDTH>);
+	void serialize(unsigned int neuron);
 	void add_buffer();
 	void set_direction(enum l2tol1_tx::direction dir);
+
+	/// stores or restores the dynamic state
+	void checkpoint(ess::state_archive& ar);
 };
 
 #endif //__L2TOL1_TX_H__
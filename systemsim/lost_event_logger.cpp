@@ -1,136 +1,112 @@
 #include "lost_event_logger.h"
 #include "logger.h"
 #include "systemc.h"
+#include "async_writer.h"
+#include "state_archive.h"
 
-unsigned int LostEventLogger::count[2] = {0,0};
-unsigned int LostEventLogger::count_wafer = 0;
-unsigned int LostEventLogger::_count_fpga = 0;
-unsigned int LostEventLogger::_count_pre_sim = 0;
-unsigned int LostEventLogger::_count_dropped_pre_sim = 0;
-
-unsigned int LostEventLogger::_count_dnc_tx_fpga_start_event[2] = {0,0};
-unsigned int LostEventLogger::_count_dnc_tx_fpga_transmit[2] = {0,0};
-unsigned int LostEventLogger::_count_dnc_tx_fpga_transmit_start_event[2] = {0,0};
-unsigned int LostEventLogger::_count_dnc_tx_fpga_receive_event[2] = {0,0};
-unsigned int LostEventLogger::_count_dnc_tx_fpga_fill_fifo[2] = {0,0};
-unsigned int LostEventLogger::_count_dnc_tx_fpga_write_fifo[2] = {0,0};
-
-
-unsigned int LostEventLogger::_count_l2_dnc_fifo_from_fpga_ctrl = 0;
-unsigned int LostEventLogger::_count_l2_dnc_transmit_from_fpga = 0;
-unsigned int LostEventLogger::_count_l2_dnc_transmit_to_anc = 0;
-unsigned int LostEventLogger::_count_l2_dnc_delay_mem_ctrl = 0;
-
-unsigned int LostEventLogger::_count_dnc_ser_channel_start_event[2] = {0,0};
-unsigned int LostEventLogger::_count_dnc_ser_channel_transmit[2] = {0,0};
-unsigned int LostEventLogger::_count_dnc_ser_channel_transmit_start_event[2] = {0,0};
-unsigned int LostEventLogger::_count_dnc_ser_channel_receive_event[2] = {0,0};
-unsigned int LostEventLogger::_count_dnc_ser_channel_fill_fifo[2] = {0,0};
-unsigned int LostEventLogger::_count_dnc_ser_channel_write_fifo[2] = {0,0};
-
-unsigned int LostEventLogger::_count_dnc_if_rx_l2_ctrl= 0;
-unsigned int LostEventLogger::_count_dnc_if_receive_event= 0;
-unsigned int LostEventLogger::_count_l2tol1_tx_transmit= 0;
-unsigned int LostEventLogger::_count_l2tol1_tx_add_buffer= 0;
-unsigned int LostEventLogger::_count_l2tol1_tx_check_time= 0;
-unsigned int LostEventLogger::_count_l2tol1_tx_serialize= 0;
-
-
-unsigned int LostEventLogger::_count_dnc_if_l1_task_if = 0;
-unsigned int LostEventLogger::_count_dnc_if_start_pulse_dnc = 0;
-unsigned int LostEventLogger::_count_l2_dnc_fifo_from_anc_ctrl = 0;
-unsigned int LostEventLogger::_count_l2_dnc_transmit_from_anc = 0;
-unsigned int LostEventLogger::_count_l2_fpga_fifo_from_l2_ctrl = 0;
-unsigned int LostEventLogger::_count_l2_fpga_transmit_l2_event = 0;
-unsigned int LostEventLogger::_count_l2_fpga_record_rx_event = 0;
-
-unsigned int LostEventLogger::_count_neuron_fired = 0;
-unsigned int LostEventLogger::_count_priority_encoder_rcv_event = 0;
-unsigned int LostEventLogger::_count_priority_encoder_send_event = 0;
+std::array<LostEventLogger::hicann_counters, LostEventLogger::num_hicann_slots> LostEventLogger::_counters;
+const unsigned int LostEventLogger::no_hicann;
+const unsigned int LostEventLogger::num_hicann_slots;
 
 Logger::levels LostEventLogger::_loglevel = Logger::DEBUG1;
 
+unsigned int LostEventLogger::total(counter c)
+{
+	unsigned int sum = 0;
+	for (auto const& hicann : _counters)
+		sum += hicann.c[c].load(std::memory_order_relaxed);
+	return sum;
+}
+
 void LostEventLogger::summary() {
 	Logger& log = Logger::instance();
+	// aggregate per-HICANN counters
+	const unsigned int count[2] = { total(lost_l2), total(lost_l2_down) };
+	const unsigned int lost_on_wafer = total(lost_wafer);
+	const unsigned int sent_fpga = total(fpga);
+	const unsigned int before_sim = total(pre_sim);
+	const unsigned int dropped_before_sim = total(dropped_pre_sim);
+	const unsigned int sent_dnc_if = total(dnc_if_l1_task_if);
+	const unsigned int sent_neurons = total(neuron_fired);
 	log(Logger::INFO) << "*************************************";
 	log(Logger::INFO) << "LostEventLogger::summary";
 	unsigned int total_lost_l2 = count[0] + count[1];
-	unsigned int total_sent_l2 = _count_fpga + _count_dnc_if_l1_task_if;
-	log(Logger::INFO) << "Layer 2 events dropped before sim : " << _count_dropped_pre_sim << "/" << _count_pre_sim << " (" << ( _count_pre_sim > 0 ?(_count_dropped_pre_sim*100./_count_pre_sim): 0 ) << " %)";
+	unsigned int total_sent_l2 = sent_fpga + sent_dnc_if;
+	log(Logger::INFO) << "Layer 2 events dropped before sim : " << dropped_before_sim << "/" << before_sim << " (" << ( before_sim > 0 ?(dropped_before_sim*100./before_sim): 0 ) << " %)";
 	log(Logger::INFO) << "Layer 2 events lost :               " << total_lost_l2 << "/" << total_sent_l2 << " (" << ( total_sent_l2 > 0 ?(total_lost_l2*100./total_sent_l2): 0 ) << " %)";
-	log(Logger::INFO) << "Layer 2 events lost downwards :     " << count[1] << "/" << _count_fpga << " (" << ( _count_fpga > 0 ? (count[1]*100./_count_fpga): 0) << " %)";
-	log(Logger::INFO) << "Layer 2 events lost upwards   :     " << count[0] << "/" << _count_dnc_if_l1_task_if << " (" << (_count_dnc_if_l1_task_if > 0 ? (count[0]*100./_count_dnc_if_l1_task_if):0) << " %)";
-	log(Logger::INFO) << "Layer 1 events lost : " << count_wafer << "/" << _count_neuron_fired<< " (" << (_count_neuron_fired> 0 ? (count_wafer*100./_count_neuron_fired):0) << " %)";
+	log(Logger::INFO) << "Layer 2 events lost downwards :     " << count[1] << "/" << sent_fpga << " (" << ( sent_fpga > 0 ? (count[1]*100./sent_fpga): 0) << " %)";
+	log(Logger::INFO) << "Layer 2 events lost upwards   :     " << count[0] << "/" << sent_dnc_if << " (" << (sent_dnc_if > 0 ? (count[0]*100./sent_dnc_if):0) << " %)";
+	log(Logger::INFO) << "Layer 1 events lost : " << lost_on_wafer << "/" << sent_neurons<< " (" << (sent_neurons> 0 ? (lost_on_wafer*100./sent_neurons):0) << " %)";
 	log(Logger::INFO) << "*************************************";
 	if ( log.willBeLogged(_loglevel) ){
 		log(_loglevel) << "DOWNSTREAM";
 		log(_loglevel) << "*************************************";
-		log(_loglevel) << "Events sent l2_fpga::play_tx_event:            " << _count_fpga;
-		log(_loglevel) << "Events sent dnc_tx_fpga::start_event:          " << _count_dnc_tx_fpga_start_event[1];
-		log(_loglevel) << "Events sent dnc_tx_fpga::transmit:             " << _count_dnc_tx_fpga_transmit[1];
-		log(_loglevel) << "Events sent dnc_tx_fpga::transmit_start_event: " << _count_dnc_tx_fpga_transmit_start_event[1];
-		log(_loglevel) << "Events sent dnc_tx_fpga::receive_event:        " << _count_dnc_tx_fpga_receive_event[1];
-		log(_loglevel) << "Events sent dnc_tx_fpga::fill_fifo:            " << _count_dnc_tx_fpga_fill_fifo[1];
-		log(_loglevel) << "Events sent dnc_tx_fpga::write_fifo:           " << _count_dnc_tx_fpga_write_fifo[1];
-		log(_loglevel) << "Events sent l2_dnc::fifo_from_fpga_ctrl:       " << _count_l2_dnc_fifo_from_fpga_ctrl;
-		log(_loglevel) << "Events sent l2_dnc::transmit_from_fpga:        " << _count_l2_dnc_transmit_from_fpga;
-		log(_loglevel) << "Events sent l2_dnc::transmit_to_anc:           " << _count_l2_dnc_transmit_to_anc;
-		log(_loglevel) << "Events sent l2_dnc::delay_mem_ctrl:            " << _count_l2_dnc_delay_mem_ctrl;
-		log(_loglevel) << "Events sent dnc_ser_channel::start_event:      " << _count_dnc_ser_channel_start_event[1];
-		log(_loglevel) << "Events sent dnc_ser_channel::transmit:         " << _count_dnc_ser_channel_transmit[1];
-		log(_loglevel) << "Events sent dnc_ser_channel::transmit_start_event: " << _count_dnc_ser_channel_transmit_start_event[1];
-		log(_loglevel) << "Events sent dnc_ser_channel::receive_event:    " << _count_dnc_ser_channel_receive_event[1];
-		log(_loglevel) << "Events sent dnc_ser_channel::fill_fifo:        " << _count_dnc_ser_channel_fill_fifo[1];
-		log(_loglevel) << "Events sent dnc_ser_channel::write_fifo:       " << _count_dnc_ser_channel_write_fifo[1];
-		log(_loglevel) << "Events sent dnc_if::rx_l2_ctrl:                " << _count_dnc_if_rx_l2_ctrl;
-		log(_loglevel) << "Events sent dnc_if::receive_event:             " << _count_dnc_if_receive_event;
-		log(_loglevel) << "Events sent l2tol1_tx::transmit:               " << _count_l2tol1_tx_transmit;
-		log(_loglevel) << "Events sent l2tol1_tx::add_buffer:             " << _count_l2tol1_tx_add_buffer;
-		log(_loglevel) << "Events sent l2tol1_tx::check_time:             " << _count_l2tol1_tx_check_time;
-		log(_loglevel) << "Events sent l2tol1_tx::serialize:              " << _count_l2tol1_tx_serialize;
+		log(_loglevel) << "Events sent l2_fpga::play_tx_event:            " << sent_fpga;
+		log(_loglevel) << "Events sent dnc_tx_fpga::start_event:          " << total(dnc_tx_fpga_start_event_down);
+		log(_loglevel) << "Events sent dnc_tx_fpga::transmit:             " << total(dnc_tx_fpga_transmit_down);
+		log(_loglevel) << "Events sent dnc_tx_fpga::transmit_start_event: " << total(dnc_tx_fpga_transmit_start_event_down);
+		log(_loglevel) << "Events sent dnc_tx_fpga::receive_event:        " << total(dnc_tx_fpga_receive_event_down);
+		log(_loglevel) << "Events sent dnc_tx_fpga::fill_fifo:            " << total(dnc_tx_fpga_fill_fifo_down);
+		log(_loglevel) << "Events sent dnc_tx_fpga::write_fifo:           " << total(dnc_tx_fpga_write_fifo_down);
+		log(_loglevel) << "Events sent l2_dnc::fifo_from_fpga_ctrl:       " << total(l2_dnc_fifo_from_fpga_ctrl);
+		log(_loglevel) << "Events sent l2_dnc::transmit_from_fpga:        " << total(l2_dnc_transmit_from_fpga);
+		log(_loglevel) << "Events sent l2_dnc::transmit_to_anc:           " << total(l2_dnc_transmit_to_anc);
+		log(_loglevel) << "Events sent l2_dnc::delay_mem_ctrl:            " << total(l2_dnc_delay_mem_ctrl);
+		log(_loglevel) << "Events sent dnc_ser_channel::start_event:      " << total(dnc_ser_channel_start_event_down);
+		log(_loglevel) << "Events sent dnc_ser_channel::transmit:         " << total(dnc_ser_channel_transmit_down);
+		log(_loglevel) << "Events sent dnc_ser_channel::transmit_start_event: " << total(dnc_ser_channel_transmit_start_event_down);
+		log(_loglevel) << "Events sent dnc_ser_channel::receive_event:    " << total(dnc_ser_channel_receive_event_down);
+		log(_loglevel) << "Events sent dnc_ser_channel::fill_fifo:        " << total(dnc_ser_channel_fill_fifo_down);
+		log(_loglevel) << "Events sent dnc_ser_channel::write_fifo:       " << total(dnc_ser_channel_write_fifo_down);
+		log(_loglevel) << "Events sent dnc_if::rx_l2_ctrl:                " << total(dnc_if_rx_l2_ctrl);
+		log(_loglevel) << "Events sent dnc_if::receive_event:             " << total(dnc_if_receive_event);
+		log(_loglevel) << "Events sent l2tol1_tx::transmit:               " << total(l2tol1_tx_transmit);
+		log(_loglevel) << "Events sent l2tol1_tx::add_buffer:             " << total(l2tol1_tx_add_buffer);
+		log(_loglevel) << "Events sent l2tol1_tx::check_time:             " << total(l2tol1_tx_check_time);
+		log(_loglevel) << "Events sent l2tol1_tx::serialize:              " << total(l2tol1_tx_serialize);
 		log(_loglevel) << "*************************************";
 		log(_loglevel) << "*************************************";
 		log(_loglevel) << "UPSTREAM";
 		log(_loglevel) << "*************************************";
-		log(_loglevel) << "Events send dnc_if::l1_task_if:                " << _count_dnc_if_l1_task_if;
-		log(_loglevel) << "Events send dnc_if::start_pulse_dnc:           " << _count_dnc_if_start_pulse_dnc;
-		log(_loglevel) << "Events sent dnc_ser_channel::start_event:      " << _count_dnc_ser_channel_start_event[0];
-		log(_loglevel) << "Events sent dnc_ser_channel::transmit:         " << _count_dnc_ser_channel_transmit[0];
-		log(_loglevel) << "Events sent dnc_ser_channel::transmit_start_event: " << _count_dnc_ser_channel_transmit_start_event[0];
-		log(_loglevel) << "Events sent dnc_ser_channel::receive_event:    " << _count_dnc_ser_channel_receive_event[0];
-		log(_loglevel) << "Events sent dnc_ser_channel::fill_fifo:        " << _count_dnc_ser_channel_fill_fifo[0];
-		log(_loglevel) << "Events sent dnc_ser_channel::write_fifo:       " << _count_dnc_ser_channel_write_fifo[0];
-		log(_loglevel) << "Events send l2_dnc::fifo_from_anc_ctrl:        " << _count_l2_dnc_fifo_from_anc_ctrl;
-		log(_loglevel) << "Events send l2_dnc::transmit_from_anc:         " << _count_l2_dnc_transmit_from_anc;
-		log(_loglevel) << "Events sent dnc_tx_fpga::start_event:          " << _count_dnc_tx_fpga_start_event[0];
-		log(_loglevel) << "Events sent dnc_tx_fpga::transmit:             " << _count_dnc_tx_fpga_transmit[0];
-		log(_loglevel) << "Events sent dnc_tx_fpga::transmit_start_event: " << _count_dnc_tx_fpga_transmit_start_event[0];
-		log(_loglevel) << "Events sent dnc_tx_fpga::receive_event:        " << _count_dnc_tx_fpga_receive_event[0];
-		log(_loglevel) << "Events sent dnc_tx_fpga::fill_fifo:            " << _count_dnc_tx_fpga_fill_fifo[0];
-		log(_loglevel) << "Events sent dnc_tx_fpga::write_fifo:           " << _count_dnc_tx_fpga_write_fifo[0];
-		log(_loglevel) << "Events send l2_fpga::fifo_from_l2_ctrl:        " << _count_l2_fpga_fifo_from_l2_ctrl;
-		log(_loglevel) << "Events send l2_fpga::transmit_l2_event:        " << _count_l2_fpga_transmit_l2_event;
-		log(_loglevel) << "Events send l2_fpga::record_rx_event:          " << _count_l2_fpga_record_rx_event;
+		log(_loglevel) << "Events send dnc_if::l1_task_if:                " << sent_dnc_if;
+		log(_loglevel) << "Events send dnc_if::start_pulse_dnc:           " << total(dnc_if_start_pulse_dnc);
+		log(_loglevel) << "Events sent dnc_ser_channel::start_event:      " << total(dnc_ser_channel_start_event);
+		log(_loglevel) << "Events sent dnc_ser_channel::transmit:         " << total(dnc_ser_channel_transmit);
+		log(_loglevel) << "Events sent dnc_ser_channel::transmit_start_event: " << total(dnc_ser_channel_transmit_start_event);
+		log(_loglevel) << "Events sent dnc_ser_channel::receive_event:    " << total(dnc_ser_channel_receive_event);
+		log(_loglevel) << "Events sent dnc_ser_channel::fill_fifo:        " << total(dnc_ser_channel_fill_fifo);
+		log(_loglevel) << "Events sent dnc_ser_channel::write_fifo:       " << total(dnc_ser_channel_write_fifo);
+		log(_loglevel) << "Events send l2_dnc::fifo_from_anc_ctrl:        " << total(l2_dnc_fifo_from_anc_ctrl);
+		log(_loglevel) << "Events send l2_dnc::transmit_from_anc:         " << total(l2_dnc_transmit_from_anc);
+		log(_loglevel) << "Events sent dnc_tx_fpga::start_event:          " << total(dnc_tx_fpga_start_event);
+		log(_loglevel) << "Events sent dnc_tx_fpga::transmit:             " << total(dnc_tx_fpga_transmit);
+		log(_loglevel) << "Events sent dnc_tx_fpga::transmit_start_event: " << total(dnc_tx_fpga_transmit_start_event);
+		log(_loglevel) << "Events sent dnc_tx_fpga::receive_event:        " << total(dnc_tx_fpga_receive_event);
+		log(_loglevel) << "Events sent dnc_tx_fpga::fill_fifo:            " << total(dnc_tx_fpga_fill_fifo);
+		log(_loglevel) << "Events sent dnc_tx_fpga::write_fifo:           " << total(dnc_tx_fpga_write_fifo);
+		log(_loglevel) << "Events send l2_fpga::fifo_from_l2_ctrl:        " << total(l2_fpga_fifo_from_l2_ctrl);
+		log(_loglevel) << "Events send l2_fpga::transmit_l2_event:        " << total(l2_fpga_transmit_l2_event);
+		log(_loglevel) << "Events send l2_fpga::record_rx_event:          " << total(l2_fpga_record_rx_event);
 		log(_loglevel) << "*************************************";
 		log(_loglevel) << "*************************************";
 		log(_loglevel) << "ON WAFER";
 		log(_loglevel) << "*************************************";
-		log(_loglevel) << "Events sent by neurons:                " << _count_neuron_fired;
-		log(_loglevel) << "Events registered by priority encoder: " << _count_priority_encoder_rcv_event;
-		log(_loglevel) << "Events handleld by merger tree:        " << _count_priority_encoder_send_event;
+		log(_loglevel) << "Events sent by neurons:                " << sent_neurons;
+		log(_loglevel) << "Events registered by priority encoder: " << total(priority_encoder_rcv_event);
+		log(_loglevel) << "Events handleld by merger tree:        " << total(priority_encoder_send_event);
 		log(_loglevel) << "*************************************";
 	}
 }
 
-void LostEventLogger::log(bool downwards, std::string location){
-	count[downwards]++;
+void LostEventLogger::log(bool downwards, std::string location, unsigned int hicann){
+	inc(lost_l2, downwards, hicann);
 	Logger& Log = Logger::instance();
 	if (Log.willBeLogged(_loglevel))
 		Log(_loglevel) << "Lost L2 Event @ " << sc_simulation_time() << " ns in " << location;
 }
 
-void LostEventLogger::log_wafer(std::string location){
-	count_wafer++;
+void LostEventLogger::log_wafer(std::string location, unsigned int hicann){
+	inc(lost_wafer, hicann);
 	Logger& Log = Logger::instance();
 	if (Log.willBeLogged(_loglevel))
 		Log(_loglevel) << "Lost L1 Event @ " << sc_simulation_time() << " ns in " << location;
@@ -138,81 +114,36 @@ void LostEventLogger::log_wafer(std::string location){
 
 void LostEventLogger::print_summary_to_file(std::string file)
 {
-	std::ofstream fout;
-	fout.open(file.c_str());
-	fout << "pulse_statistics = {\n";
-	fout << "'l2_down_before_sim' :" << _count_pre_sim << ",\n";
-	fout << "'l2_down_dropped_before_sim' :" << _count_dropped_pre_sim << ",\n";
-	fout << "'l2_down_sent' :" << _count_fpga << ",\n";
-	fout << "'l2_down_lost' :" << count[1] << ",\n";
-	fout << "'l2_up_sent' :" << _count_dnc_if_l1_task_if << ",\n";
-	fout << "'l2_up_lost' :" << count[0] << ",\n";
-	fout << "'l1_neuron_sent' :" << _count_neuron_fired << ",\n";
-	fout << "'l1_neuron_lost' :" << count_wafer << ",\n";
-	fout << "}\n";
+	ess::async_file fout;
+	fout.open(file, "w");
+	fout.printf("pulse_statistics = {\n");
+	fout.printf("'l2_down_before_sim' :%u,\n", total(pre_sim));
+	fout.printf("'l2_down_dropped_before_sim' :%u,\n", total(dropped_pre_sim));
+	fout.printf("'l2_down_sent' :%u,\n", total(fpga));
+	fout.printf("'l2_down_lost' :%u,\n", total(lost_l2_down));
+	fout.printf("'l2_up_sent' :%u,\n", total(dnc_if_l1_task_if));
+	fout.printf("'l2_up_lost' :%u,\n", total(lost_l2));
+	fout.printf("'l1_neuron_sent' :%u,\n", total(neuron_fired));
+	fout.printf("'l1_neuron_lost' :%u,\n", total(lost_wafer));
+	fout.printf("}\n");
 
 	fout.close();
 }
+
 void LostEventLogger::reset()
 {
-	count[0] = 0;
-	count[1] = 0;
-	count_wafer = 0;
-	_count_fpga = 0;
-	_count_pre_sim = 0;
-	_count_dropped_pre_sim = 0;
-
-	_count_dnc_tx_fpga_start_event[0] = 0;
-	_count_dnc_tx_fpga_transmit[0] = 0;
-	_count_dnc_tx_fpga_transmit_start_event[0] = 0;
-	_count_dnc_tx_fpga_receive_event[0] = 0;
-	_count_dnc_tx_fpga_fill_fifo[0] = 0;
-	_count_dnc_tx_fpga_write_fifo[0] = 0;
-
-	_count_dnc_tx_fpga_start_event[1] = 0;
-	_count_dnc_tx_fpga_transmit[1] = 0;
-	_count_dnc_tx_fpga_transmit_start_event[1] = 0;
-	_count_dnc_tx_fpga_receive_event[1] = 0;
-	_count_dnc_tx_fpga_fill_fifo[1] = 0;
-	_count_dnc_tx_fpga_write_fifo[1] = 0;
-
-
-	_count_l2_dnc_fifo_from_fpga_ctrl = 0;
-	_count_l2_dnc_transmit_from_fpga = 0;
-	_count_l2_dnc_transmit_to_anc = 0;
-	_count_l2_dnc_delay_mem_ctrl = 0;
-
-	_count_dnc_ser_channel_start_event[0] = 0;
-	_count_dnc_ser_channel_transmit[0] = 0;
-	_count_dnc_ser_channel_transmit_start_event[0] = 0;
-	_count_dnc_ser_channel_receive_event[0] = 0;
-	_count_dnc_ser_channel_fill_fifo[0] = 0;
-	_count_dnc_ser_channel_write_fifo[0] = 0;
-
-	_count_dnc_ser_channel_start_event[1] = 0;
-	_count_dnc_ser_channel_transmit[1] = 0;
-	_count_dnc_ser_channel_transmit_start_event[1] = 0;
-	_count_dnc_ser_channel_receive_event[1] = 0;
-	_count_dnc_ser_channel_fill_fifo[1] = 0;
-	_count_dnc_ser_channel_write_fifo[1] = 0;
-
-	_count_dnc_if_rx_l2_ctrl= 0;
-	_count_dnc_if_receive_event= 0;
-	_count_l2tol1_tx_transmit= 0;
-	_count_l2tol1_tx_add_buffer= 0;
-	_count_l2tol1_tx_check_time= 0;
-	_count_l2tol1_tx_serialize= 0;
-
-
-	_count_dnc_if_l1_task_if = 0;
-	_count_dnc_if_start_pulse_dnc = 0;
-	_count_l2_dnc_fifo_from_anc_ctrl = 0;
-	_count_l2_dnc_transmit_from_anc = 0;
-	_count_l2_fpga_fifo_from_l2_ctrl = 0;
-	_count_l2_fpga_transmit_l2_event = 0;
-	_count_l2_fpga_record_rx_event = 0;
+	for (auto& hicann : _counters)
+		for (auto& c : hicann.c)
+			c.store(0, std::memory_order_relaxed);
+}
 
-	_count_neuron_fired = 0;
-	_count_priority_encoder_rcv_event = 0;
-	_count_priority_encoder_send_event = 0;
+void LostEventLogger::checkpoint(ess::state_archive& ar)
+{
+	ar.section("LostEventLogger");
+	for (auto& hicann : _counters)
+		for (auto& c : hicann.c) {
+			unsigned int v = c.load(std::memory_order_relaxed);
+			ar.value(v);
+			c.store(v, std::memory_order_relaxed);
+		}
 }
@@ -1,129 +1,173 @@
 #ifndef _LOST_EVENT_LOGGER_H_
 #define _LOST_EVENT_LOGGER_H_
 
+#include <array>
+#include <atomic>
 #include <string>
 #include "logger.h"
 
+namespace ess { class state_archive; }
+
+/** Counts sent and lost pulse events along the pulse path.
+ * There is one counter per stage and HICANN. Counters are relaxed atomics,
+ * so they can be incremented from parallel simulation threads without locks.
+ * Stages outside of a HICANN (FPGA, DNC) count into the slot `no_hicann`.
+ * summary() and print_summary_to_file() report the totals over all HICANNs.
+ */
 struct LostEventLogger {
+public:
+	/// slot for events that can not be assigned to a HICANN
+	static const unsigned int no_hicann = 384;
+	static const unsigned int num_hicann_slots = no_hicann + 1;
+
+	/// stages of the pulse path.
+	/// Stages with a direction use two consecutive ids: upwards, downwards
+	enum counter {
+		lost_l2 = 0, // lost L2 events, [upwards, downwards]
+		lost_l2_down,
+		lost_wafer,
+		fpga,
+		pre_sim, // all events before simulation
+		dropped_pre_sim, // dropped events before simulation
+		// fpga side
+		dnc_tx_fpga_start_event,
+		dnc_tx_fpga_start_event_down,
+		dnc_tx_fpga_transmit,
+		dnc_tx_fpga_transmit_down,
+		dnc_tx_fpga_transmit_start_event,
+		dnc_tx_fpga_transmit_start_event_down,
+		// dnc side
+		dnc_tx_fpga_receive_event,
+		dnc_tx_fpga_receive_event_down,
+		dnc_tx_fpga_fill_fifo,
+		dnc_tx_fpga_fill_fifo_down,
+		dnc_tx_fpga_write_fifo,
+		dnc_tx_fpga_write_fifo_down,
+		// dnc
+		l2_dnc_fifo_from_fpga_ctrl,
+		l2_dnc_transmit_from_fpga,
+		l2_dnc_transmit_to_anc,
+		l2_dnc_delay_mem_ctrl,
+		// dnc_ser_channel
+		// dnc side
+		dnc_ser_channel_start_event,
+		dnc_ser_channel_start_event_down,
+		dnc_ser_channel_transmit,
+		dnc_ser_channel_transmit_down,
+		dnc_ser_channel_transmit_start_event,
+		dnc_ser_channel_transmit_start_event_down,
+		// dnc_if side
+		dnc_ser_channel_receive_event,
+		dnc_ser_channel_receive_event_down,
+		dnc_ser_channel_fill_fifo,
+		dnc_ser_channel_fill_fifo_down,
+		dnc_ser_channel_write_fifo,
+		dnc_ser_channel_write_fifo_down,
+		// dnc _if
+		dnc_if_rx_l2_ctrl,
+		dnc_if_receive_event,
+		// l2tol1_tx
+		l2tol1_tx_transmit,
+		l2tol1_tx_add_buffer,
+		l2tol1_tx_check_time,
+		l2tol1_tx_serialize,
+
+		// upstream
+		// dnc_if
+		dnc_if_l1_task_if,
+		dnc_if_start_pulse_dnc,
+		// l2_dnc
+		l2_dnc_fifo_from_anc_ctrl,
+		l2_dnc_transmit_from_anc,
+		// l2_fpga
+		l2_fpga_fifo_from_l2_ctrl,
+		l2_fpga_transmit_l2_event,
+		l2_fpga_record_rx_event,
+
+		// SPL1 Merger-Tree and Priority-Encoder
+		neuron_fired,
+		priority_encoder_rcv_event,
+		priority_encoder_send_event,
+
+		num_counters
+	};
+
 private:
-	static unsigned int count[2];
-	static unsigned int count_wafer;
-	static unsigned int _count_fpga;
-
-	// before simulation
-	static unsigned int _count_pre_sim; // dropped events before simulation
-	static unsigned int _count_dropped_pre_sim; // all events before simulation
-	// fpga side
-	static unsigned int _count_dnc_tx_fpga_start_event[2];
-	static unsigned int _count_dnc_tx_fpga_transmit[2];
-	static unsigned int _count_dnc_tx_fpga_transmit_start_event[2];
-	// dnc side
-	static unsigned int _count_dnc_tx_fpga_receive_event[2];
-	static unsigned int _count_dnc_tx_fpga_fill_fifo[2];
-	static unsigned int _count_dnc_tx_fpga_write_fifo[2];
-	// dnc
-	static unsigned int _count_l2_dnc_fifo_from_fpga_ctrl;
-	static unsigned int _count_l2_dnc_transmit_from_fpga;
-	static unsigned int _count_l2_dnc_transmit_to_anc;
-	static unsigned int _count_l2_dnc_delay_mem_ctrl;
-	// dnc_ser_channel
-	// dnc side
-	static unsigned int _count_dnc_ser_channel_start_event[2];
-	static unsigned int _count_dnc_ser_channel_transmit[2];
-	static unsigned int _count_dnc_ser_channel_transmit_start_event[2];
-	// dnc_if side
-	static unsigned int _count_dnc_ser_channel_receive_event[2];
-	static unsigned int _count_dnc_ser_channel_fill_fifo[2];
-	static unsigned int _count_dnc_ser_channel_write_fifo[2];
-
-	// dnc _if
-	static unsigned int _count_dnc_if_rx_l2_ctrl;
-	static unsigned int _count_dnc_if_receive_event;
-	// l2tol1_tx
-	static unsigned int _count_l2tol1_tx_transmit;
-	static unsigned int _count_l2tol1_tx_add_buffer;
-	static unsigned int _count_l2tol1_tx_check_time;
-	static unsigned int _count_l2tol1_tx_serialize;
-
-
-	// upstream
-	// dnc_if
-	static unsigned int _count_dnc_if_l1_task_if;
-	static unsigned int _count_dnc_if_start_pulse_dnc;
-	// dnc_ser_channel
-	// l2_dnc
-	static unsigned int _count_l2_dnc_fifo_from_anc_ctrl;
-	static unsigned int _count_l2_dnc_transmit_from_anc;
-	// dnc_tx_fpga
-	// l2_fpga
-	static unsigned int _count_l2_fpga_fifo_from_l2_ctrl;
-	static unsigned int _count_l2_fpga_transmit_l2_event;
-	static unsigned int _count_l2_fpga_record_rx_event;
-
-
-	// SPL1 Merger-Tree and Priority-Encoder
-	static unsigned int _count_neuron_fired;
-	static unsigned int _count_priority_encoder_rcv_event;
-	static unsigned int _count_priority_encoder_send_event;
+	/// counters of one HICANN, aligned so that HICANNs do not share cache lines
+	struct alignas(64) hicann_counters {
+		std::array<std::atomic<unsigned int>, num_counters> c;
+	};
+	static std::array<hicann_counters, num_hicann_slots> _counters;
 
 	static Logger::levels _loglevel; // Loglevel for detailed summary and logging of individual lost events. default: DEBUG1
 
+	static void inc(counter c, unsigned int hicann) {
+		_counters[hicann < num_hicann_slots ? hicann : no_hicann].c[c].fetch_add(1, std::memory_order_relaxed);
+	}
+	static void inc(counter c, bool downwards, unsigned int hicann) {
+		inc(static_cast<counter>(c + downwards), hicann);
+	}
+
 public:
-	static void log(bool downwards) {
-		count[downwards]++;
+	/// number of events counted in stage c on HICANN hicann
+	static unsigned int get(counter c, unsigned int hicann) {
+		return _counters.at(hicann).c[c].load(std::memory_order_relaxed);
 	}
-	static void log_pre_sim() {
-		_count_dropped_pre_sim++;
+	/// number of events counted in stage c on all HICANNs
+	static unsigned int total(counter c);
+
+	static void log(bool downwards, unsigned int hicann = no_hicann) {
+		inc(lost_l2, downwards, hicann);
 	}
-	static void log(bool downwards, std::string location);
-	static void log_wafer(std::string location); /// logs a lost event on the wafer(i.e. between neurons and spl1 merger)
-	static void count_pre_sim() { _count_pre_sim++; }
-	static void count_fpga(){ _count_fpga++;}
-
-	static void count_dnc_tx_fpga_start_event(bool downwards){_count_dnc_tx_fpga_start_event[downwards]++;}
-	static void count_dnc_tx_fpga_transmit(bool downwards){_count_dnc_tx_fpga_transmit[downwards]++;}
-	static void count_dnc_tx_fpga_transmit_start_event(bool downwards){_count_dnc_tx_fpga_transmit_start_event[downwards]++;}
-	static void count_dnc_tx_fpga_receive_event(bool downwards){_count_dnc_tx_fpga_receive_event[downwards]++;}
-	static void count_dnc_tx_fpga_fill_fifo(bool downwards){_count_dnc_tx_fpga_fill_fifo[downwards]++;}
-	static void count_dnc_tx_fpga_write_fifo(bool downwards){_count_dnc_tx_fpga_write_fifo[downwards]++;}
-
-	static void count_l2_dnc_fifo_from_fpga_ctrl(){_count_l2_dnc_fifo_from_fpga_ctrl++;}
-	static void count_l2_dnc_transmit_from_fpga(){_count_l2_dnc_transmit_from_fpga++;}
-	// static void xxx(){xxx++;}
-	static void count_l2_dnc_transmit_to_anc(){_count_l2_dnc_transmit_to_anc++;}
-	static void count_l2_dnc_delay_mem_ctrl(){_count_l2_dnc_delay_mem_ctrl++;}
-
-	static void count_dnc_ser_channel_start_event(bool downwards){ _count_dnc_ser_channel_start_event[downwards]++;}
-	static void count_dnc_ser_channel_transmit(bool downwards){_count_dnc_ser_channel_transmit[downwards]++;}
-	static void count_dnc_ser_channel_transmit_start_event(bool downwards) {_count_dnc_ser_channel_transmit_start_event[downwards]++;}
-	static void count_dnc_ser_channel_receive_event(bool downwards) {_count_dnc_ser_channel_receive_event[downwards]++;}
-	static void count_dnc_ser_channel_fill_fifo(bool downwards){_count_dnc_ser_channel_fill_fifo[downwards]++;}
-	static void count_dnc_ser_channel_write_fifo(bool downwards){_count_dnc_ser_channel_write_fifo[downwards]++;}
-
-	static void count_dnc_if_rx_l2_ctrl() {_count_dnc_if_rx_l2_ctrl++;}
-	static void count_dnc_if_receive_event() {_count_dnc_if_receive_event++;}
-	static void count_l2tol1_tx_transmit(){ _count_l2tol1_tx_transmit++;}
-	static void count_l2tol1_tx_add_buffer(){ _count_l2tol1_tx_add_buffer++;}
-	static void count_l2tol1_tx_check_time(){ _count_l2tol1_tx_check_time++;}
-	static void count_l2tol1_tx_serialize(){ _count_l2tol1_tx_serialize++;}
-
-
-
-	static void count_dnc_if_l1_task_if() { _count_dnc_if_l1_task_if++;}
-	static void count_dnc_if_start_pulse_dnc() { _count_dnc_if_start_pulse_dnc++;}
-	static void count_l2_dnc_fifo_from_anc_ctrl() { _count_l2_dnc_fifo_from_anc_ctrl++;}
-	static void count_l2_dnc_transmit_from_anc() { _count_l2_dnc_transmit_from_anc++;}
-	static void count_l2_fpga_fifo_from_l2_ctrl() { _count_l2_fpga_fifo_from_l2_ctrl++;}
-	static void count_l2_fpga_transmit_l2_event() { _count_l2_fpga_transmit_l2_event++;}
-	static void count_l2_fpga_record_rx_event() { _count_l2_fpga_record_rx_event++;}
-
-	static void count_neuron_fired() {_count_neuron_fired++;}
-	static void count_priority_encoder_rcv_event() {_count_priority_encoder_rcv_event++;}
-	static void count_priority_encoder_send_event() {_count_priority_encoder_send_event++;}
+	static void log_pre_sim() { inc(dropped_pre_sim, no_hicann); }
+	static void log(bool downwards, std::string location, unsigned int hicann = no_hicann);
+	static void log_wafer(std::string location, unsigned int hicann = no_hicann); /// logs a lost event on the wafer(i.e. between neurons and spl1 merger)
+	static void count_pre_sim() { inc(pre_sim, no_hicann); }
+	static void count_fpga(){ inc(fpga, no_hicann); }
+
+	static void count_dnc_tx_fpga_start_event(bool downwards){ inc(dnc_tx_fpga_start_event, downwards, no_hicann); }
+	static void count_dnc_tx_fpga_transmit(bool downwards){ inc(dnc_tx_fpga_transmit, downwards, no_hicann); }
+	static void count_dnc_tx_fpga_transmit_start_event(bool downwards){ inc(dnc_tx_fpga_transmit_start_event, downwards, no_hicann); }
+	static void count_dnc_tx_fpga_receive_event(bool downwards){ inc(dnc_tx_fpga_receive_event, downwards, no_hicann); }
+	static void count_dnc_tx_fpga_fill_fifo(bool downwards){ inc(dnc_tx_fpga_fill_fifo, downwards, no_hicann); }
+	static void count_dnc_tx_fpga_write_fifo(bool downwards){ inc(dnc_tx_fpga_write_fifo, downwards, no_hicann); }
+
+	static void count_l2_dnc_fifo_from_fpga_ctrl(){ inc(l2_dnc_fifo_from_fpga_ctrl, no_hicann); }
+	static void count_l2_dnc_transmit_from_fpga(){ inc(l2_dnc_transmit_from_fpga, no_hicann); }
+	static void count_l2_dnc_transmit_to_anc(){ inc(l2_dnc_transmit_to_anc, no_hicann); }
+	static void count_l2_dnc_delay_mem_ctrl(){ inc(l2_dnc_delay_mem_ctrl, no_hicann); }
+
+	static void count_dnc_ser_channel_start_event(bool downwards){ inc(dnc_ser_channel_start_event, downwards, no_hicann); }
+	static void count_dnc_ser_channel_transmit(bool downwards){ inc(dnc_ser_channel_transmit, downwards, no_hicann); }
+	static void count_dnc_ser_channel_transmit_start_event(bool downwards) { inc(dnc_ser_channel_transmit_start_event, downwards, no_hicann); }
+	static void count_dnc_ser_channel_receive_event(bool downwards) { inc(dnc_ser_channel_receive_event, downwards, no_hicann); }
+	static void count_dnc_ser_channel_fill_fifo(bool downwards){ inc(dnc_ser_channel_fill_fifo, downwards, no_hicann); }
+	static void count_dnc_ser_channel_write_fifo(bool downwards){ inc(dnc_ser_channel_write_fifo, downwards, no_hicann); }
+
+	static void count_dnc_if_rx_l2_ctrl(unsigned int hicann) { inc(dnc_if_rx_l2_ctrl, hicann); }
+	static void count_dnc_if_receive_event(unsigned int hicann) { inc(dnc_if_receive_event, hicann); }
+	static void count_l2tol1_tx_transmit(unsigned int hicann){ inc(l2tol1_tx_transmit, hicann); }
+	static void count_l2tol1_tx_add_buffer(unsigned int hicann){ inc(l2tol1_tx_add_buffer, hicann); }
+	static void count_l2tol1_tx_check_time(unsigned int hicann){ inc(l2tol1_tx_check_time, hicann); }
+	static void count_l2tol1_tx_serialize(unsigned int hicann){ inc(l2tol1_tx_serialize, hicann); }
+
+	static void count_dnc_if_l1_task_if(unsigned int hicann) { inc(dnc_if_l1_task_if, hicann); }
+	static void count_dnc_if_start_pulse_dnc(unsigned int hicann) { inc(dnc_if_start_pulse_dnc, hicann); }
+	static void count_l2_dnc_fifo_from_anc_ctrl() { inc(l2_dnc_fifo_from_anc_ctrl, no_hicann); }
+	static void count_l2_dnc_transmit_from_anc() { inc(l2_dnc_transmit_from_anc, no_hicann); }
+	static void count_l2_fpga_fifo_from_l2_ctrl() { inc(l2_fpga_fifo_from_l2_ctrl, no_hicann); }
+	static void count_l2_fpga_transmit_l2_event() { inc(l2_fpga_transmit_l2_event, no_hicann); }
+	static void count_l2_fpga_record_rx_event() { inc(l2_fpga_record_rx_event, no_hicann); }
+
+	static void count_neuron_fired(unsigned int hicann) { inc(neuron_fired, hicann); }
+	static void count_priority_encoder_rcv_event(unsigned int hicann) { inc(priority_encoder_rcv_event, hicann); }
+	static void count_priority_encoder_send_event(unsigned int hicann) { inc(priority_encoder_send_event, hicann); }
 
 	static void set_loglevel(Logger::levels loglevel) {_loglevel=loglevel;}
 	static void summary();
 	static void print_summary_to_file(std::string file);
 	static void reset();
+	/// stores or restores all counters
+	static void checkpoint(ess::state_archive& ar);
 };
 #endif //_LOST_EVENT_LOGGER_H_
@@ -5,6 +5,8 @@
 #include "merger_pulse_if.h"
 #include "merger_config_if.h"
 
+namespace ess { class state_archive; }
+
 /** the merger base class.
  * the class implementing as single merger of spl1 events.
  * It has 2 inputs and one output.
@@ -71,6 +73,10 @@ class merger : public merger_pulse_if, public merger_config_if{
 
 		bool get_select() const
 		{return _select;}
+
+		/** stores or restores the dynamic state.
+		 * The untimed merger has no state besides its configuration. */
+		virtual void checkpoint(ess::state_archive& /*ar*/) {}
 	protected:
 		merger(); //!< default constructor, shouldnt be used.
 		bool _select; //!< if the input, if _enable=0
@@ -1,5 +1,6 @@
 #include "merger_timed.h"
 #include "sim_def.h"
+#include "state_archive.h"
 #include <log4cxx/logger.h>
 
 static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("ESS.HICANN.Layer1");
@@ -203,3 +204,16 @@ void merger_timed::reset_function_called_flags(){
 	_process_input_called[1] = false;
 	_process_in2out_called = false;
 }
+
+void merger_timed::checkpoint(ess::state_archive& ar)
+{
+	ar.section(name());
+	ar.value(_in_register);
+	ar.value(_out_register);
+	ar.value(_in_occupied);
+	ar.value(_out_occupied);
+	ar.value(_last_in);
+	ar.value(_slow_lock);
+	ar.value(_process_input_called);
+	ar.value(_process_in2out_called);
+}
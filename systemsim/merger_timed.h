@@ -81,6 +81,9 @@ class merger_timed : public sc_module, public merger {
 				bool input
 				);
 
+		/** stores or restores the registers and the flags of the current cycle.*/
+		virtual void checkpoint(ess::state_archive& ar);
+
 	protected:
 		/** processes the path from the input registers to the output register within this merger.
 		 * For the case that the output register is free, it checks if there is a valid event at one of the input registers
@@ -116,7 +119,7 @@ class merger_timed : public sc_module, public merger {
 		 */
 		void process_input(bool input);
 
-		sc_clock _clock; //!< systemc clock
+		sc_light_clock _clock; //!< systemc clock
 
 		merger_pulse_if* _in_source_merger[2]; //!< interface to the sources mergers of the input registers
 		short _in_register[2]; //!< stores the current event (neuron addr) in the input registers
@@ -21,6 +21,7 @@
 #include "l2_fpga.h"
 #include "hicann_behav_V2.h"
 #include "dnc_if.h"
+#include "HALaccess.h"
 #include <log4cxx/logger.h>
 
 static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("ESS");
@@ -39,11 +40,11 @@ pcb::pcb(
 		unsigned int fpga_count_,    //!< nr of FPGAs on this PCB
 		std::vector< std::vector<int> >& map_dncs_on_fpga, //!< 2d-array containing the dnc ids for every FPGA, if none is connected at one FPGA-DNC-Channel, id = -1.
 		std::vector< std::vector< boost::tuples::tuple<bool, unsigned int, int, int > > >& hicann_config, //!< 2d-array of hicanns: available, configId, parent_dnc, dnc_hicann_channel
-		mutexfile& spike_receive_file,  ///<filehandle for received events
-		mutexfile& spike_transm_file,   ///<filehandle for transmitted events
+		async_file& spike_receive_file,  ///<filehandle for received events
+		async_file& spike_transm_file,   ///<filehandle for transmitted events
 		std::string temp_folder,         ///<folder for debug and temporary simulation files
 		HALaccess *hala,
-		const std::vector<ESS::fpga_config>& fpga_config,
+		std::vector<ESS::fpga_config> fpga_config,
 		const std::array<ESS::dnc_config,48>& dnc_config
 		)
 	: wafer_nr(id)                            ///<identification number
@@ -79,24 +80,35 @@ pcb::pcb(
 	for (unsigned int i=0;i<fpga_count;i++)
 	{
 		snprintf(buffer,sizeof(buffer),"l2_fpga_i%i",i);
-		l2_fpga_i[i] = std::shared_ptr<l2_fpga>(new l2_fpga(buffer,i,wafer_nr, fpga_config[i]));
+		l2_fpga_i[i] = std::shared_ptr<l2_fpga>(new l2_fpga(buffer,i,wafer_nr, std::move(fpga_config[i])));
 	}
 	
     LOG4CXX_DEBUG(logger, name() << "::Creating WAFER" );
 
 	std::vector< std::vector<int> > hicann_enable(hicann_y_count, std::vector<int>(hicann_x_count,-1)); // -1 means HICANN is disabled
 	std::vector< std::vector<int> > hicann_on_dnc(hicann_y_count, std::vector<int>(hicann_x_count,-1));
+	// only HICANNs with configuration are instantiated, the others can not take part in the experiment
+	std::vector< std::vector<bool> > hicann_used(hicann_y_count, std::vector<bool>(hicann_x_count,false));
+	std::vector<unsigned int> used_hicann_ids;
 	for(size_t ny=0;ny< hicann_y_count; ++ny)
 	{
 		for(size_t nx=0; nx<hicann_x_count; ++nx)
 		{
 			if (hicann_config.at(ny).at(nx).get<0>()) {
+				if (!hala->isHicannUsed(hicann_config.at(ny).at(nx).get<1>())) {
+					LOG4CXX_INFO(logger, name() << "::HICANN(x=" << nx << ", y=" << ny << ") is not used and not instantiated");
+					continue;
+				}
+				hicann_used.at(ny).at(nx) = true;
+				used_hicann_ids.push_back(hicann_config.at(ny).at(nx).get<1>());
 				hicann_enable.at(ny).at(nx) = hicann_config.at(ny).at(nx).get<1>();
 				hicann_on_dnc.at(ny).at(nx) = hicann_config.at(ny).at(nx).get<3>();
 			}
 		}
 	}
 
+	// the configuration of the HICANNs is translated in parallel, the modules are built sequentially
+	hala->prepareHicanns(used_hicann_ids);
 	wafer_i = std::unique_ptr<wafer>(new wafer( "wafer_i",
                                                 hicann_x_count,
                                                 hicann_y_count,
@@ -106,6 +118,7 @@ pcb::pcb(
                                                 spike_tx_file,
                                                 sim_folder,
                                                 hala));
+	hala->releasePreparedHicanns();
 
 	///////////////////////
 	// Connection
@@ -138,7 +151,7 @@ pcb::pcb(
 	{
 		for(size_t nx=0; nx<hicann_x_count; ++nx)
 		{
-			if (hicann_config.at(ny).at(nx).get<0>()) 
+			if (hicann_used.at(ny).at(nx))
 			{
 				int parent_dnc = hicann_config.at(ny).at(nx).get<2>();
 				int dnc_hicann_channel = hicann_config.at(ny).at(nx).get<3>();
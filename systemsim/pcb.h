@@ -24,7 +24,7 @@
 
 // defines and helpers
 #include "sim_def.h"
-#include "mutexfile.h"
+#include "async_writer.h"
 #include "HAL2ESSContainer.h"
 
 
@@ -64,8 +64,8 @@ public:
 	const unsigned int fpga_count; //!< nr of FPGAs on this PCB
 	const std::vector< std::vector<int> >& map_dncs_on_fpga; //!< 2d-array containing the dnc ids for every FPGA(4 per FPGA), if none is connected at one FPGA-DNC-Channel, id = -1.
 
-    mutexfile &spike_rx_file;    ///<filehandle to record received events on the wafer
-    mutexfile &spike_tx_file;    ///<filehandle to record transmitted events on the wafer
+    async_file &spike_rx_file;    ///<filehandle to record received events on the wafer
+    async_file &spike_tx_file;    ///<filehandle to record transmitted events on the wafer
 	std::string sim_folder;      ///<Folder where all temporary files during simulation and debug goes to. For parallel simulation.
 
     /**
@@ -81,11 +81,11 @@ public:
 		unsigned int fpga_count_,    //!< nr of FPGAs on this PCB
 		std::vector< std::vector<int> >& map_dncs_on_fpga, //!< 2d-array containing the dnc ids for every FPGA, if none is connected at one FPGA-DNC-Channel, id = -1.
 		std::vector< std::vector< boost::tuples::tuple<bool, unsigned int, int, int > > >& hicann_config, //!< 2d-array of hicanns: available, configId, parent_dnc, dnc_hicann_channel
-		mutexfile& spike_receive_file,  ///<filehandle for received events
-		mutexfile& spike_transm_file,   ///<filehandle for transmitted events
+		async_file& spike_receive_file,  ///<filehandle for received events
+		async_file& spike_transm_file,   ///<filehandle for transmitted events
 		std::string temp_folder,        ///<folder for debug and temporary simulation files
 		HALaccess *hala,				///<pointer to HALaccess
-		const std::vector<ESS::fpga_config>& fpga_config,
+		std::vector<ESS::fpga_config> fpga_config, ///<the playback pulses are moved into the FPGAs
 		const std::array<ESS::dnc_config,48>& dnc_config
 	);
 
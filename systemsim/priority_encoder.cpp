@@ -2,14 +2,16 @@
 #include "sim_def.h"
 #include "merger_pulse_if.h"
 #include "lost_event_logger.h"
+#include "state_archive.h"
 #include <log4cxx/logger.h>
 
 static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("ESS.HICANN.Layer1");
 
 priority_encoder::priority_encoder(
-    sc_module_name name, merger_pulse_if* bg_merger, uint8_t PLL_period_ns)
+    sc_module_name name, merger_pulse_if* bg_merger, uint8_t PLL_period_ns, short hicann_id)
     : sc_module(name),
       _clock("clock", PLL_period_ns, SC_NS),
+      _hicann_id(hicann_id),
       _bg_merger(bg_merger),
       _num_inputs_to_process(0),
       _event_buffer(0),
@@ -38,12 +40,12 @@ bool priority_encoder::rcv_event(
 		_num_inputs_to_process++;
 		// in the case of event-based implementation, trigger output generation
 		// otherwise this is done automatically by the clock.
-		LostEventLogger::count_priority_encoder_rcv_event();
+		LostEventLogger::count_priority_encoder_rcv_event(_hicann_id);
 		return true;
 	} else {
 		std::stringstream ss;
 		ss << name() << "::rcv_event(" << input << ") EVENT LOST (channel occupied)";
-		LostEventLogger::log_wafer(ss.str());
+		LostEventLogger::log_wafer(ss.str(), _hicann_id);
         LOG4CXX_WARN(logger, name() << "::priority_encoder::rcv_event(" << input << ") at time " << sc_time_stamp() << " EVENT LOST (channel occupied)" );
 		return false;
 	}
@@ -58,12 +60,12 @@ void priority_encoder::check_for_events()
 		// note that, that an existing event in the input[0] of _bg_merger is overwritten here.
 		if (_bg_merger->write_pulse(
 		        0, _event_buffer)) { // priority_encoder is connected to input 0 of bg-merger
-			LostEventLogger::count_priority_encoder_send_event();
+			LostEventLogger::count_priority_encoder_send_event(_hicann_id);
 		}
 		else {
 			std::stringstream ss;
 			ss << name() << "::check_for_events() overwritten input of register in background merger.";
-			LostEventLogger::log_wafer(ss.str());
+			LostEventLogger::log_wafer(ss.str(), _hicann_id);
 		}
 		_event_buffer_occupied = false;
 	} else {
@@ -87,3 +89,17 @@ void priority_encoder::set_neuron_address(
 			){
 	_addresses.at(input_channel) = neuron_address;
 }
+
+void priority_encoder::checkpoint(ess::state_archive& ar)
+{
+	ar.section(name());
+	ar.check_size(_input_channel.size());
+	for (size_t i = 0; i < _input_channel.size(); ++i) {
+		bool active = _input_channel[i];
+		ar.value(active);
+		_input_channel[i] = active;
+	}
+	ar.value(_num_inputs_to_process);
+	ar.value(_event_buffer);
+	ar.value(_event_buffer_occupied);
+}
@@ -7,6 +7,7 @@
 
 // pre-declarations
 class merger_pulse_if;
+namespace ess { class state_archive; }
 
 /** The Priority Encoder class.
  * implements a 64:6 Priority Encoder
@@ -28,7 +29,8 @@ public:
 	priority_encoder(
 		sc_module_name name, //!< SystemC Module name
 		merger_pulse_if* bg_merger,    //!< the (background) merge, to which this generator is connected to.
-		uint8_t PLL_period_ns
+		uint8_t PLL_period_ns,
+		short hicann_id                //!< ID of the HICANN, used for the LostEventLogger
         );
 
 	/** destructor */
@@ -49,9 +51,11 @@ public:
 			short neuron_address //!< 6-bit neuron address (0..63)
 			);
 
+	/// stores or restores the dynamic state
+	void checkpoint(ess::state_archive& ar);
 
 private:
-	sc_clock _clock; //!< systemc clock
+	sc_light_clock _clock; //!< systemc clock
 
 	/** checks for events (spikes) to be processed.
 	 * If there is at least one spike at the 64-bit input register,
@@ -62,6 +66,7 @@ private:
 
 	std::vector<bool> _input_channel; //!< vector containing flags for all inputs. flag = true, if neuron of input has spiked. (Size 64)
 	std::vector<short> _addresses;  //!< vector containing the programmable 6-bit address (0..63) for each input. (Size 64)
+	short _hicann_id; //!< ID of the HICANN this PE belongs to
 	merger_pulse_if* _bg_merger; //!< interface to the bg_merger, to which this PE is connected
 	unsigned int _num_inputs_to_process;  //!< stores how many input flags are set to true. So that checking of all input is not needed if no signal is active.
 
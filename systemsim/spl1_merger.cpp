@@ -8,6 +8,7 @@
 #include "merger.h"
 #include "dnc_merger.h"
 #include "lost_event_logger.h"
+#include "state_archive.h"
 
 #include <boost/assign/list_of.hpp>
 #include <log4cxx/logger.h>
@@ -68,7 +69,7 @@ spl1_merger::~spl1_merger()
 spl1_merger::spl1_merger(
 			sc_module_name name, //!< instance name
 			short hicann_id,
-			ess::mutexfile& spike_tcx_file,
+			ess::async_file& spike_tcx_file,
 			uint8_t PLL_period_ns,
             bool enable_timed,
             bool enable_spike_debugging
@@ -118,7 +119,7 @@ spl1_merger::spl1_merger(
     {    
         for (unsigned int n_m=0; n_m < ANNCORE_WTA; ++n_m) {
     		snprintf(buffer,sizeof(buffer),"priority_encoder_i%u",n_m);
-    		priority_encoder_i[n_m] = new priority_encoder(buffer, bg_merger_i[ wta_to_bg_merger.at(n_m) ], PLL_period_ns);
+    		priority_encoder_i[n_m] = new priority_encoder(buffer, bg_merger_i[ wta_to_bg_merger.at(n_m) ], PLL_period_ns, hicannid);
     	}
     }
 
@@ -158,6 +159,25 @@ spl1_merger::connect_mergers()
 	bg_merger_i[7]->connect_output_to( dnc_merger_i[7], 0);     // bg 7
 }
 
+void spl1_merger::reset_background()
+{
+	for (size_t n_m = 0; n_m < ANNCORE_WTA; ++n_m)
+		bg_event_generator_i[n_m]->reset();
+}
+
+void spl1_merger::checkpoint(ess::state_archive& ar)
+{
+	ar.section(name());
+	for (size_t n_m = 0; n_m < ANNCORE_WTA; ++n_m) {
+		bg_merger_i[n_m]->checkpoint(ar);
+		level_merger_i[n_m]->checkpoint(ar);
+		dnc_merger_i[n_m]->checkpoint(ar);
+		bg_event_generator_i[n_m]->checkpoint(ar);
+		if (timed)
+			priority_encoder_i[n_m]->checkpoint(ar);
+	}
+}
+
 bg_event_generator const& spl1_merger::get_background(size_t i) const
 { 
     return *(bg_event_generator_i[i]); 
@@ -176,13 +196,10 @@ spl1_merger::handle_spike(
 	   )
 {
     LOG4CXX_TRACE(logger, name() << "::handle_spike(logical_neuron" << ", " << addr << ", " << wta_id << ") called" );
-	LostEventLogger::count_neuron_fired();
+	LostEventLogger::count_neuron_fired(hicannid);
 	if(_spike_debugging)
 	{
-		FILE *fpt2 = spike_tx_file.aquire_fp();
-		fprintf(fpt2,"%.8i %.3i %.3i %.2i\n", (int)sc_simulation_time(), (int) hicannid, (int)logical_neuron, (int) addr);
-		fflush(fpt2);
-		spike_tx_file.release_fp(fpt2);
+		spike_tx_file.printf("%.8i %.3i %.3i %.2i\n", (int)sc_simulation_time(), (int) hicannid, (int)logical_neuron, (int) addr);
 	}
 
 	if(timed)
@@ -8,7 +8,7 @@
 
 // defines and helpers
 #include "sim_def.h"
-#include "mutexfile.h"
+#include "async_writer.h"
 #include "HAL2ESSEnum.h"
 
 #include "anncore_pulse_if.h"
@@ -21,6 +21,7 @@ class bg_event_generator;
 class merger;
 class merger_config_if;
 class priority_encoder;
+namespace ess { class state_archive; }
 
 /** The SPL1 Merger class.
  * Models the SPL1 Merger tree including the WTAs and Background event generators.
@@ -60,7 +61,7 @@ public:
 	spl1_merger(
 			sc_module_name name,            //!< instance name
 			short hicann_id,                //!< ID of Hicann to which this merger belongs to.
-			ess::mutexfile& spike_tcx_file, //!> File to handle recording of transmitted events	
+			ess::async_file& spike_tcx_file, //!> File to handle recording of transmitted events	
 			uint8_t PLL_period_ns,          //!> the PLL period
             bool enable_timed,              //!> Flag for timed merger
             bool enable_spike_debugging    	//!> Flag for spike debugging
@@ -89,6 +90,14 @@ public:
 
 	void print_cfg(std::string fn);
 
+	/** stops all background event generators and resets them to their state after construction.
+	 * They are started again by configuring address row 4 with set_config().*/
+	void reset_background();
+
+	/** stores or restores the dynamic state of the mergers, background event generators
+	 * and priority encoders.*/
+	void checkpoint(ess::state_archive& ar);
+
     bg_event_generator const& get_background(size_t i) const;
 	merger const& get_bg_merger(size_t i) const;
 
@@ -103,7 +112,7 @@ protected:
 	short hicannid;         //!< ID of this HICANN, to which this merger belongs to in the wafer-system, for debugging
 	bool timed;             //!< flag for timed merger
     bool _spike_debugging;  //!< flag for spike_debugging
-    ess::mutexfile& spike_tx_file;	//!< FILE handle for recording of transmitted events
+    ess::async_file& spike_tx_file;	//!< FILE handle for recording of transmitted events
 
 	///** default constructor, should not be called.*/
 	//spl1_merger();
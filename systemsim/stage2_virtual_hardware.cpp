@@ -2,6 +2,7 @@
 #include "common.h"
 #include "boost/filesystem.hpp"
 
+#include <cmath>
 #include <string>
 #include <boost/progress.hpp>
 #include <sstream>
@@ -12,12 +13,47 @@ using namespace boost::tuples;
 #include "IFSC.h"
 #include <log4cxx/logger.h>
 #include "lost_event_logger.h"
+#include "wafer.h"
+#include "l2_fpga.h"
+#include "hicann_behav_V2.h"
+#include "CompoundNeuronModule.h"
+#include "l2_dnc.h"
+#include "state_archive.h"
 
 static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("ESS");
 
+namespace {
+
+uint64_t gcd(uint64_t a, uint64_t b)
+{
+	while (b) {
+		const uint64_t r = a % b;
+		a = b;
+		b = r;
+	}
+	return a;
+}
+
+uint64_t lcm(uint64_t a, uint64_t b)
+{
+	return a / gcd(a, b) * b;
+}
+
+/// runs the processes which are still runnable at the current time,
+/// so that all pending notifications lie in the future.
+void finish_time_step()
+{
+	if (sc_start_of_simulation_invoked())
+		while (sc_pending_activity_at_current_time())
+			sc_start(SC_ZERO_TIME);
+}
+
+} // anonymous namespace
+
 ResetSystemC::~ResetSystemC()
 {
 	sc_get_curr_simcontext()->reset();
+	ess::set_model_time_offset(SC_ZERO_TIME);
 }
 
 Stage2VirtualHardware::Stage2VirtualHardware(
@@ -64,7 +100,7 @@ void Stage2VirtualHardware::initialize_pcb(
 		std::vector< std::vector<int> >& map_dncs_on_fgpa, //!< 2d-array containing the dnc ids for every FPGA, if none is connected at one FPGA-DNC-Channel, id = -1.
 		std::vector< std::vector< boost::tuples::tuple<bool, unsigned int, int, int > > >& hicann_config, //!< 2d-array of hicanns: available, configId, parent_dnc, dnc_hicann_channel
 		HALaccess *hala,
-		const std::vector<ESS::fpga_config> & FPGAConfig,
+		std::vector<ESS::fpga_config> FPGAConfig,
 		const std::array<ESS::dnc_config,48> & DNCConfig
 		)
 {
@@ -101,22 +137,17 @@ void Stage2VirtualHardware::initialize_pcb(
 
 	// TODO: as soon as there are multiple PCBs, make sure that this file handling works!
 	snprintf(buffer,sizeof(buffer),"%s/rx_spikes_%i.txt",sim_folder.c_str(),id);
-	spike_receive_file.open(buffer,"w");
+	if (!spike_receive_file.open(buffer,"w"))
+		LOG4CXX_WARN(logger, name() << " could not open spike file " << buffer );
 	snprintf(buffer,sizeof(buffer),"%s/tx_spikes_%i.txt",sim_folder.c_str(),id);
-	spike_transm_file.open(buffer,"w");
+	if (!spike_transm_file.open(buffer,"w"))
+		LOG4CXX_WARN(logger, name() << " could not open spike file " << buffer );
 
 	// Syntax of spike_files of anncore
-	FILE *fpt = spike_receive_file.aquire_fp();
-	// FIXME This segfaults if directory cannot be opened - should give an explicit error message
-    fprintf(fpt, "// Syntax: \" 8i 3i 3i 2i \",(uint)sc_simulation_time(),anncoreid,(uint)syndr, (unsigned char)addr)\n");
-	fprintf(fpt, "// 1.) Simulation Time(usually in ps) \n// 2.) ID of receiving ANNCORE\n// 3.) ID of receiving Synapse Driver 0..127 (left) 128..255(right)\n// 4.) Pulse event addr(6-bit) 0..63\n");
-	fflush(fpt);
-	spike_receive_file.release_fp(fpt);
-	FILE *fpt2 = spike_transm_file.aquire_fp();
-	fprintf(fpt2, "// Syntax: \" 8i 3i 4i 2i 5i\",(uint)sc_simulation_time(),anncoreid,(uint)logical_neuron, (unsigned char)addr)\n");
-	fprintf(fpt2,"// 1.) Simulation time(usually in ps) \n// 2.) ID of sending ANNCORE\n// 3.) ID of logical Neuron(hardware denmem) 0..511\n// 4.) Pulse event addr(6-bit) 0..63\n // 5.) ID of biological Neuron\n");
-	fflush(fpt2);
-	spike_transm_file.release_fp(fpt2);
+    spike_receive_file.printf("// Syntax: \" 8i 3i 3i 2i \",(uint)sc_simulation_time(),anncoreid,(uint)syndr, (unsigned char)addr)\n");
+	spike_receive_file.printf("// 1.) Simulation Time(usually in ps) \n// 2.) ID of receiving ANNCORE\n// 3.) ID of receiving Synapse Driver 0..127 (left) 128..255(right)\n// 4.) Pulse event addr(6-bit) 0..63\n");
+	spike_transm_file.printf("// Syntax: \" 8i 3i 4i 2i 5i\",(uint)sc_simulation_time(),anncoreid,(uint)logical_neuron, (unsigned char)addr)\n");
+	spike_transm_file.printf("// 1.) Simulation time(usually in ps) \n// 2.) ID of sending ANNCORE\n// 3.) ID of logical Neuron(hardware denmem) 0..511\n// 4.) Pulse event addr(6-bit) 0..63\n // 5.) ID of biological Neuron\n");
 
 	snprintf(buffer,sizeof(buffer),"pcb_i%i",id);
 	pcb_i.at(id).reset(new pcb(
@@ -132,7 +163,7 @@ void Stage2VirtualHardware::initialize_pcb(
 		spike_transm_file,
 		sim_folder,
 		hala,
-		FPGAConfig,
+		std::move(FPGAConfig),
 		DNCConfig
 	));
 }
@@ -171,7 +202,7 @@ Stage2VirtualHardware::set_sim_duration(long duration_in_NS) {
 
 
 void
-Stage2VirtualHardware::run() {
+Stage2VirtualHardware::run(bool stop) {
     //logging the systemc object tree
     std::ostringstream oss;
     print_systemc_object_tree(oss);
@@ -180,9 +211,171 @@ Stage2VirtualHardware::run() {
 	sc_report_handler::set_actions("/IEEE_Std_1666/deprecated", SC_DO_NOTHING);
 	//running the simulation
     sc_start(_duration_in_NS,SC_NS);
-	sc_stop();
+	if (stop)
+		sc_stop();
+	else
+		for_each_hicann([](hicann_behav_V2& h){ h.finish_run(); });
+	// hand over the remaining spike data, and wait for the output files
+	spike_receive_file.flush();
+	spike_transm_file.flush();
+	ess::async_writer::instance().flush();
+	ess::async_writer::instance().report();
+	// storage of the pulses in flight, the number of slabs stays constant once the queues have reached their working size
+	ess::pulse_pool::statistics pools = ess::pulse_pool::statistics();
+	for (auto& p : pcb_i)
+		for (unsigned int d = 0; d < p->dnc_count; ++d)
+			pools += p->get_dnc(d)->get_pulse_pool_statistics();
+	for_each_hicann([&pools](hicann_behav_V2& h){ pools += h.get_pulse_pool_statistics(); });
+	ess::pulse_pool::report(pools);
+}
+
+
+sc_time
+Stage2VirtualHardware::reconfigure(ESS::config_delta const& delta, std::vector<ESS::fpga_config> FPGAConfig)
+{
+	if (sc_end_of_simulation_invoked()) {
+		LOG4CXX_ERROR(logger, name() << "::reconfigure(): the simulation was stopped, use run(false) before a reconfiguration" );
+		throw std::runtime_error("stage2virtualhw: reconfigure() after the simulation was stopped");
+	}
+	if (delta.playback && FPGAConfig.size() != _fpga_count) {
+		LOG4CXX_ERROR(logger, name() << "::reconfigure(): got " << FPGAConfig.size() << " FPGA configs for " << _fpga_count << " FPGAs" );
+		throw std::runtime_error("stage2virtualhw: reconfigure() with wrong number of FPGA configs");
+	}
+
+	// silence all sources of pulses
+	for (auto& p : pcb_i)
+		for (unsigned int f = 0; f < p->fpga_count; ++f)
+			p->get_fpga(f)->stop_playback();
+	for_each_hicann([](hicann_behav_V2& h){ h.quiesce(); });
+
+	// drain for at least one wrap-around period of the L2 timestamps, so that all pulses
+	// in flight are delivered or dropped. The next run starts at a multiple of the alignment period.
+	const double timestamp_period_ns = (1 << TIMESTAMP_WIDTH)*SYSTIME_PERIOD_NS;
+	const double origin_period_ns = alignment_period().to_seconds()*1.e9;
+	const double now_ns = sc_time_stamp().to_seconds()*1.e9;
+	const double origin_ns = std::ceil((now_ns + timestamp_period_ns)/origin_period_ns)*origin_period_ns;
+	sc_start(origin_ns - now_ns, SC_NS);
+	const sc_time origin = sc_time_stamp();
+    LOG4CXX_INFO(logger, name() << ": system drained, next run starts at " << origin );
+
+	for_each_hicann([&delta, &origin](hicann_behav_V2& h){
+		h.reconfigure(delta);
+		h.reset(origin);
+	});
+	// there is only one wafer, so each FPGA config is taken once
+	for (auto& p : pcb_i) {
+		for (unsigned int f = 0; f < p->fpga_count; ++f) {
+			l2_fpga* fpga = p->get_fpga(f);
+			if (delta.playback)
+				fpga->setPlaybackPulses(std::move(FPGAConfig[f].playback_pulses));
+			fpga->reset(origin);
+		}
+	}
+	LostEventLogger::reset();
+	return origin;
 }
 
+void Stage2VirtualHardware::save_checkpoint(std::string const& fn)
+{
+	if (sc_end_of_simulation_invoked()) {
+		LOG4CXX_ERROR(logger, name() << "::save_checkpoint(): the simulation was stopped, use run(false) before a checkpoint" );
+		throw std::runtime_error("stage2virtualhw: save_checkpoint() after the simulation was stopped");
+	}
+	finish_time_step();
+
+	ess::state_archive ar;
+	sc_time now = sc_time_stamp();
+	uint64_t period = alignment_period().value();
+	uint64_t model_offset = ess::model_time_offset().value();
+	ar.time(now);
+	ar.value(period);
+	ar.value(model_offset);
+	checkpoint(ar);
+	ar.save(fn);
+    LOG4CXX_INFO(logger, name() << ": saved checkpoint at " << now << " to " << fn );
+}
+
+sc_time Stage2VirtualHardware::restore_checkpoint(std::string const& fn)
+{
+	if (sc_end_of_simulation_invoked()) {
+		LOG4CXX_ERROR(logger, name() << "::restore_checkpoint(): the simulation was stopped" );
+		throw std::runtime_error("stage2virtualhw: restore_checkpoint() after the simulation was stopped");
+	}
+	ess::state_archive ar(fn);
+	sc_time saved;
+	uint64_t period = 0;
+	uint64_t model_offset = 0;
+	ar.time(saved);
+	ar.value(period);
+	ar.value(model_offset);
+	const sc_time alignment = alignment_period();
+	if (period != alignment.value()) {
+		LOG4CXX_ERROR(logger, name() << "::restore_checkpoint(): alignment period " << sc_time::from_value(period)
+				<< " of the checkpoint differs from " << alignment );
+		throw std::runtime_error("stage2virtualhw: checkpoint of a system with different clocks");
+	}
+
+	// silence all sources of pulses. If the system was already simulated,
+	// the pulses in flight are drained as in reconfigure().
+	for (auto& p : pcb_i)
+		for (unsigned int f = 0; f < p->fpga_count; ++f)
+			p->get_fpga(f)->stop_playback();
+	for_each_hicann([](hicann_behav_V2& h){ h.quiesce(); });
+	sc_time earliest = sc_time_stamp();
+	if (sc_start_of_simulation_invoked())
+		earliest += sc_time((1 << TIMESTAMP_WIDTH)*SYSTIME_PERIOD_NS, SC_NS);
+	if (saved < earliest) {
+		LOG4CXX_ERROR(logger, name() << "::restore_checkpoint(): checkpoint at " << saved << " lies before " << earliest );
+		throw std::runtime_error("stage2virtualhw: checkpoint lies before the current simulation time");
+	}
+
+	// the latest time before the checkpoint, at which all clocks have the same phase as at the checkpoint
+	const sc_time target = saved - sc_time::from_value((saved - earliest).value() / period * period);
+	if (target > sc_time_stamp())
+		sc_start(target - sc_time_stamp());
+	finish_time_step();
+
+	ar.set_shift(saved - target);
+	ess::set_model_time_offset(sc_time::from_value(model_offset) + (saved - target));
+	checkpoint(ar);
+	ar.finish();
+    LOG4CXX_INFO(logger, name() << ": restored checkpoint of " << saved << " from " << fn << " at " << target );
+	return target;
+}
+
+sc_time Stage2VirtualHardware::alignment_period()
+{
+	// wrap-around of the L2 timestamps, which is a multiple of all L2 clocks, and the neuron update
+	uint64_t period_ns = lcm(uint64_t((1 << TIMESTAMP_WIDTH)*SYSTIME_PERIOD_NS), CompoundNeuronModule::tick_period_ns);
+	period_ns = lcm(period_ns, SYS_CLK_PER_L2_FPGA_NS);
+	// PLL clock of the mergers and background generators, and the current stimulus clock
+	for_each_hicann([&period_ns](hicann_behav_V2& h){
+		period_ns = lcm(period_ns, h.get_PLL_period_ns());
+		period_ns = lcm(period_ns, 4*h.get_PLL_period_ns());
+	});
+	return sc_time(double(period_ns), SC_NS);
+}
+
+void Stage2VirtualHardware::checkpoint(ess::state_archive& ar)
+{
+	for (auto& p : pcb_i) {
+		for (unsigned int d = 0; d < p->dnc_count; ++d)
+			p->get_dnc(d)->checkpoint(ar);
+		for (unsigned int f = 0; f < p->fpga_count; ++f)
+			p->get_fpga(f)->checkpoint(ar);
+	}
+	for_each_hicann([&ar](hicann_behav_V2& h){ h.checkpoint(ar); });
+	LostEventLogger::checkpoint(ar);
+}
+
+void Stage2VirtualHardware::for_each_hicann(std::function<void(hicann_behav_V2&)> f)
+{
+	for (auto& p : pcb_i)
+		for (auto& row : p->get_wafer()->hicann_i)
+			for (auto& hicann : row)
+				if (hicann)
+					f(*hicann);
+}
 
 void Stage2VirtualHardware::progress_bar()
 {
@@ -4,17 +4,20 @@
 // always needed
 #include <ctime>
 #include <systemc.h>
+#include <functional>
 #include <iostream>
 #include <memory>
 
 // defines and helpers
-#include "mutexfile.h"
+#include "async_writer.h"
 
 // functional units
 #include "pcb.h"
 
 // forward declaration
 class HALaccess;
+class hicann_behav_V2;
+namespace ess { class state_archive; }
 
 namespace ess
 {
@@ -41,8 +44,8 @@ public:
     // File stuff
 	const unsigned int wafer_count;    //!< number of wafers in the system
 	std::string sim_folder;      ///<Folder where all temporary files during simulation and debug goes to. For parallel simulation.
-    mutexfile spike_receive_file; ///<filehandle to record received events on the wafer
-    mutexfile spike_transm_file;  ///<filehandle to record transmitted events on the wafer
+    async_file spike_receive_file; ///<filehandle to record received events on the wafer
+    async_file spike_transm_file;  ///<filehandle to record transmitted events on the wafer
 
 	int _duration_in_NS;  //!< duration of the systemc simulation in nano-seconds, needed for the progress_bar.
 
@@ -67,7 +70,52 @@ public:
 	 */
 	void set_sim_duration(long duration_in_NS);
 
-	void run();
+	/** runs the simulation for the set duration.
+	 * If stop is false, SystemC is not stopped afterwards, so that the system can be
+	 * changed with reconfigure() and run again. The recordings of the run are completed in both cases.
+	 */
+	void run(bool stop = true);
+
+	/** prepares a further run of the elaborated system without rebuilding it.
+	 * Can only be called after run(false).
+	 * The neurons, background event generators and FPGA playback are silenced, and
+	 * the system is simulated until all pulses in flight are delivered or dropped.
+	 * Then the configuration parts selected in delta are applied again from HALaccess,
+	 * and the dynamic state (neurons, STP, background generators, FPGA traces, lost event counters)
+	 * is reset. The next run starts at the returned origin, to which the FPGA traces
+	 * and voltage recordings are relative. The origin is aligned to the wrap-around of the
+	 * L2 timestamps, so the timestamps of the playback pulses stay valid.
+	 * The structure of the system (neurons, routing, DNC/FPGA setup) can not be changed.
+	 * HICANNs loaded from a configuration snapshot are translated again with their calibration data.
+	 */
+	sc_time reconfigure(
+		ESS::config_delta const& delta,                //!< parts of the configuration to apply again
+		std::vector<ESS::fpga_config> FPGAConfig //!< playback pulses for the next run, used if delta.playback. Pass an rvalue to avoid copying the pulses.
+		);
+
+	/** writes the dynamic state of the whole system to the checkpoint file fn.
+	 * Can be called after run(false). The current time step is completed first,
+	 * so the state is taken between two time steps.
+	 * The checkpoint contains no configuration, it can only be restored into a system
+	 * built with the same configuration, e.g. from a configuration snapshot.
+	 */
+	void save_checkpoint(std::string const& fn);
+
+	/** restores the dynamic state from the checkpoint file fn, written by save_checkpoint().
+	 * The system has to be built with the configuration in effect when the checkpoint was
+	 * taken. It is restored at the returned time, which is the checkpoint time moved back
+	 * by a multiple of the period of all clocks and of the L2 timestamps. Hence, a newly
+	 * built system continues without simulating the time before the checkpoint, and all
+	 * times (pending events, FPGA traces, voltage recordings) are moved by the same amount.
+	 * The neuron and STP models continue with the model times of the uninterrupted simulation
+	 * (see ess::model_seconds()), so the restored run computes the same values. The spike debug
+	 * files contain the times of the restored simulation. The voltage recordings are continued in new files.
+	 * If the system was already simulated, the pulse sources are silenced and the pulses in
+	 * flight are drained first, as in reconfigure().
+	 * Throws std::runtime_error if the checkpoint does not match the system or lies before
+	 * the end of the drain.
+	 */
+	sc_time restore_checkpoint(std::string const& fn);
 
 	/** provides a progress bar for the execution of the systemc simulation.*/
 	void progress_bar();
@@ -84,7 +132,7 @@ public:
 		std::vector< std::vector<int> >& map_dncs_on_fgpa, //!< 2d-array containing the dnc ids for every FPGA, if none is connected at one FPGA-DNC-Channel, id = -1.
 		std::vector< std::vector< boost::tuples::tuple<bool, unsigned int, int, int > > >& hicann_config, //!< 2d-array of hicanns: available, configId, parent_dnc, dnc_hicann_channel
 		HALaccess *hala,
-		const std::vector<ESS::fpga_config> & FPGAConfig,
+		std::vector<ESS::fpga_config> FPGAConfig, //!< the playback pulses are moved into the FPGAs, pass an rvalue to avoid copying them
 		const std::array<ESS::dnc_config,48> & DNCConfig
 		);
 
@@ -94,6 +142,16 @@ public:
 private:
 	/** when all pcbs are built, this connects the fpgas before the end_of_elaboration phase.*/
 	void connect_fpgas_from_different_pcbs();
+
+	/** calls f for all instantiated HICANNs of all pcbs.*/
+	void for_each_hicann(std::function<void(hicann_behav_V2&)> f);
+
+	/** period to which the start of a run and the restore time of a checkpoint are aligned:
+	 * the least common multiple of the periods of all clocks and of the wrap-around of the L2 timestamps.*/
+	sc_time alignment_period();
+
+	/** stores or restores the dynamic state of all DNCs, FPGAs, HICANNs and the LostEventLogger.*/
+	void checkpoint(ess::state_archive& ar);
 	
 private:
 	bool res_set;	                           	 			//has sc_time_resolution been set?
@@ -2,9 +2,10 @@
 
 #include "sim_def.h"
 #include "hw_neuron.h"
+#include "state_archive.h"
 
 #include "calibtic/HMF/STPUtilizationCalibration.h"
-#include "paramtrafo_types.h"
+#include <algorithm>
 #include <log4cxx/logger.h>
 
 static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("ESS.HICANN.Layer1");
@@ -47,12 +48,8 @@ syndriver::syndriver(
 	_sel_Vgmax[0]=0;
 	_sel_Vgmax[1]=0;
 
-	_analog_weight[0] = std::vector<double>();
-	_analog_weight[1] = std::vector<double>();
 	std::vector<double> default_trafo(2,0.);
 	default_trafo[1] = 50.e-9/16.;
-	_synapse_trafo[0]=std::vector<double>();
-	_synapse_trafo[1]=std::vector<double>();
 	set_synapse_trafo(0,default_trafo);
 	set_synapse_trafo(1,default_trafo);
 
@@ -93,6 +90,21 @@ syndriver::set_STP(
 }
 
 
+void
+syndriver::reset_STP()
+{
+	std::fill(_STP_CAP.begin(), _STP_CAP.end(), 0.0);
+	std::fill(_STP_TIME.begin(), _STP_TIME.end(), 0.0);
+}
+
+void
+syndriver::checkpoint(ess::state_archive& ar)
+{
+	ar.sequence(_STP_CAP);
+	ar.sequence(_STP_TIME, [&ar](double& t){ ar.seconds(t); });
+}
+
+
 int
 syndriver::pulse(int addr)
 {
@@ -105,7 +117,7 @@ syndriver::pulse(int addr)
 	////////////////////////////////////
 	if(_stp_enable==true)
 	{
-		double current_time = sc_time_stamp().to_seconds();
+		double current_time = ess::model_seconds();
 		// get the current inactive partition, i.e. compute the exponential recovering
 		double current_inactive_partition = exp(-(current_time - _STP_TIME[addr])/_tau_rec)*_STP_CAP[addr];
 		// STP move utilized fraction to I
@@ -131,7 +143,7 @@ syndriver::pulse(int addr)
 	const char adr_4LSB = addr%16;
 	for(size_t row = 0; row < 2; ++row){
 		char syn_type_row = _syn_type[row];
-		const std::vector<double>& analog_weight = _analog_weight[row];
+		const SynapseTrafo& trafo = *_synapse_trafo[row];
 		size_t row_offset = row*SYN_PER_ROW; // 0 or 256
 		for(size_t strobeline = 0; strobeline < 2; ++strobeline){
 			// check if this strobeline is programmed for this pattern
@@ -146,7 +158,7 @@ syndriver::pulse(int addr)
                     //LOG4CXX_TRACE(logger, "syndriver with id: " << _id << " on hicann " << _hicann_id << " synapse " << i 
                     //        << " weight " << (int )digital_w << " syn_decoder " << (int) _addresses[i] << " neuron " << (*h));
                     if(_addresses[i]==adr_4LSB && digital_w < 16 && (*h != NULL)){
-							double effective_weight = analog_weight[digital_w] * stp_factor * _weight_distortions[i];
+							double effective_weight = trafo.analog_weight(digital_w) * stp_factor * _weight_distortions[i];
                             LOG4CXX_TRACE(logger, "syndriver with id: " << _id << " on hicann " << _hicann_id << " pulse: addr:" << addr
 								  << " sent pulse to synapse " << i << " with digital weight:" << (int)_weights[i] 
 								  << " analog_weight " << effective_weight << " address:" << (int)_addresses[i] 
@@ -162,15 +174,12 @@ syndriver::pulse(int addr)
 }
 
 void syndriver::set_synapse_trafo(bool row, const std::vector<double>& trafo){
-	_analog_weight[row].clear();
-	for(size_t dw = 0; dw<16; ++dw)
-		_analog_weight[row].push_back(trafo_polynomial<double,double>( static_cast<double>(dw), trafo));
-	_synapse_trafo[row]=trafo;
+	_synapse_trafo[row]=SynapseTrafo::get(trafo);
 }
 
 const std::vector<double>& syndriver::get_synapse_trafo(bool row) const
 {
-    return _synapse_trafo[row];
+    return _synapse_trafo[row]->coefficients();
 } 
 
 void syndriver::set_mirror(bool mirror)
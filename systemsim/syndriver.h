@@ -11,9 +11,11 @@
 #include "systemc.h"
 
 #include "DenmemIF.h"
+#include "SynapseTrafo.h"
 
 //	pre-declarations
 class hw_neuron;
+namespace ess { class state_archive; }
 
 /** The syndriver class has a pointer to the array of its 2 synapse
     rows. When the syndriver is fired by calling <tt>pulse(addr)</tt>,
@@ -91,19 +93,12 @@ class syndriver
 	 */
 	uint8_t _sel_Vgmax[2];
 
-	/** the analog weight for each digital weight in each row.
+	/** the polynomial synapse trafo from digital to analog weight and the
+	 *  analog weight for each digital weight, shared with all rows using the same trafo.
 	 *	index 0 corresponds to the bottom row of the syndriver, i.e. to an even synapse row.
 	 *	index 1 corresponds to the top row of the syndriver, i.e. to an odd synapse row.
-	 * size: 16
 	 */
-	std::vector<double> _analog_weight[2];
-
-	/** the polynomial synapse trafo from digital to analog weight
-	 *	index 0 corresponds to the bottom row of the syndriver, i.e. to an even synapse row.
-	 *	index 1 corresponds to the top row of the syndriver, i.e. to an odd synapse row.
-	 * size: usually 3
-	 */
-	std::vector<double> _synapse_trafo[2];
+	std::shared_ptr<SynapseTrafo const> _synapse_trafo[2];
 	/////////////////////////////
 	///// Short Term Plasticity
 	/////////////////////////////
@@ -158,6 +153,12 @@ class syndriver
      */
     int pulse(int addr);
 
+	/** resets the Short Term Plasticity state: all capacitors are emptied.*/
+	void reset_STP();
+
+	/** stores or restores the Short Term Plasticity state.*/
+	void checkpoint(ess::state_archive& ar);
+
 	/** Function to to set Short Term Plasticity Mechanism of this syndriver.
 	 * also initialize variables for functional STP*/
 	void set_STP(
@@ -31,8 +31,8 @@ wafer::wafer(
 		unsigned int hicann_y,      //!< nr of hicanns in y-direction
 		std::vector< std::vector<int> >& enabled_hicanns, //!< 2d-array containing information whether hicann are enabled or not.
 		std::vector< std::vector<int> >& hicann_on_dnc,
-		mutexfile& spike_rcx_file,   ///<filehandle for received events
-		mutexfile& spike_tcx_file,   ///<filehandle for transmitted events
+		async_file& spike_rcx_file,   ///<filehandle for received events
+		async_file& spike_tcx_file,   ///<filehandle for transmitted events
 		std::string temp_folder,      ///<folder for debug and temporary simulation files
 		HALaccess *hala
 	)
@@ -22,7 +22,7 @@
 
 // defines and helpers
 #include "sim_def.h"
-#include "mutexfile.h"
+#include "async_writer.h"
 
 // forward declarations
 class hicann_behav_V2;
@@ -41,8 +41,8 @@ class wafer :
 	const unsigned int hicann_y_count; //!< nr of hicanns in y-direction
 	std::vector< std::vector< std::unique_ptr<hicann_behav_V2> > > hicann_i;
 	const std::vector< std::vector<int> > hicann_enable; //!< 2d-array containing information containg the configId of Hicann. -1 if hicann is disabled
-	mutexfile& spike_rx_file; ///< filehandle for received events
-	mutexfile& spike_tx_file; ///< filehandle for transmitted events
+	async_file& spike_rx_file; ///< filehandle for received events
+	async_file& spike_tx_file; ///< filehandle for transmitted events
 	std::string sim_folder;   ///< folder for debug and temporary simulation files
 	HALaccess *mHala;
 
@@ -53,8 +53,8 @@ class wafer :
 		unsigned int hicann_y,      //!< nr of hicanns in y-direction
 		std::vector< std::vector<int> >& enabled_hicanns, //!< 2d-array containing information containg the configId of Hicann. -1 if hicann is disabled
 		std::vector< std::vector<int> >& hicann_on_dnc, 
-		mutexfile& spike_rcx_file,  ///<filehandle for received events
-		mutexfile& spike_tcx_file,  ///<filehandle for transmitted events
+		async_file& spike_rcx_file,  ///<filehandle for received events
+		async_file& spike_tcx_file,  ///<filehandle for transmitted events
 		std::string temp_folder,    ///<folder for debug and temporary simulation files
 		HALaccess *hala 			///<pointer to HALaccess	
 	);
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "hal/Coordinate/HMFGeometry.h"
+#include "hal/Coordinate/iter_all.h"
+#include "systemsim/HALaccess.h"
+
+/// two runs of an ADC reading out one neuron, the ADC is primed again in between.
+/// The samples, which the neuron writes into the buffer during a run, are inserted directly.
+TEST(HALaccess, ADCTraceIsResetWhenPrimedAgain)
+{
+	using namespace HMF::Coordinate;
+	HALaccess hal(0, ".");
+
+	const unsigned int reticle = 0;
+	const unsigned int adc = 2*reticle;
+	const HICANNOnWafer hicann = HICANNOnDNC{Enum{0}}.toHICANNOnWafer(DNCOnWafer{Enum{reticle}});
+	ESS::hicann& h = hal.wafer().hicanns.at(hicann.id().value());
+	h.available = true;
+	// bottom odd neuron of the first quad, input 0 of the ADC
+	const NeuronOnHICANN neuron{*iter_all<QuadOnHICANN>().begin(), NeuronOnQuad(X(right), Y(bottom))};
+	const unsigned int denmem = neuron.id().value();
+	h.neurons_on_hicann.at(denmem).enable_output = true;
+	hal.wafer().adcs.at(adc).input[0] = true;
+
+	hal.configADC(adc, 4);
+	hal.primeADC(adc);
+	ESS::adc_trace* trace = hal.getADCTraceBuffer(h.mX, h.mY, denmem);
+	ASSERT_TRUE(trace != nullptr);
+	for (uint16_t v = 1; v <= 6; ++v)
+		trace->insert(v);
+	EXPECT_EQ(std::vector<uint16_t>({1, 2, 3, 4}), hal.getADCTrace(adc));
+
+	// the buffer attached to the neuron stays valid, the samples of the first run are dropped
+	hal.configADC(adc, 2);
+	hal.primeADC(adc);
+	EXPECT_EQ(trace, hal.getADCTraceBuffer(h.mX, h.mY, denmem));
+	EXPECT_TRUE(trace->empty());
+	EXPECT_EQ(2u, trace->capacity());
+	for (uint16_t v = 7; v <= 9; ++v)
+		trace->insert(v);
+	EXPECT_EQ(std::vector<uint16_t>({7, 8}), hal.getADCTrace(adc));
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include "systemsim/ConfigSnapshot.h"
+
+TEST(ConfigSnapshot, RoundTrip)
+{
+	const std::string fn = "test_config_snapshot.bin";
+
+	ESS::wafer waf;
+	ESS::global_parameter params;
+	ESS::translated_wafer translated;
+
+	const unsigned int hic_id = 42;
+	ESS::hicann& h = waf.hicanns[hic_id];
+	h.available = true;
+	h.mX = 7;
+	h.mY = 3;
+	h.syn_array[5][17] = ESS::Synapse_t(12, 9);
+	h.denmem2nrn[4] = 1;
+	params.speedup = 1.e4;
+	params.voltage_trace.decimation = 3;
+
+	ESS::translated_hicann& t = translated[hic_id];
+	t.num_neurons = 2;
+	t.syndriver_params[ESS::translated_hicann::syndriver_index(ESS::BL_DOWN, ESS::S_RIGHT, 55)].tau_rec = 1.5e-3;
+	t.denmem_params[4].v_thresh = -55.;
+
+	ESS::config_snapshot::save(fn, waf, params, translated);
+
+	ESS::wafer waf2;
+	ESS::global_parameter params2;
+	ESS::translated_wafer translated2;
+	ESS::config_snapshot::load(fn, waf2, params2, translated2);
+	std::remove(fn.c_str());
+
+	ESS::hicann const& h2 = waf2.hicanns[hic_id];
+	EXPECT_TRUE(h2.available);
+	EXPECT_EQ(7u, h2.mX);
+	EXPECT_EQ(3u, h2.mY);
+	EXPECT_EQ(12, h2.syn_array[5][17].address);
+	EXPECT_EQ(9, h2.syn_array[5][17].weight);
+	EXPECT_EQ(1u, h2.denmem2nrn.at(4));
+	EXPECT_DOUBLE_EQ(1.e4, params2.speedup);
+	EXPECT_EQ(3u, params2.voltage_trace.decimation);
+
+	ASSERT_EQ(1u, translated2.count(hic_id));
+	ESS::translated_hicann const& t2 = translated2.at(hic_id);
+	EXPECT_EQ(2u, t2.num_neurons);
+	EXPECT_DOUBLE_EQ(1.5e-3, t2.syndriver_params.back().tau_rec);
+	EXPECT_DOUBLE_EQ(-55., t2.denmem_params.at(4).v_thresh);
+}
+
+TEST(ConfigSnapshot, RejectsOtherFiles)
+{
+	const std::string fn = "test_config_snapshot.txt";
+	FILE* f = fopen(fn.c_str(), "w");
+	fputs("no snapshot", f);
+	fclose(f);
+
+	ESS::wafer waf;
+	ESS::global_parameter params;
+	ESS::translated_wafer translated;
+	EXPECT_THROW(ESS::config_snapshot::load(fn, waf, params, translated), std::runtime_error);
+	std::remove(fn.c_str());
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <stdexcept>
+
+#include "systemsim/HALaccess.h"
+
+namespace {
+
+void fire(ESS::neuron& denmem, unsigned int l1_address)
+{
+	denmem.activate_firing = true;
+	denmem.enable_spl1_output = true;
+	denmem.l1_address = l1_address;
+}
+
+} // anonymous namespace
+
+/// fixed switch configurations and the resulting numbering of the logical neurons
+TEST(HALaccess, Denmem2Neuron)
+{
+	HALaccess hal(0, ".");
+	ESS::hicann& h = hal.wafer().hicanns.at(0);
+	h.available = true;
+	auto& switches = h.connection_config;
+	auto& denmems = h.neurons_on_hicann;
+
+	// quad 0: upper horizontal and left vertical switch, fires right of the leftmost column
+	switches[0].hori[0] = true;
+	switches[0].vert[0] = true;
+	fire(denmems[1], 10);
+	// fire input between quad 0 and 1 (odd denmem connects to the right)
+	denmems[3].enable_fire_input = true;
+	fire(denmems[4], 11);
+	// fire input on an even denmem connects to the left
+	denmems[6].enable_fire_input = true;
+	fire(denmems[5], 12);
+	// single denmem
+	fire(denmems[100], 13);
+	// the vertical switch of the last column, fires in the lower row only
+	switches[127].vert[1] = true;
+	fire(denmems[511], 14);
+
+	EXPECT_EQ(5u, hal.getNeuronsOnHicann(h.mX, h.mY));
+
+	const std::map<unsigned, unsigned> expected = {
+		{0, 0}, {1, 0}, {256, 0},
+		{3, 1}, {4, 1},
+		{5, 2}, {6, 2},
+		{100, 3},
+		{255, 4}, {511, 4}};
+	EXPECT_EQ(expected, hal.getDendrites(h.mX, h.mY));
+
+	const std::map<unsigned int, unsigned int> firing = {
+		{1, 10}, {4, 11}, {5, 12}, {100, 13}, {511, 14}};
+	EXPECT_EQ(firing, hal.getFiringDenmemsAndSPL1Addresses(h.mX, h.mY));
+
+	EXPECT_TRUE(denmems[256].is_connected);
+	EXPECT_TRUE(denmems[255].is_connected);
+	EXPECT_FALSE(denmems[100].is_connected);
+}
+
+TEST(HALaccess, Denmem2NeuronRejectsTwoFiringDenmems)
+{
+	HALaccess hal(0, ".");
+	ESS::hicann& h = hal.wafer().hicanns.at(0);
+	h.available = true;
+	// the vertical switch connects the firing denmems 2 and 258
+	h.connection_config[1].vert[0] = true;
+	fire(h.neurons_on_hicann[2], 1);
+	fire(h.neurons_on_hicann[258], 2);
+
+	EXPECT_THROW(hal.getNeuronsOnHicann(h.mX, h.mY), std::runtime_error);
+}
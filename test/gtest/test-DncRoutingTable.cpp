@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "systemsim/DncRoutingTable.h"
+
+// reference: the decoding of l2_dnc with a separate routing memory and direction bits
+struct reference_routing
+{
+	std::vector<unsigned int> delays = std::vector<unsigned int>(DNC_TO_ANC_COUNT*512, 0);
+	uint64_t directions = 0;
+
+	bool from_hicann(unsigned int channel, uint32_t rx_event, uint32_t& event) const
+	{
+		unsigned int rx_address = (rx_event >> TIMESTAMP_WIDTH) & 0x1ff;
+		unsigned int time = rx_event & 0x7fff;
+		unsigned int sub_address = delays[channel*512 + rx_address] & 0xffff;
+		event = (((channel << 9) + rx_address) << TIMESTAMP_WIDTH) + ((time + (sub_address & 0x7fff)) & 0x7fff);
+		return ((directions >> ((channel*8) + (rx_address >> L1_ADDR_WIDTH))) & 0x1) == 0;
+	}
+
+	bool from_fpga(uint32_t rx_event, unsigned int& channel, uint32_t& event) const
+	{
+		unsigned int rx_address = (rx_event >> TIMESTAMP_WIDTH) & 0x1ff;
+		unsigned int time = rx_event & 0x7fff;
+		channel = (rx_event >> (TIMESTAMP_WIDTH+9)) & 0x7;
+		event = (rx_address << TIMESTAMP_WIDTH) + time;
+		return (directions >> ((channel*8) + (rx_address >> 6))) & 0x1;
+	}
+};
+
+TEST(DncRoutingTable, MatchesReferenceForRandomEvents)
+{
+	std::mt19937 rng(42);
+	DncRoutingTable table;
+	reference_routing reference;
+
+	for (size_t i = 0; i < 2000; ++i) {
+		unsigned int channel = rng() % DNC_TO_ANC_COUNT;
+		unsigned int address = rng() % 512;
+		uint32_t delay = rng();
+		table.set_delay(channel, address, delay);
+		reference.delays[channel*512 + address] = delay;
+	}
+	const uint64_t directions = (uint64_t(rng()) << 32) | rng();
+	table.set_directions(directions);
+	reference.directions = directions;
+	EXPECT_EQ(directions, table.directions());
+
+	for (size_t i = 0; i < 100000; ++i) {
+		const uint32_t rx_event = rng();
+		const unsigned int rx_channel = rng() % DNC_TO_ANC_COUNT;
+
+		uint32_t expected_event;
+		ess::l2_event event;
+		ASSERT_EQ(reference.from_hicann(rx_channel, rx_event, expected_event),
+				table.from_hicann(rx_channel, ess::l2_event::from(rx_event), event));
+		ASSERT_EQ(expected_event, event.value);
+
+		unsigned int channel, expected_channel;
+		ASSERT_EQ(reference.from_fpga(rx_event, expected_channel, expected_event),
+				table.from_fpga(ess::l2_event::from(rx_event), channel, event));
+		ASSERT_EQ(expected_channel, channel);
+		ASSERT_EQ(expected_event, event.value);
+	}
+}
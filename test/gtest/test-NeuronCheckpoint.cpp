@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "systemc_test.h"
+#include "state_archive.h"
+#include "systemsim/CompoundNeuronModule.h"
+#include "systemsim/SpikeReleaseScheduler.h"
+
+namespace {
+
+/// a regularly firing neuron, whose released spikes are logged
+class neuron_bench : public sc_module, public anncore_pulse_if
+{
+public:
+	sc_port<anncore_pulse_if> out;
+	SpikeReleaseScheduler release;
+	CompoundNeuronModule neuron;
+	std::vector<sc_time> spikes;
+
+	neuron_bench(sc_module_name name, double current)
+		: sc_module(name)
+		, release("release", &out)
+		, neuron("neuron", 1, 0, 0, &release)
+	{
+		out(*this);
+		release.reserve(16);
+		// time constants in the range of the hardware, so that the neuron fires every few us
+		DenmemParams p;
+		p.cm = 2.e-13;
+		p.tau_refrac = 1.e-7;
+		p.tau_syn = {{5.e-7, 5.e-7}};
+		p.tau_w = 1.44e-5;
+		neuron.mCompoundNeuron.setDenmemParams(0, p);
+		neuron.init(0, false, "", 1.e-5);
+		neuron.mCompoundNeuron.inputCurrent(0, current);
+	}
+
+	void handle_spike(const sc_uint<LD_NRN_MAX>&, const short&, int) override
+	{
+		spikes.push_back(sc_time_stamp());
+	}
+
+	void checkpoint(ess::state_archive& ar)
+	{
+		release.checkpoint(ar);
+		neuron.checkpoint(ar);
+	}
+};
+
+/// completes the current time step, as Stage2VirtualHardware does for a checkpoint
+void finish_time_step()
+{
+	while (sc_pending_activity_at_current_time())
+		sc_start(SC_ZERO_TIME);
+}
+
+} // anonymous namespace
+
+class NeuronCheckpoint : public SystemCTest {};
+
+/// a checkpoint restored earlier by a shift continues exactly as the uninterrupted run
+TEST_F(NeuronCheckpoint, ShiftedRestoreIsExact)
+{
+	const std::string fn = "test_neuron_checkpoint.bin";
+	const sc_time checkpoint_time(20, SC_US);
+	const sc_time shift(15, SC_US); // multiple of the neuron tick and the release delay
+	const sc_time run(20, SC_US);
+
+	std::vector<sc_time> expected_spikes;
+	CompoundNeuronState expected_state(1);
+	{
+		neuron_bench uninterrupted("bench", 2.e-9);
+		sc_start(checkpoint_time);
+		finish_time_step();
+		ess::state_archive ar;
+		uninterrupted.checkpoint(ar);
+		ar.save(fn);
+		const size_t before = uninterrupted.spikes.size();
+		ASSERT_GT(before, 0u);
+
+		sc_start(run);
+		for (size_t i = before; i < uninterrupted.spikes.size(); ++i)
+			expected_spikes.push_back(uninterrupted.spikes[i] - shift);
+		expected_state = uninterrupted.neuron.mCompoundNeuron.mState;
+	}
+	ASSERT_GT(expected_spikes.size(), 2u);
+
+	sc_get_curr_simcontext()->reset();
+	{
+		neuron_bench restored("bench", 0.);
+		sc_start(checkpoint_time - shift);
+		finish_time_step();
+		ess::state_archive ar(fn);
+		ar.set_shift(shift);
+		ess::set_model_time_offset(shift);
+		restored.checkpoint(ar);
+		ar.finish();
+
+		sc_start(run);
+		EXPECT_EQ(expected_spikes, restored.spikes);
+		CompoundNeuronState const& state = restored.neuron.mCompoundNeuron.mState;
+		// bit-identical, not only close
+		EXPECT_EQ(expected_state.V, state.V);
+		EXPECT_EQ(expected_state.t_end_of_refractory_period, state.t_end_of_refractory_period);
+		EXPECT_EQ(expected_state.denmems[0].w, state.denmems[0].w);
+		EXPECT_EQ(expected_state.denmems[0].g_syn[0], state.denmems[0].g_syn[0]);
+		EXPECT_EQ(expected_state.denmems[0].I_ext, state.denmems[0].I_ext);
+	}
+	ess::set_model_time_offset(SC_ZERO_TIME);
+	std::remove(fn.c_str());
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+#include "calibtic/HMF/HICANNCollection.h"
+#include "calibtic/backend/Backend.h"
+#include "calibtic/backend/Library.h"
+#include "systemsim/HALaccess.h"
+
+namespace {
+
+/// writes a calibration file for the HICANN, which differs from the ESS default calibration
+void store_calib(std::string const& path, unsigned int hic_id)
+{
+	using namespace calibtic::backend;
+	auto lib = loadLibrary("libcalibtic_xml.so");
+	auto backend = loadBackend(lib);
+	ASSERT_TRUE(static_cast<bool>(backend));
+	backend->config("path", path);
+	backend->init();
+
+	// the synapse rows use the calibtic defaults instead of the ESS defaults
+	HMF::HICANNCollection calib;
+	calib.setDefaults();
+	calibtic::MetaData md;
+	backend->store("w0-h" + std::to_string(hic_id), md, calib);
+}
+
+/// one neuron and one synapse row, which use the calibration
+void configure(ESS::hicann& h)
+{
+	h.available = true;
+	ESS::neuron& denmem = h.neurons_on_hicann[0];
+	denmem.activate_firing = true;
+	denmem.enable_spl1_output = true;
+	denmem.l1_address = 7;
+	ESS::syndriver_cfg& driver = h.syndriver_config[0].syndriver.at(0);
+	driver.enable = true;
+	driver.top_row_cfg.senx = true;
+	driver.top_row_cfg.gmax_div_x = 4;
+}
+
+} // anonymous namespace
+
+/// HICANNs loaded from a snapshot are built from the stored translation.
+/// A later reconfiguration translates them again, which has to use their calibration
+/// as for HICANNs configured directly.
+TEST(HALaccess, SnapshotHicannsAreReconfiguredWithTheirCalibration)
+{
+	namespace fs = boost::filesystem;
+	const fs::path dir = fs::temp_directory_path() / fs::unique_path("ess-snapshot-%%%%-%%%%");
+	fs::create_directory(dir);
+	const std::string snapshot = (dir / "snapshot.bin").string();
+	const unsigned int hic_id = 0;
+	store_calib(dir.string(), hic_id);
+
+	HALaccess direct(0, ".");
+	ESS::hicann& h = direct.wafer().hicanns.at(hic_id);
+	configure(h);
+	direct.setCalibPath(dir.string());
+	direct.initCalib();
+	direct.saveConfigSnapshot(snapshot);
+	// as after building the HICANNs
+	direct.releasePreparedHicanns();
+
+	HALaccess restored(0, ".");
+	restored.loadConfigSnapshot(snapshot);
+	restored.setCalibPath(dir.string());
+	restored.initCalib();
+	restored.releasePreparedHicanns();
+	fs::remove_all(dir);
+
+	// the parts of the configuration a reconfiguration with neuron and synapse deltas translates
+	const ESS::BioParameter expected_neuron = direct.getNeuronParametersSingleDenmem(h.mX, h.mY, 0);
+	const ESS::BioParameter neuron = restored.getNeuronParametersSingleDenmem(h.mX, h.mY, 0);
+	EXPECT_DOUBLE_EQ(expected_neuron.cm, neuron.cm);
+	EXPECT_DOUBLE_EQ(expected_neuron.tau_m, neuron.tau_m);
+	EXPECT_DOUBLE_EQ(expected_neuron.v_rest, neuron.v_rest);
+	EXPECT_DOUBLE_EQ(expected_neuron.v_thresh, neuron.v_thresh);
+	EXPECT_DOUBLE_EQ(expected_neuron.v_reset, neuron.v_reset);
+
+	const ESS::SyndriverParameterESS expected_driver =
+		direct.getSyndriverParameters(h.mX, h.mY, ESS::HICANNBlock::BL_UP, ESS::HICANNSide::S_LEFT, 0);
+	const ESS::SyndriverParameterESS driver =
+		restored.getSyndriverParameters(h.mX, h.mY, ESS::HICANNBlock::BL_UP, ESS::HICANNSide::S_LEFT, 0);
+	ASSERT_FALSE(expected_driver.g_trafo_up.empty());
+	EXPECT_EQ(expected_driver.g_trafo_up, driver.g_trafo_up);
+	EXPECT_DOUBLE_EQ(expected_driver.tau_rec, driver.tau_rec);
+}
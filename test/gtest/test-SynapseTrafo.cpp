@@ -0,0 +1,27 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "systemsim/SynapseTrafo.h"
+
+TEST(SynapseTrafo, SharedByEqualCoefficients)
+{
+	const std::vector<double> coefficients = {1.e-9, 2.e-9, 0.5e-9};
+	const size_t interned = SynapseTrafo::num_interned();
+
+	auto a = SynapseTrafo::get(coefficients);
+	auto b = SynapseTrafo::get(coefficients);
+	auto c = SynapseTrafo::get({1.e-9, 2.e-9});
+	EXPECT_EQ(a.get(), b.get());
+	EXPECT_NE(a.get(), c.get());
+	EXPECT_EQ(interned + 2, SynapseTrafo::num_interned());
+
+	EXPECT_EQ(coefficients, a->coefficients());
+	EXPECT_DOUBLE_EQ(1.e-9, a->analog_weight(0));
+	EXPECT_DOUBLE_EQ(1.e-9 + 2.e-9*15 + 0.5e-9*15*15, a->analog_weight(15));
+
+	a.reset();
+	b.reset();
+	c.reset();
+	EXPECT_EQ(interned, SynapseTrafo::num_interned());
+}
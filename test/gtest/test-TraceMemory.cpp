@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+#include "systemsim/TraceMemory.h"
+
+static ESS::trace_entry make_entry(uint64_t i)
+{
+	ESS::trace_entry entry;
+	entry.fpga_time = (uint64_t(1) << 40) + i;
+	entry.event.setLabel(i % (1 << 14));
+	entry.event.setTime(i % (1 << 15));
+	return entry;
+}
+
+TEST(TraceMemory, SpillsAndDrainsInOrder)
+{
+	const std::string fn = "test_trace_memory.bin";
+	const size_t num = 5*TraceMemory::chunk_entries + 17;
+
+	TraceMemory trace;
+	trace.configure(2*TraceMemory::chunk_entries*sizeof(ESS::trace_entry), fn);
+	for (size_t i = 0; i < num; ++i)
+		trace.push_back(make_entry(i));
+	EXPECT_EQ(num, trace.size());
+	EXPECT_EQ(4*TraceMemory::chunk_entries, trace.spilled());
+
+	// drain across the end of the spill file
+	ESS::trace_container_t out;
+	const size_t first = 4*TraceMemory::chunk_entries + 5;
+	EXPECT_EQ(first, trace.drain(out, first));
+	EXPECT_EQ(num - first, trace.all().size());
+	EXPECT_EQ(num - first, trace.drain(out));
+	EXPECT_EQ(0u, trace.size());
+
+	ASSERT_EQ(num, out.size());
+	for (size_t i = 0; i < num; ++i) {
+		ESS::trace_entry const expected = make_entry(i);
+		ASSERT_EQ(expected.fpga_time, out[i].fpga_time);
+		ASSERT_EQ(expected.event.getLabel(), out[i].event.getLabel());
+		ASSERT_EQ(expected.event.getTime(), out[i].event.getTime());
+	}
+
+	// recording continues after draining
+	trace.push_back(make_entry(num));
+	out.clear();
+	EXPECT_EQ(1u, trace.drain(out));
+	EXPECT_EQ(make_entry(num).fpga_time, out.at(0).fpga_time);
+
+	trace.clear();
+	EXPECT_EQ(0u, trace.size());
+	EXPECT_EQ(nullptr, fopen(fn.c_str(), "rb"));
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+#include "systemsim/VoltageTrace.h"
+
+namespace {
+
+// records V = 0.1 V * index, i.e. 0, 0.1, 0.2 ...
+void write_trace(std::string const& fn, ESS::voltage_trace_config const& cfg, size_t num, double interval)
+{
+	ESS::VoltageTraceWriter writer;
+	writer.open(fn, interval, cfg);
+	for (size_t i = 0; i < num; ++i)
+		writer.sample(i*interval, 0.1*i, 0., 0., 0.);
+	writer.close();
+}
+
+} // anonymous namespace
+
+TEST(VoltageTrace, TextRoundTrip)
+{
+	const std::string fn = "test_voltage_trace.txt";
+	ESS::voltage_trace_config cfg;
+	write_trace(fn, cfg, 10, 1.e-8);
+
+	std::vector<double> V = ESS::read_voltage_trace(fn, 100);
+	ASSERT_EQ(10u, V.size());
+	for (size_t i = 0; i < V.size(); ++i)
+		ASSERT_NEAR(0.1*i, V[i], 1.e-6);
+
+	// max_samples limits the number of samples
+	ASSERT_EQ(4u, ESS::read_voltage_trace(fn, 4).size());
+	std::remove(fn.c_str());
+}
+
+TEST(VoltageTrace, BinaryRoundTrip)
+{
+	const std::string fn = "test_voltage_trace.bin";
+	ESS::voltage_trace_config cfg;
+	cfg.binary = true;
+	write_trace(fn, cfg, 10, 1.e-8);
+
+	std::vector<double> V = ESS::read_voltage_trace(fn, 100);
+	ASSERT_EQ(10u, V.size());
+	for (size_t i = 0; i < V.size(); ++i)
+		ASSERT_NEAR(0.1*i, V[i], 1.e-6);
+	std::remove(fn.c_str());
+}
+
+TEST(VoltageTrace, BinaryDecimation)
+{
+	const std::string fn = "test_voltage_trace_decimated.bin";
+	ESS::voltage_trace_config cfg;
+	cfg.binary = true;
+	cfg.decimation = 3;
+	write_trace(fn, cfg, 10, 1.e-8);
+
+	// samples 0, 3, 6, 9 are written, the rest is held
+	std::vector<double> V = ESS::read_voltage_trace(fn, 100);
+	ASSERT_EQ(10u, V.size());
+	for (size_t i = 0; i < V.size(); ++i)
+		ASSERT_NEAR(0.1*(i - i%3), V[i], 1.e-6);
+	std::remove(fn.c_str());
+}
+
+TEST(VoltageTrace, BinaryTolerance)
+{
+	const std::string fn = "test_voltage_trace_tolerance.bin";
+	ESS::voltage_trace_config cfg;
+	cfg.binary = true;
+	cfg.tolerance = 0.25;
+	write_trace(fn, cfg, 10, 1.e-8);
+
+	// samples 0, 3, 6 and the last one (9) are written
+	std::vector<double> V = ESS::read_voltage_trace(fn, 100);
+	ASSERT_EQ(10u, V.size());
+	for (size_t i = 0; i < V.size(); ++i)
+		ASSERT_NEAR(0.1*(i - i%3), V[i], 1.e-6);
+	std::remove(fn.c_str());
+}
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "async_writer.h"
+
+TEST(async_writer, WritesInOrder)
+{
+	const std::string fn = "test_async_writer.txt";
+	const std::string long_line(1000, 'x');
+	std::ostringstream expected;
+
+	ess::async_file f;
+	ASSERT_TRUE(f.open(fn, "w"));
+	for (size_t i = 0; i < 10000; ++i) {
+		f.printf("%zu\n", i);
+		expected << i << "\n";
+	}
+	// longer than the initial formatting buffer
+	f.printf("%s\n", long_line.c_str());
+	expected << long_line << "\n";
+	f.write("end", 3);
+	expected << "end";
+	f.close();
+	ASSERT_FALSE(f.is_open());
+
+	std::ifstream in(fn.c_str());
+	std::ostringstream content;
+	content << in.rdbuf();
+	ASSERT_EQ(expected.str(), content.str());
+	ASSERT_GE(ess::async_writer::instance().get_statistics().bytes_written, content.str().size());
+	std::remove(fn.c_str());
+}
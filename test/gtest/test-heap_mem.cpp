@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "heap_mem.h"
+
+TEST(heap_mem, ReleasesInTimeStampOrder)
+{
+	std::mt19937 rng(1234);
+	ess::heap_mem<unsigned int> heap(64);
+	std::vector<unsigned int> inserted;
+
+	// time stamps around the wrap of the 20 bit counter, with random upper (address) bits
+	for (size_t i = 0; i < 64; ++i) {
+		unsigned int value = ((0xfffff - 100 + rng() % 200) & 0xfffff) | ((rng() % 64) << 20);
+		ASSERT_TRUE(heap.insert(value));
+		inserted.push_back(value);
+	}
+	EXPECT_FALSE(heap.insert(0));
+	EXPECT_EQ(64u, heap.num_available());
+
+	std::vector<unsigned int> released;
+	while (!heap.empty()) {
+		unsigned int next, value;
+		heap.view_next(next);
+		heap.get(value);
+		EXPECT_EQ(next, value);
+		released.push_back(value);
+	}
+	ASSERT_EQ(inserted.size(), released.size());
+	EXPECT_TRUE(std::is_permutation(inserted.begin(), inserted.end(), released.begin()));
+	for (size_t i = 1; i < released.size(); ++i)
+		EXPECT_FALSE(ess::heap_mem<unsigned int>::before(released[i], released[i-1]));
+}
+
+TEST(heap_mem, AssignBuildsHeap)
+{
+	std::vector<unsigned int> values;
+	for (unsigned int i = 0; i < 37; ++i)
+		values.push_back((i*7919) % 1000);
+
+	ess::heap_mem<unsigned int> heap(37);
+	ASSERT_TRUE(heap.assign(values.begin(), values.end()));
+	values.push_back(1);
+	EXPECT_FALSE(heap.assign(values.begin(), values.end()));
+	EXPECT_TRUE(heap.empty());
+
+	values.pop_back();
+	ASSERT_TRUE(heap.assign(values.begin(), values.end()));
+	std::sort(values.begin(), values.end());
+	for (auto expected : values) {
+		unsigned int value;
+		heap.get(value);
+		EXPECT_EQ(expected, value);
+	}
+}
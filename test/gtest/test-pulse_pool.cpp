@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "pulse_pool.h"
+#include "sized_queue.h"
+
+TEST(pulse_pool, SteadyStateUsesNoNewSlabs)
+{
+	ess::pulse_pool pool;
+	ess::sized_queue<uint32_t> queue(512);
+	queue.set_pool(&pool);
+
+	// a stream of pulses through a partly filled queue,
+	// the statistics are taken once the queue has reached its working size
+	ess::pulse_pool::statistics warm = ess::pulse_pool::statistics();
+	for (uint32_t i = 0; i < 300; ++i)
+		ASSERT_TRUE(queue.insert(i));
+	for (uint32_t i = 0; i < 100000; ++i) {
+		if (i == 10000)
+			warm = pool.get_statistics();
+		uint32_t value;
+		queue.get(value);
+		ASSERT_EQ(i, value);
+		ASSERT_TRUE(queue.insert(i + 300));
+	}
+	const ess::pulse_pool::statistics s = pool.get_statistics();
+	EXPECT_EQ(warm.slabs, s.slabs);
+	EXPECT_EQ(1u, s.slabs);
+	EXPECT_EQ(0u, s.heap_allocations);
+	EXPECT_GT(s.allocations, warm.allocations);
+	EXPECT_EQ(warm.peak_bytes, s.peak_bytes);
+}
+
+TEST(pulse_pool, RecyclesBlocks)
+{
+	ess::pulse_pool pool;
+	{
+		std::set<int, std::less<int>, ess::pool_allocator<int> > nodes((ess::pool_allocator<int>(&pool)));
+		for (int i = 0; i < 1000; ++i)
+			nodes.insert(i);
+		for (int i = 0; i < 1000; i += 2)
+			nodes.erase(i);
+		for (int i = 0; i < 1000; i += 2)
+			nodes.insert(i);
+		EXPECT_EQ(1000u, nodes.size());
+	}
+	const ess::pulse_pool::statistics s = pool.get_statistics();
+	EXPECT_EQ(1500u, s.allocations);
+	EXPECT_EQ(s.allocations, s.deallocations);
+	EXPECT_EQ(0u, s.bytes_in_use);
+
+	void* large = pool.allocate(4096);
+	pool.deallocate(large, 4096);
+	EXPECT_EQ(1u, pool.get_statistics().heap_allocations);
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include "systemc.h"
+
+TEST(sc_int, UnsignedWrapsToLength)
+{
+	sc_dt::sc_uint<15> t = 0x7ffe;
+	t += 3;
+	EXPECT_EQ(1u, t.to_uint());
+	t -= 2;
+	EXPECT_EQ(0x7fffu, t.to_uint());
+	t = 0x12345;
+	EXPECT_EQ(0x2345u, t.to_uint());
+	EXPECT_EQ(0x2345u, (t++).to_uint());
+	EXPECT_EQ(0x2346u, t.to_uint());
+	t <<= 2;
+	EXPECT_EQ(0x0d18u, t.to_uint());
+
+	sc_dt::sc_uint<64> w = ~uint64_t(0);
+	++w;
+	EXPECT_EQ(0u, w.to_uint64());
+}
+
+TEST(sc_int, SignedExtendsFromLength)
+{
+	sc_dt::sc_int<9> t = 255;
+	++t;
+	EXPECT_EQ(-256, t.to_int());
+	t -= 1;
+	EXPECT_EQ(255, t.to_int());
+	t = 0x1ff;
+	EXPECT_EQ(-1, t.to_int());
+	t *= 300;
+	EXPECT_EQ(212, t.to_int());
+}
+
+TEST(sc_int, RangeAssignment)
+{
+	sc_dt::sc_uint<15> t = 0x7fff;
+	t.range(10, 5) = 0;
+	EXPECT_EQ(0x781fu, t.to_uint());
+	t.range(14, 9) = 0xff;
+	EXPECT_EQ(0x7e1fu, t.to_uint());
+	EXPECT_EQ(0x3fu, t.range(14, 9).to_uint());
+	t(14, 0) = 5;
+	EXPECT_EQ(5u, t.to_uint());
+
+	sc_dt::sc_int<12> s = 0;
+	s.range(11, 6) = 0x20;
+	EXPECT_EQ(-2048, s.to_int());
+	s.range(5, 0) = -1;
+	EXPECT_EQ(-2048 + 63, s.to_int());
+}
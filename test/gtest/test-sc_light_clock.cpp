@@ -0,0 +1,111 @@
+#include "systemc_test.h"
+
+#include <utility>
+#include <vector>
+
+typedef std::vector<std::pair<sc_time, sc_dt::uint64> > edge_log;
+
+/// records time and delta cycle of the edges of a sc_clock and a sc_light_clock with equal parameters
+class ClockCompare : public sc_module
+{
+public:
+	SC_HAS_PROCESS(ClockCompare);
+
+	ClockCompare(sc_module_name name, sc_time const& period, double duty, sc_time const& start, bool posedge_first) :
+		sc_module(name),
+		clk("clk", period, duty, start, posedge_first),
+		light("light", period, duty, start, posedge_first)
+	{
+		SC_METHOD(clk_pos);
+		dont_initialize();
+		sensitive << clk.posedge_event();
+		SC_METHOD(clk_neg);
+		dont_initialize();
+		sensitive << clk.negedge_event();
+		SC_METHOD(clk_any);
+		dont_initialize();
+		sensitive << clk;
+		SC_METHOD(light_pos);
+		dont_initialize();
+		sensitive << light.posedge_event();
+		SC_METHOD(light_neg);
+		dont_initialize();
+		sensitive << light.negedge_event();
+		SC_METHOD(light_any);
+		dont_initialize();
+		sensitive << light;
+	}
+
+	void clk_pos() { log(pos[0]); }
+	void clk_neg() { log(neg[0]); }
+	void clk_any() { log(any[0]); }
+	void light_pos() { log(pos[1]); }
+	void light_neg() { log(neg[1]); }
+	void light_any() { log(any[1]); }
+
+	sc_clock clk;
+	sc_light_clock light;
+	edge_log pos[2], neg[2], any[2];
+
+private:
+	void log(edge_log& l) { l.push_back(std::make_pair(sc_time_stamp(), sc_delta_count())); }
+};
+
+class SCLightClock : public SystemCTest {};
+
+TEST_F(SCLightClock, EdgesAsSCClock)
+{
+	ClockCompare c("c", sc_time(10, SC_NS), 0.3, SC_ZERO_TIME, true);
+	sc_start(100, SC_NS);
+
+	EXPECT_EQ(10u, c.pos[0].size());
+	EXPECT_EQ(10u, c.neg[0].size());
+	EXPECT_EQ(c.pos[0], c.pos[1]);
+	EXPECT_EQ(c.neg[0], c.neg[1]);
+	EXPECT_EQ(c.any[0], c.any[1]);
+	EXPECT_EQ(sc_time(3, SC_NS), c.neg[1].front().first);
+}
+
+TEST_F(SCLightClock, NegedgeFirst)
+{
+	ClockCompare c("c", sc_time(8, SC_NS), 0.5, sc_time(5, SC_NS), false);
+	sc_start(50, SC_NS);
+
+	EXPECT_EQ(c.pos[0], c.pos[1]);
+	EXPECT_EQ(c.neg[0], c.neg[1]);
+	EXPECT_EQ(c.any[0], c.any[1]);
+	ASSERT_FALSE(c.neg[1].empty());
+	EXPECT_EQ(sc_time(5, SC_NS), c.neg[1].front().first);
+	EXPECT_EQ(sc_time(9, SC_NS), c.pos[1].front().first);
+}
+
+/// only the positive edges are requested, the negative ones are skipped
+class PosedgeOnly : public sc_module
+{
+public:
+	SC_HAS_PROCESS(PosedgeOnly);
+
+	PosedgeOnly(sc_module_name name) :
+		sc_module(name),
+		light("light", 10, SC_NS)
+	{
+		SC_METHOD(tick);
+		dont_initialize();
+		sensitive << light.posedge_event();
+	}
+
+	void tick() { times.push_back(sc_time_stamp()); }
+
+	sc_light_clock light;
+	std::vector<sc_time> times;
+};
+
+TEST_F(SCLightClock, PosedgeOnly)
+{
+	PosedgeOnly p("p");
+	sc_start(95, SC_NS);
+
+	ASSERT_EQ(10u, p.times.size());
+	for (size_t i = 0; i < p.times.size(); ++i)
+		EXPECT_EQ(sc_time(10.*i, SC_NS), p.times[i]);
+}
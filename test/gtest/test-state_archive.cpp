@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "state_archive.h"
+
+TEST(state_archive, RoundTripWithShift)
+{
+	const std::string fn = "test_state_archive.bin";
+
+	unsigned int counter = 42;
+	sc_dt::sc_uint<15> timestamp = 12345;
+	short registers[2] = {3, 63};
+	std::deque<unsigned int> queue = {1, 2, 3};
+	std::vector<double> stp_times = {1.e-3, 2.e-3};
+	sc_time release = sc_time(1000, SC_NS);
+	{
+		ess::state_archive ar;
+		ar.section("module");
+		ar.value(counter);
+		ar.value(timestamp);
+		ar.value(registers);
+		ar.sequence(queue);
+		ar.sequence(stp_times, [&ar](double& t){ ar.seconds(t); });
+		ar.time(release);
+		ar.save(fn);
+	}
+
+	unsigned int counter2 = 0;
+	sc_dt::sc_uint<15> timestamp2 = 0;
+	short registers2[2] = {0, 0};
+	std::deque<unsigned int> queue2;
+	std::vector<double> stp_times2;
+	sc_time release2;
+
+	ess::state_archive ar(fn);
+	std::remove(fn.c_str());
+	ASSERT_TRUE(ar.loading());
+	ar.set_shift(sc_time(400, SC_NS));
+	ar.section("module");
+	ar.value(counter2);
+	ar.value(timestamp2);
+	ar.value(registers2);
+	ar.sequence(queue2);
+	ar.sequence(stp_times2, [&ar](double& t){ ar.seconds(t); });
+	ar.time(release2);
+	EXPECT_NO_THROW(ar.finish());
+
+	EXPECT_EQ(42u, counter2);
+	EXPECT_EQ(12345u, timestamp2.to_uint());
+	EXPECT_EQ(3, registers2[0]);
+	EXPECT_EQ(63, registers2[1]);
+	EXPECT_EQ(queue, queue2);
+	ASSERT_EQ(2u, stp_times2.size());
+	// model times are not moved
+	EXPECT_EQ(stp_times, stp_times2);
+	EXPECT_EQ(sc_time(600, SC_NS), release2);
+}
+
+TEST(state_archive, RejectsOtherSystem)
+{
+	const std::string fn = "test_state_archive.bin";
+	{
+		ess::state_archive ar;
+		ar.section("l2_dnc_i0");
+		ar.check_size(8);
+		ar.save(fn);
+	}
+	{
+		ess::state_archive ar(fn);
+		EXPECT_THROW(ar.section("l2_fpga_i0"), std::runtime_error);
+	}
+	{
+		ess::state_archive ar(fn);
+		ar.section("l2_dnc_i0");
+		EXPECT_THROW(ar.check_size(4), std::runtime_error);
+	}
+	std::remove(fn.c_str());
+
+	EXPECT_THROW(ess::state_archive("does_not_exist.bin"), std::runtime_error);
+}